@@ -2,12 +2,14 @@
 #include <iostream>
 
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_cavity_cache.hpp"
 #include "Omega_h_coarsen.hpp"
 #include "Omega_h_confined.hpp"
 #include "Omega_h_conserve.hpp"
 #include "Omega_h_histogram.hpp"
 #include "Omega_h_laplace.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_metric.hpp"
 #include "Omega_h_profile.hpp"
 #include "Omega_h_quality.hpp"
 #include "Omega_h_refine.hpp"
@@ -84,6 +86,10 @@ AdaptOpts::AdaptOpts(Int dim) {
   should_swap = true;
   should_coarsen_slivers = true;
   should_prevent_coarsen_flip = false;
+  should_balance = false;
+  max_imbalance = 1.10;
+  should_step_locally = false;
+  should_cache_cavities = true;
 }
 
 static Reals get_fixable_qualities(Mesh* mesh, AdaptOpts const&) {
@@ -168,6 +174,51 @@ static bool pre_adapt(Mesh* mesh, AdaptOpts const& opts) {
   return true;
 }
 
+/* max over the ranks of their total weight, relative to the average */
+static Real weight_imbalance(Mesh* mesh, Reals weights) {
+  auto const comm = mesh->comm();
+  auto const local = get_sum(weights);
+  auto const total = comm->allreduce(local, OMEGA_H_SUM);
+  if (total == 0.0) return 1.0;
+  auto const max = comm->allreduce(local, OMEGA_H_MAX);
+  return max / (total / comm->size());
+}
+
+static void balance_if_needed(
+    Mesh* mesh, AdaptOpts const& opts, Reals weights, char const* what) {
+  auto const imbalance = weight_imbalance(mesh, weights);
+  if (imbalance <= opts.max_imbalance) return;
+  if ((opts.verbosity >= EACH_REBUILD) && can_print(mesh)) {
+    std::cout << "balancing " << what << " element counts, imbalance was "
+              << imbalance << '\n';
+  }
+  BalanceOpts balance_opts;
+  balance_opts.method = OMEGA_H_BALANCE_GRAPH;
+  balance_opts.weights = weights;
+  balance_opts.imbalance = min2(balance_opts.imbalance, opts.max_imbalance);
+  mesh->balance(balance_opts);
+}
+
+/* ranks about to refine heavily would otherwise grow far past
+   the others before anything rebalances them. an element weighs
+   the larger of what it is now and what the metric predicts,
+   since the ones being coarsened are still there during refinement */
+static void balance_predicted(Mesh* mesh, AdaptOpts const& opts) {
+  OMEGA_H_TIME_FUNCTION;
+  if (!opts.should_balance || mesh->comm()->size() == 1) return;
+  mesh->set_parting(OMEGA_H_ELEM_BASED);
+  auto const predicted =
+      get_nelems_per_elem(mesh, mesh->get_array<Real>(VERT, "metric"));
+  auto const weights = max_each(predicted, Reals(mesh->nelems(), 1.0));
+  balance_if_needed(mesh, opts, weights, "predicted");
+}
+
+static void balance_actual(Mesh* mesh, AdaptOpts const& opts) {
+  OMEGA_H_TIME_FUNCTION;
+  if (!opts.should_balance || mesh->comm()->size() == 1) return;
+  balance_if_needed(mesh, opts, Reals(mesh->nelems(), 1.0), "actual");
+}
+
 static void post_rebuild(Mesh* mesh, AdaptOpts const& opts) {
   if (opts.verbosity >= EACH_REBUILD) print_adapt_status(mesh, opts);
 }
@@ -249,8 +300,8 @@ static void snap_and_satisfy_quality(Mesh* mesh, AdaptOpts const& opts) {
     satisfy_quality(mesh, opts);
 }
 
-static void post_adapt(
-    Mesh* mesh, AdaptOpts const& opts, Now t0, Now t1, Now t2, Now t3, Now t4) {
+static void post_adapt(Mesh* mesh, AdaptOpts const& opts,
+    PartingStats const& parting0, Now t0, Now t1, Now t2, Now t3, Now t4) {
   if (opts.verbosity == EACH_ADAPT) {
     if (!mesh->comm()->rank()) std::cout << "after adapting:\n";
     print_adapt_status(mesh, opts);
@@ -271,6 +322,18 @@ static void post_adapt(
     std::cout << "correcting integral errors took " << (t4 - t3)
               << " seconds\n";
   }
+  if (opts.verbosity > SILENT && mesh->comm()->size() > 1) {
+    auto const parting1 = mesh->parting_stats();
+    auto const comm = mesh->comm();
+    auto const migrated =
+        comm->allreduce(parting1.migrated - parting0.migrated, OMEGA_H_SUM);
+    auto const kept =
+        comm->allreduce(parting1.kept - parting0.kept, OMEGA_H_SUM);
+    if (!comm->rank()) {
+      std::cout << "changing partitioning migrated " << migrated
+                << " entities and kept " << kept << " in place\n";
+    }
+  }
   Now t5 = now();
   if (opts.verbosity > SILENT && !mesh->comm()->rank()) {
     std::cout << "adapting took " << (t5 - t0) << " seconds\n\n";
@@ -283,21 +346,27 @@ bool adapt(Mesh* mesh, AdaptOpts const& opts) {
   auto t0 = now();
 
   ScopedChangeRCFieldsToMesh change_to_mesh(*mesh);
+  auto const parting0 = mesh->parting_stats();
   if (!pre_adapt(mesh, opts)) return false;
+  balance_predicted(mesh, opts);
   setup_conservation_tags(mesh, opts);
+  if (opts.should_cache_cavities) add_cavity_caches(mesh);
   auto t1 = now();
   satisfy_lengths(mesh, opts);
   auto t2 = now();
   snap_and_satisfy_quality(mesh, opts);
+  remove_cavity_caches(mesh);
   auto t3 = now();
   correct_integral_errors(mesh, opts);
   auto t4 = now();
 
 
   mesh->set_parting(OMEGA_H_ELEM_BASED);
+  balance_actual(mesh, opts);
+  mesh->drop_ghost_cache();
 
 
-  post_adapt(mesh, opts, t0, t1, t2, t3, t4);
+  post_adapt(mesh, opts, parting0, t0, t1, t2, t3, t4);
 
 
   return true;
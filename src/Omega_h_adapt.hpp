@@ -73,6 +73,18 @@ struct AdaptOpts {
   bool should_swap;
   bool should_coarsen_slivers;
   bool should_prevent_coarsen_flip;
+  /* rebalance before refining, weighting elements by how many
+     the metric predicts they will become, and again afterwards,
+     whenever the ranks are more imbalanced than max_imbalance */
+  bool should_balance;
+  Real max_imbalance;
+  /* warp_to_limit() and approach_metric() shorten the step only at
+     the vertices of elements and edges that would be unacceptable,
+     measuring again only around them, instead of everywhere */
+  bool should_step_locally;
+  /* during adapt(), remember the qualities of collapse and 3D swap
+     candidates until a rebuild changes their cavities */
+  bool should_cache_cavities;
   TransferOpts xfer_opts;
 };
 
@@ -3,6 +3,7 @@
 #include "Omega_h_align.hpp"
 #include "Omega_h_amr.hpp"
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_atomics.hpp"
 #include "Omega_h_element.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_int_scan.hpp"
@@ -497,6 +498,112 @@ void find_matches(Topo_type const ent_type, LOs const av2v,
   find_matches_ex(deg, a2fv, av2v, bv2v, v2b, a2b_out, codes_out);
 }
 
+/* the hash-based matching engine:
+   each b entity is inserted into an open-addressing table
+   keyed by its sorted vertex tuple, then each a entity
+   looks up the b entity with the same sorted tuple and the
+   usual IsMatch logic derives the alignment code. */
+
+template <Int deg>
+OMEGA_H_DEVICE Few<LO, deg> gather_sorted_verts(LOs const& ev2v, LO e) {
+  auto v = gather_verts<deg>(ev2v, e);
+  for (Int i = 1; i < deg; ++i) {
+    for (Int j = i; j > 0 && v[j] < v[j - 1]; --j) swap2(v[j], v[j - 1]);
+  }
+  return v;
+}
+
+template <Int deg>
+OMEGA_H_DEVICE std::uint32_t hash_sorted_verts(Few<LO, deg> const& v) {
+  std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+  for (Int i = 0; i < deg; ++i) {
+    h ^= std::uint64_t(std::uint32_t(v[i])) + 0x9e3779b97f4a7c15ULL +
+         (h << 6) + (h >> 2);
+  }
+  /* the murmur3 finalizer spreads consecutive indices over the table */
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return std::uint32_t(h);
+}
+
+template <Int deg>
+static void find_matches_by_hash_deg(LOs const av2v, LOs const bv2v,
+    Write<LO>* a2b_out, Write<I8>* codes_out) {
+  OMEGA_H_TIME_FUNCTION;
+  LO const na = divide_no_remainder(av2v.size(), deg);
+  LO const nb = divide_no_remainder(bv2v.size(), deg);
+  /* keep the load factor at or below one half */
+  LO capacity = 1;
+  while (capacity < 2 * nb) capacity *= 2;
+  auto const mask = std::uint32_t(capacity - 1);
+  Write<LO> table(capacity, -1, "hash matching table");
+  auto insert = OMEGA_H_LAMBDA(LO b) {
+    auto const v = gather_sorted_verts<deg>(bv2v, b);
+    auto slot = hash_sorted_verts<deg>(v) & mask;
+    while (atomic_compare_exchange(&table[LO(slot)], -1, b) != -1) {
+      slot = (slot + 1) & mask;
+    }
+  };
+  parallel_for(nb, std::move(insert), "hash matching insert");
+  Write<LO> a2b(na);
+  Write<I8> codes(na);
+  auto lookup = OMEGA_H_LAMBDA(LO a) {
+    auto const av = gather_sorted_verts<deg>(av2v, a);
+    auto slot = hash_sorted_verts<deg>(av) & mask;
+    auto const a_begin = a * deg;
+    while (true) {
+      auto const b = table[LO(slot)];
+      OMEGA_H_CHECK(b != -1);  // there can't be less than one!
+      auto const bv = gather_sorted_verts<deg>(bv2v, b);
+      bool same = true;
+      for (Int i = 0; i < deg; ++i) same = same && (av[i] == bv[i]);
+      if (same) {
+        auto const b_begin = b * deg;
+        Int which_down = 0;
+        while (bv2v[b_begin + which_down] != av2v[a_begin]) ++which_down;
+        I8 match_code;
+        auto const is_match = IsMatch<deg>::eval(
+            av2v, a_begin, bv2v, b_begin, which_down, &match_code);
+        OMEGA_H_CHECK(is_match);
+        a2b[a] = b;
+        codes[a] = match_code;
+        return;
+      }
+      slot = (slot + 1) & mask;
+    }
+  };
+  parallel_for(na, std::move(lookup), "hash matching lookup");
+  *a2b_out = a2b;
+  *codes_out = codes;
+}
+
+void find_matches_by_hash(Int const deg, LOs const av2v, LOs const bv2v,
+    Write<LO>* a2b_out, Write<I8>* codes_out) {
+  if (deg == 2) {
+    find_matches_by_hash_deg<2>(av2v, bv2v, a2b_out, codes_out);
+  } else if (deg == 3) {
+    find_matches_by_hash_deg<3>(av2v, bv2v, a2b_out, codes_out);
+  } else if (deg == 4) {
+    find_matches_by_hash_deg<4>(av2v, bv2v, a2b_out, codes_out);
+  } else {
+    Omega_h_fail(
+        "find_matches_by_hash called with unsupported degree %d\n", deg);
+  }
+}
+
+Adj reflect_down_by_hash(LOs const hv2v, LOs const lv2v,
+    Omega_h_Family const family, Int const high_dim, Int const low_dim) {
+  ScopedTimer timer("reflect_down(hash)");
+  OMEGA_H_CHECK(low_dim >= EDGE);
+  LOs const uv2v = form_uses(hv2v, family, high_dim, low_dim);
+  auto const deg = element_degree(family, low_dim, VERT);
+  Write<LO> hl2l;
+  Write<I8> codes;
+  find_matches_by_hash(deg, uv2v, lv2v, &hl2l, &codes);
+  return Adj(read(hl2l), read(codes));
+}
+
 Adj reflect_down(LOs const hv2v, LOs const lv2v, Adj const v2l,
     Omega_h_Family const family, Int const high_dim, Int const low_dim) {
   ScopedTimer timer("reflect_down(v2l)");
@@ -46,6 +46,17 @@ Adj reflect_down(LOs const hv2v, LOs const lv2v, Adj const v2l,
 Adj reflect_down(LOs const hv2v, LOs const lv2v, Adj const v2l,
     Topo_type const high_type, Topo_type const low_type);
 
+/* Same results as find_matches() and reflect_down(), but the
+   low entities are found through a concurrent hash table of
+   their sorted vertex tuples, so no vertex-to-low upward
+   adjacency (and hence no sorting) is needed.
+   Selected in Mesh through Mesh::set_matching(OMEGA_H_MATCH_BY_HASH). */
+void find_matches_by_hash(Int const deg, LOs const av2v, LOs const bv2v,
+    Write<LO>* a2b_out, Write<I8>* codes_out);
+
+Adj reflect_down_by_hash(LOs const hv2v, LOs const lv2v,
+    Omega_h_Family const family, Int const high_dim, Int const low_dim);
+
 Adj unmap_adjacency(LOs const a2b, Adj const b2c);
 
 /* Given a downward adjacency, derive its corresponding upward adjacency.
@@ -57,6 +68,11 @@ Adj invert_adj(Adj const down, Int const nlows_per_high, LO const nlows,
 Adj invert_adj(Adj const down, Int const nlows_per_high, LO const nlows,
     Topo_type high_type, Topo_type low_type);
 
+/* sorts each list of upward adjacent entities by their index,
+   carrying the codes along */
+void sort_by_high_index(
+    LOs const l2lh, Write<LO> const lh2h, Write<I8> const codes);
+
 Children invert_parents(Parents const children2parents, Int const parent_dim,
     Int const nparent_dim_ents);
 
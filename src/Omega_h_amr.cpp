@@ -147,6 +147,7 @@ static void refine_elem_based(Mesh* mesh, TransferOpts xfer_opts) {
         /*mods_can_be_shared*/ true, &(prods2new_ents[prod_dim]),
         &(same_ents2old_ents[prod_dim]), &(same_ents2new_ents[prod_dim]),
         &(old_ents2new_ents[prod_dim]));
+    patch_up_adjs(mesh, &new_mesh, prod_dim, old_ents2new_ents);
     if (prod_dim == VERT) {
       mods2midverts[VERT] =
           unmap(mods2mds[VERT], old_ents2new_ents[prod_dim], 1);
@@ -1,9 +1,14 @@
 #include "Omega_h_adapt.hpp"
 
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_metric.hpp"
+#include "Omega_h_quality.hpp"
 #include "Omega_h_shape.hpp"
 
+#include <cmath>
 #include <iostream>
 
 namespace Omega_h {
@@ -33,6 +38,104 @@ static bool okay(Mesh* mesh, AdaptOpts const& opts) {
   return true;
 }
 
+/* halves the step factors of the vertices of unacceptable elements
+   and edges until there are none, letting apply() move just those
+   vertices and measuring again only the elements and edges around
+   them. returns false if a factor would drop below min_factor. */
+template <typename Apply>
+static bool step_locally(Mesh* mesh, AdaptOpts const& opts, Real min_factor,
+    Write<Real> factors, Apply const& apply, Int* nsteps, GO* nmeasured) {
+  auto const comm = mesh->comm();
+  auto const dim = mesh->dim();
+  Write<Real> quals = deep_copy(mesh->ask_qualities());
+  Write<Real> lens = deep_copy(mesh->ask_lengths());
+  while (true) {
+    auto const bad_elems = each_lt(read(quals), opts.min_quality_allowed);
+    auto const bad_edges = each_gt(read(lens), opts.max_length_allowed);
+    auto const marks = lor_each(mark_down(mesh, dim, VERT, bad_elems),
+        mark_down(mesh, EDGE, VERT, bad_edges));
+    if (!get_max(comm, marks)) break;
+    auto const verts = collect_marked(marks);
+    auto f = OMEGA_H_LAMBDA(LO i) { factors[verts[i]] /= 2.0; };
+    parallel_for(verts.size(), f, "step_locally");
+    auto const smallest =
+        verts.size() ? get_min(read(unmap(verts, read(factors), 1))) : 1.0;
+    if (comm->reduce_or(smallest < min_factor)) return false;
+    apply(verts);
+    ++*nsteps;
+    auto const elems = collect_marked(mark_up(mesh, VERT, dim, marks));
+    auto const edges = collect_marked(mark_up(mesh, VERT, EDGE, marks));
+    map_into(measure_qualities(mesh, elems), elems, quals, 1);
+    map_into(measure_edges_metric(mesh, edges), edges, lens, 1);
+    *nmeasured += elems.size();
+  }
+  /* what was measured is what ask_qualities() and ask_lengths()
+     would measure again */
+  mesh->add_tag(dim, "quality", 1, read(quals));
+  mesh->add_tag(EDGE, "length", 1, read(lens));
+  return true;
+}
+
+static void print_local_steps(Mesh* mesh, char const* what, Reals factors,
+    Int nsteps, GO nmeasured) {
+  auto const comm = mesh->comm();
+  auto const min_factor = get_min(comm, factors);
+  auto const max_factor = get_max(comm, factors);
+  nmeasured = comm->allreduce(nmeasured, OMEGA_H_SUM);
+  if (can_print(mesh)) {
+    std::cout << what << " moved by factors in [" << min_factor << ", "
+              << max_factor << "] in " << nsteps << " steps, measuring "
+              << nmeasured << " elements again\n";
+  }
+}
+
+static void warp_locally(Mesh* mesh, AdaptOpts const& opts,
+    bool exit_on_stall, Int max_niters, Reals coords, Reals warp) {
+  auto const dim = mesh->dim();
+  Write<Real> factors(mesh->nverts(), 1.0);
+  auto apply = [&](LOs verts) {
+    Write<Real> moved = deep_copy(mesh->coords());
+    auto f = OMEGA_H_LAMBDA(LO i) {
+      auto const v = verts[i];
+      for (Int j = 0; j < dim; ++j) {
+        auto const k = v * dim + j;
+        moved[k] = coords[k] + factors[v] * warp[k];
+      }
+    };
+    parallel_for(verts.size(), f, "warp_locally");
+    mesh->set_coords(moved);
+  };
+  Int nsteps = 0;
+  GO nmeasured = 0;
+  if (!step_locally(mesh, opts, std::ldexp(1.0, -max_niters), factors, apply,
+          &nsteps, &nmeasured)) {
+    if (exit_on_stall) {
+      if (can_print(mesh)) {
+        std::cout << "warp_to_limit stalled, dropping warp field and "
+                     "continuing anyway\n";
+      }
+      mesh->remove_tag(VERT, "warp");
+      return;
+    }
+    Omega_h_fail(
+        "warp step %d : Omega_h is probably unable to satisfy"
+        " this warp under this size field\n"
+        "min quality %.2e max length %.2e\n",
+        nsteps + 1, min_fixable_quality(mesh, opts), mesh->max_length());
+  }
+  if (opts.verbosity >= EACH_REBUILD) {
+    print_local_steps(mesh, "warp_to_limit", factors, nsteps, nmeasured);
+  }
+  Write<Real> remainder(warp.size());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    for (Int j = 0; j < dim; ++j) {
+      remainder[v * dim + j] = (1.0 - factors[v]) * warp[v * dim + j];
+    }
+  };
+  parallel_for(mesh->nverts(), f, "warp_locally");
+  mesh->set_tag(VERT, "warp", Reals(remainder));
+}
+
 bool warp_to_limit(
     Mesh* mesh, AdaptOpts const& opts, bool exit_on_stall, Int max_niters) {
   if (!mesh->has_tag(VERT, "warp")) return false;
@@ -47,6 +150,10 @@ bool warp_to_limit(
     mesh->remove_tag(VERT, "warp");
     return true;
   }
+  if (opts.should_step_locally) {
+    warp_locally(mesh, opts, exit_on_stall, max_niters, coords, warp);
+    return true;
+  }
   auto remainder = Reals(warp.size(), 0.0);
   Int i = 0;
   Real factor = 1.0;
@@ -80,6 +187,52 @@ bool warp_to_limit(
   return true;
 }
 
+static void fail_approach(
+    Mesh* mesh, AdaptOpts const& opts, Real factor, Real min_step) {
+  auto minq = min_fixable_quality(mesh, opts);
+  auto maxl = mesh->max_length();
+  if (can_print(mesh)) {
+    if (minq < opts.min_quality_allowed) {
+      std::cerr << "Metric approach has stalled with minimum quality "
+                << minq << " < " << opts.min_quality_allowed << "\n";
+      std::cerr << "Decreasing \"Min Quality Allowed\" may help, but "
+                   "otherwise the metric is likely not satisfiable\n";
+    }
+    if (maxl > opts.max_length_allowed) {
+      std::cerr << "Metric approach has stalled with maximum length "
+                << maxl << " > " << opts.max_length_allowed << "\n";
+      std::cerr << "Increasing \"Max Length Allowed\" will probably fix "
+                   "this, otherwise the metric is likely not satisfiable\n";
+    }
+  }
+  Omega_h_fail("Metric approach has stalled at step size = %f < %f.\n",
+      factor, min_step);
+}
+
+static void approach_locally(Mesh* mesh, AdaptOpts const& opts,
+    Real min_step, Reals orig, Reals target) {
+  auto const nverts = mesh->nverts();
+  auto const ncomps = divide_no_remainder(orig.size(), nverts);
+  Write<Real> factors(nverts, 1.0);
+  auto apply = [&](LOs verts) {
+    auto const some = interpolate_between_metrics(verts.size(),
+        unmap(verts, orig, ncomps), unmap(verts, target, ncomps),
+        unmap(verts, read(factors), 1));
+    Write<Real> metrics = deep_copy(mesh->get_array<Real>(VERT, "metric"));
+    map_into(some, verts, metrics, ncomps);
+    mesh->set_tag(VERT, "metric", Reals(metrics));
+  };
+  Int nsteps = 0;
+  GO nmeasured = 0;
+  if (!step_locally(
+          mesh, opts, min_step, factors, apply, &nsteps, &nmeasured)) {
+    fail_approach(mesh, opts, get_min(mesh->comm(), read(factors)), min_step);
+  }
+  if (opts.verbosity >= EACH_REBUILD) {
+    print_local_steps(mesh, "approach_metric", factors, nsteps, nmeasured);
+  }
+}
+
 bool approach_metric(Mesh* mesh, AdaptOpts const& opts, Real min_step) {
   auto name = "metric";
   auto target_name = "target_metric";
@@ -92,29 +245,14 @@ bool approach_metric(Mesh* mesh, AdaptOpts const& opts, Real min_step) {
     mesh->remove_tag(VERT, target_name);
     return true;
   }
+  if (opts.should_step_locally) {
+    approach_locally(mesh, opts, min_step, orig, target);
+    return true;
+  }
   Real factor = 1.0;
   do {
     factor /= 2.0;
-    if (factor < min_step) {
-      auto minq = min_fixable_quality(mesh, opts);
-      auto maxl = mesh->max_length();
-      if (can_print(mesh)) {
-        if (minq < opts.min_quality_allowed) {
-          std::cerr << "Metric approach has stalled with minimum quality "
-                    << minq << " < " << opts.min_quality_allowed << "\n";
-          std::cerr << "Decreasing \"Min Quality Allowed\" may help, but "
-                       "otherwise the metric is likely not satisfiable\n";
-        }
-        if (maxl > opts.max_length_allowed) {
-          std::cerr << "Metric approach has stalled with maximum length "
-                    << maxl << " > " << opts.max_length_allowed << "\n";
-          std::cerr << "Increasing \"Max Length Allowed\" will probably fix "
-                       "this, otherwise the metric is likely not satisfiable\n";
-        }
-      }
-      Omega_h_fail("Metric approach has stalled at step size = %f < %f.\n",
-          factor, min_step);
-    }
+    if (factor < min_step) fail_approach(mesh, opts, factor, min_step);
     auto current =
         interpolate_between_metrics(mesh->nverts(), orig, target, factor);
     mesh->set_tag(VERT, name, current);
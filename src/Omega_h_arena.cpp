@@ -0,0 +1,193 @@
+#include <Omega_h_arena.hpp>
+#include <Omega_h_fail.hpp>
+#include <Omega_h_profile.hpp>
+
+namespace Omega_h {
+
+int arena_size_class(std::size_t size) {
+  if (size <= (std::size_t(1) << ARENA_MIN_SHIFT)) return 0;
+  auto const n = size - 1;
+  int shift = 0;
+  while ((n >> shift) > 1) ++shift;
+  auto const top = int(n >> (shift - ARENA_SUB_BITS));
+  return ((shift - ARENA_MIN_SHIFT) << ARENA_SUB_BITS) +
+         (top - (1 << ARENA_SUB_BITS)) + 1;
+}
+
+std::size_t arena_class_size(int size_class) {
+  if (size_class == 0) return std::size_t(1) << ARENA_MIN_SHIFT;
+  auto const shift = ARENA_MIN_SHIFT + ((size_class - 1) >> ARENA_SUB_BITS);
+  auto const top =
+      std::size_t((1 << ARENA_SUB_BITS) + ((size_class - 1) & ((1 << ARENA_SUB_BITS) - 1)));
+  return (top + 1) << (shift - ARENA_SUB_BITS);
+}
+
+namespace {
+
+/* past this many blocks per class, a thread hands blocks
+   to the shared lists so other threads can reuse them */
+constexpr std::size_t thread_cache_max_blocks = 8;
+
+std::atomic<std::uint64_t> next_arena_id(1);
+
+struct ThreadCache {
+  std::uint64_t arena_id = 0;
+  std::uint64_t epoch = 0;
+  std::size_t bytes = 0;
+  FreeFunc underlying_free;
+  BlockList blocks[ARENA_NCLASSES];
+  std::size_t flush() {
+    auto const flushed = bytes;
+    for (int c = 0; c < ARENA_NCLASSES; ++c) {
+      for (auto block : blocks[c]) underlying_free(block, arena_class_size(c));
+      blocks[c].clear();
+    }
+    bytes = 0;
+    return flushed;
+  }
+  ~ThreadCache() { flush(); }
+};
+
+thread_local ThreadCache thread_cache;
+
+ThreadCache& bind_thread_cache(Arena& arena) {
+  auto& cache = thread_cache;
+  auto const epoch = arena.epoch.load();
+  if (cache.arena_id != arena.id || cache.epoch != epoch) {
+    auto const flushed = cache.flush();
+    if (cache.arena_id == arena.id) {
+      arena.cached_bytes -= flushed;
+      arena.released_bytes += flushed;
+    }
+    cache.arena_id = arena.id;
+    cache.epoch = epoch;
+    cache.underlying_free = arena.underlying_free;
+  }
+  return cache;
+}
+
+}  // end anonymous namespace
+
+Arena::Arena(MallocFunc malloc_in, FreeFunc free_in)
+    : id(next_arena_id++),
+      epoch(0),
+      phase_depth(0),
+      underlying_malloc(malloc_in),
+      underlying_free(free_in),
+      cached_bytes(0),
+      allocations(0),
+      reused_allocations(0),
+      reused_bytes(0),
+      underlying_allocations(0),
+      released_bytes(0) {}
+
+Arena::~Arena() { release_cached(*this); }
+
+void* allocate(Arena& arena, std::size_t size) {
+  ScopedTimer timer("arena allocate");
+  auto const size_class = arena_size_class(size);
+  auto const class_size = arena_class_size(size_class);
+  ++arena.allocations;
+  void* data = nullptr;
+  auto& cache = bind_thread_cache(arena);
+  if (!cache.blocks[size_class].empty()) {
+    data = cache.blocks[size_class].back();
+    cache.blocks[size_class].pop_back();
+    cache.bytes -= class_size;
+  } else {
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    if (!arena.free_blocks[size_class].empty()) {
+      data = arena.free_blocks[size_class].back();
+      arena.free_blocks[size_class].pop_back();
+    }
+  }
+  if (data != nullptr) {
+    arena.cached_bytes -= class_size;
+    ++arena.reused_allocations;
+    arena.reused_bytes += class_size;
+    return data;
+  }
+  ++arena.underlying_allocations;
+  data = arena.underlying_malloc(class_size);
+  if (data == nullptr) {
+    release_cached(arena);
+    data = arena.underlying_malloc(class_size);
+  }
+  return data;
+}
+
+void deallocate(Arena& arena, void* data, std::size_t size) {
+  ScopedTimer timer("arena deallocate");
+  if (data == nullptr) return;
+  auto const size_class = arena_size_class(size);
+  auto const class_size = arena_class_size(size_class);
+  if (arena.phase_depth == 0) {
+    arena.underlying_free(data, class_size);
+    return;
+  }
+  arena.cached_bytes += class_size;
+  auto& cache = bind_thread_cache(arena);
+  if (cache.blocks[size_class].size() < thread_cache_max_blocks) {
+    cache.blocks[size_class].push_back(data);
+    cache.bytes += class_size;
+    return;
+  }
+  std::lock_guard<std::mutex> lock(arena.mutex);
+  arena.free_blocks[size_class].push_back(data);
+}
+
+ArenaStats get_stats(Arena const& arena) {
+  ArenaStats stats;
+  stats.allocations = arena.allocations;
+  stats.reused_allocations = arena.reused_allocations;
+  stats.reused_bytes = arena.reused_bytes;
+  stats.underlying_allocations = arena.underlying_allocations;
+  stats.released_bytes = arena.released_bytes;
+  return stats;
+}
+
+ArenaStats operator-(ArenaStats const& b, ArenaStats const& a) {
+  ArenaStats c;
+  c.allocations = b.allocations - a.allocations;
+  c.reused_allocations = b.reused_allocations - a.reused_allocations;
+  c.reused_bytes = b.reused_bytes - a.reused_bytes;
+  c.underlying_allocations =
+      b.underlying_allocations - a.underlying_allocations;
+  c.released_bytes = b.released_bytes - a.released_bytes;
+  return c;
+}
+
+void begin_phase(Arena& arena) { ++arena.phase_depth; }
+
+bool end_phase(Arena& arena) {
+  OMEGA_H_CHECK(arena.phase_depth > 0);
+  --arena.phase_depth;
+  if (arena.phase_depth != 0) return false;
+  release_cached(arena);
+  return true;
+}
+
+void release_cached(Arena& arena) {
+  ScopedTimer timer("arena release");
+  /* our own thread cache is flushed now,
+     the other threads flush theirs when they see the new epoch */
+  auto& cache = bind_thread_cache(arena);
+  auto released = cache.flush();
+  {
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    for (int c = 0; c < ARENA_NCLASSES; ++c) {
+      auto const class_size = arena_class_size(c);
+      for (auto block : arena.free_blocks[c]) {
+        arena.underlying_free(block, class_size);
+        released += class_size;
+      }
+      arena.free_blocks[c].clear();
+    }
+  }
+  arena.cached_bytes -= released;
+  arena.released_bytes += released;
+  ++arena.epoch;
+  cache.epoch = arena.epoch;
+}
+
+}  // namespace Omega_h
@@ -0,0 +1,80 @@
+#ifndef OMEGA_H_ARENA_HPP
+#define OMEGA_H_ARENA_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Omega_h_pool.hpp>
+
+namespace Omega_h {
+
+/* A host-side caching allocator.
+   Unlike Pool, which rounds every request to a power of two,
+   the Arena uses eight size classes per power of two
+   (at most 12.5% of a block is wasted) and keeps a small
+   thread-local free list per class in front of a shared, locked one.
+
+   Blocks are only cached while a phase is open (see begin_phase);
+   when the outermost phase ends all cached blocks are given back to
+   the underlying allocator in bulk, so the Arena never holds memory
+   between adaptation passes. */
+
+enum : int {
+  ARENA_MIN_SHIFT = 6,
+  ARENA_SUB_BITS = 3,
+  ARENA_NCLASSES = (64 - ARENA_MIN_SHIFT) * (1 << ARENA_SUB_BITS) + 1
+};
+
+int arena_size_class(std::size_t size);
+std::size_t arena_class_size(int size_class);
+
+struct ArenaStats {
+  std::size_t allocations;
+  std::size_t reused_allocations;
+  std::size_t reused_bytes;
+  std::size_t underlying_allocations;
+  std::size_t released_bytes;
+};
+
+struct Arena {
+  Arena(MallocFunc, FreeFunc);
+  ~Arena();
+  Arena(Arena const&) = delete;
+  Arena(Arena&&) = delete;
+  Arena& operator=(Arena const&) = delete;
+  Arena& operator=(Arena&&) = delete;
+  std::uint64_t id;
+  /* bumped whenever cached blocks are released,
+     thread caches holding an older epoch flush themselves */
+  std::atomic<std::uint64_t> epoch;
+  std::atomic<int> phase_depth;
+  std::mutex mutex;
+  BlockList free_blocks[ARENA_NCLASSES];
+  MallocFunc underlying_malloc;
+  FreeFunc underlying_free;
+  std::atomic<std::size_t> cached_bytes;
+  std::atomic<std::size_t> allocations;
+  std::atomic<std::size_t> reused_allocations;
+  std::atomic<std::size_t> reused_bytes;
+  std::atomic<std::size_t> underlying_allocations;
+  std::atomic<std::size_t> released_bytes;
+};
+
+void* allocate(Arena&, std::size_t);
+void deallocate(Arena&, void*, std::size_t);
+
+ArenaStats get_stats(Arena const&);
+ArenaStats operator-(ArenaStats const& b, ArenaStats const& a);
+
+void begin_phase(Arena&);
+/* returns true if this closed the outermost phase,
+   in which case all cached blocks were released */
+bool end_phase(Arena&);
+void release_cached(Arena&);
+
+}  // namespace Omega_h
+
+#endif
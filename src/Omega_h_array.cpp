@@ -81,6 +81,16 @@ Write<T>::Write(LO size_in, T offset, T stride, std::string const& name_in)
 template <typename T>
 Write<T>::Write(HostWrite<T> host_write) : Write<T>(host_write.write()) {}
 
+#ifndef OMEGA_H_USE_KOKKOS
+template <typename T>
+Write<T>::Write(LO size_in, T* data_in, std::shared_ptr<void> owner,
+    std::string const& name_in)
+    : shared_alloc_(sizeof(T) * static_cast<std::size_t>(size_in), name_in,
+          data_in, std::move(owner)) {
+  OMEGA_H_CHECK(size_in >= 0);
+}
+#endif
+
 template <typename T>
 Write<T>::Write(std::initializer_list<T> l, std::string const& name_in)
     : Write<T>(HostWrite<T>(l, name_in)) {}
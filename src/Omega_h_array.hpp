@@ -65,6 +65,11 @@ class Write {
   Write(LO size_in, T offset, T stride, std::string const& name = "");
   Write(std::initializer_list<T> l, std::string const& name = "");
   Write(HostWrite<T> host_write);
+#ifndef OMEGA_H_USE_KOKKOS
+  /* wraps memory kept alive by owner instead of allocating */
+  Write(LO size_in, T* data_in, std::shared_ptr<void> owner,
+      std::string const& name = "");
+#endif
   OMEGA_H_INLINE LO size() const OMEGA_H_NOEXCEPT;
   OMEGA_H_DEVICE T& operator[](LO i) const OMEGA_H_NOEXCEPT;
   OMEGA_H_INLINE T* data() const noexcept;
@@ -56,6 +56,26 @@ OMEGA_H_DEVICE void atomic_add(int* const dest, const int val) {
 #endif
 }
 
+/* stores desired in *dest if *dest equals expected,
+   and returns the value *dest had before */
+OMEGA_H_DEVICE int atomic_compare_exchange(
+    int* const dest, const int expected, const int desired) {
+#if defined(OMEGA_H_USE_KOKKOS)
+  return Kokkos::atomic_compare_exchange(dest, expected, desired);
+#elif defined(OMEGA_H_USE_OPENMP)
+  int oldval = expected;
+  __atomic_compare_exchange_n(
+      dest, &oldval, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+  return oldval;
+#elif defined(OMEGA_H_USE_CUDA) && defined(__CUDA_ARCH__)
+  return atomicCAS(dest, expected, desired);
+#else
+  int oldval = *dest;
+  if (oldval == expected) *dest = desired;
+  return oldval;
+#endif
+}
+
 }  // end namespace Omega_h
 
 #endif
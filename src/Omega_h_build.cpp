@@ -39,8 +39,13 @@ void add_ents2verts(
   } else {
     auto ldim = ent_dim - 1;
     auto lv2v = mesh->ask_verts_of(ldim);
-    auto v2l = mesh->ask_up(VERT, ldim);
-    auto down = reflect_down(ev2v, lv2v, v2l, mesh->family(), ent_dim, ldim);
+    Adj down;
+    if (mesh->matching() == OMEGA_H_MATCH_BY_HASH) {
+      down = reflect_down_by_hash(ev2v, lv2v, mesh->family(), ent_dim, ldim);
+    } else {
+      auto v2l = mesh->ask_up(VERT, ldim);
+      down = reflect_down(ev2v, lv2v, v2l, mesh->family(), ent_dim, ldim);
+    }
     mesh->set_ents(ent_dim, down);
   }
   if (comm->size() > 1) {
@@ -0,0 +1,162 @@
+#include "Omega_h_cavity_cache.hpp"
+
+#include <iostream>
+
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
+#include "Omega_h_mesh.hpp"
+
+namespace Omega_h {
+
+char const* const collapse_quality_cache = "collapse_quality_cache";
+char const* const swap_quality_cache = "swap_quality_cache";
+
+static std::string bits_name(std::string const& name) {
+  return name + "_bits";
+}
+
+static void add_cavity_cache(Mesh* mesh, std::string const& name, Int ncomps) {
+  auto const nedges = mesh->nedges();
+  mesh->add_tag(EDGE, name, ncomps, Reals(nedges * ncomps, -1.0));
+  mesh->add_tag(EDGE, bits_name(name), 1, Read<I8>(nedges, I8(0)));
+}
+
+void add_cavity_caches(Mesh* mesh) {
+  /* one quality per collapse direction. 1D cavities are cheap,
+     and only tetrahedra are swapped by a costly search */
+  if (mesh->dim() >= 2) add_cavity_cache(mesh, collapse_quality_cache, 2);
+  if (mesh->dim() == 3) add_cavity_cache(mesh, swap_quality_cache, 1);
+}
+
+void remove_cavity_caches(Mesh* mesh) {
+  for (auto name : {collapse_quality_cache, swap_quality_cache}) {
+    mesh->remove_tag(EDGE, name);
+    mesh->remove_tag(EDGE, bits_name(name));
+  }
+}
+
+Read<I8> find_cavity_cache_misses(Mesh* mesh, std::string const& name,
+    LOs cands2edges, Read<I8> cand_wanted) {
+  auto const edge_bits = mesh->get_array<I8>(EDGE, bits_name(name));
+  auto const ncands = cands2edges.size();
+  Write<I8> out(ncands);
+  auto f = OMEGA_H_LAMBDA(LO cand) {
+    out[cand] =
+        static_cast<I8>(cand_wanted[cand] & ~edge_bits[cands2edges[cand]]);
+  };
+  parallel_for(ncands, f, "find_cavity_cache_misses");
+  return out;
+}
+
+Reals update_cavity_cache(Mesh* mesh, std::string const& name,
+    LOs cands2edges, Read<I8> cand_wanted, LOs misses2cands,
+    Read<I8> miss_bits, Reals miss_values) {
+  auto const ncomps = mesh->get_tagbase(EDGE, name)->ncomps();
+  Write<Real> values = deep_copy(mesh->get_array<Real>(EDGE, name));
+  Write<I8> bits = deep_copy(mesh->get_array<I8>(EDGE, bits_name(name)));
+  auto const misses2edges = unmap(misses2cands, cands2edges, 1);
+  auto f = OMEGA_H_LAMBDA(LO miss) {
+    auto const e = misses2edges[miss];
+    for (Int c = 0; c < ncomps; ++c) {
+      if (!((miss_bits[miss] >> c) & 1)) continue;
+      values[e * ncomps + c] = miss_values[miss * ncomps + c];
+    }
+    bits[e] = static_cast<I8>(bits[e] | miss_bits[miss]);
+  };
+  parallel_for(misses2edges.size(), f, "update_cavity_cache");
+  /* copies whose owner measured something else are overwritten too,
+     so the bits stay the same on all copies of an edge */
+  auto const synced_values = mesh->sync_array(EDGE, Reals(values), ncomps);
+  auto const synced_bits = mesh->sync_array(EDGE, Read<I8>(bits), 1);
+  mesh->set_tag(EDGE, name, synced_values, true);
+  mesh->set_tag(EDGE, bits_name(name), synced_bits, true);
+  auto const ncands = cands2edges.size();
+  Write<Real> out(ncands * ncomps);
+  auto g = OMEGA_H_LAMBDA(LO cand) {
+    auto const e = cands2edges[cand];
+    auto const bits_out = cand_wanted[cand] & synced_bits[e];
+    for (Int c = 0; c < ncomps; ++c) {
+      out[cand * ncomps + c] =
+          ((bits_out >> c) & 1) ? synced_values[e * ncomps + c] : -1.0;
+    }
+  };
+  parallel_for(ncands, g, "update_cavity_cache");
+  return out;
+}
+
+template <typename T>
+static void transfer_kept(Mesh* old_mesh, Mesh* new_mesh,
+    std::string const& name, T stale_value, Read<I8> old_edges_are_kept,
+    LOs same_ents2old_ents, LOs same_ents2new_ents) {
+  auto const ncomps = old_mesh->get_tagbase(EDGE, name)->ncomps();
+  auto const old_data = old_mesh->get_array<T>(EDGE, name);
+  Write<T> new_data(new_mesh->nedges() * ncomps, stale_value);
+  auto f = OMEGA_H_LAMBDA(LO same) {
+    auto const old_edge = same_ents2old_ents[same];
+    if (!old_edges_are_kept[old_edge]) return;
+    auto const new_edge = same_ents2new_ents[same];
+    for (Int c = 0; c < ncomps; ++c) {
+      new_data[new_edge * ncomps + c] = old_data[old_edge * ncomps + c];
+    }
+  };
+  parallel_for(same_ents2old_ents.size(), f, "transfer_cavity_caches");
+  new_mesh->add_tag(EDGE, name, ncomps, Read<T>(new_data), true);
+}
+
+void transfer_cavity_caches(Mesh* old_mesh, Mesh* new_mesh, Int key_dim,
+    LOs keys2kds, LOs same_ents2old_ents, LOs same_ents2new_ents) {
+  bool const has_collapses = old_mesh->has_tag(EDGE, collapse_quality_cache);
+  bool const has_swaps = old_mesh->has_tag(EDGE, swap_quality_cache);
+  if (!has_collapses && !has_swaps) return;
+  auto const dim = old_mesh->dim();
+  /* every element that will be replaced surrounds a key */
+  auto const keys_marked = mark_image(keys2kds, old_mesh->nents(key_dim));
+  auto const cav_elems = mark_up(old_mesh, key_dim, dim, keys_marked);
+  /* a swap depends on the elements around its edge, and a collapse
+     on the elements around the vertex that goes away */
+  if (has_swaps) {
+    auto const edges_in_cavs = mark_down(old_mesh, dim, EDGE, cav_elems);
+    auto const kept = each_eq_to(edges_in_cavs, I8(0));
+    transfer_kept(old_mesh, new_mesh, swap_quality_cache, -1.0, kept,
+        same_ents2old_ents, same_ents2new_ents);
+    transfer_kept(old_mesh, new_mesh, bits_name(swap_quality_cache), I8(0),
+        kept, same_ents2old_ents, same_ents2new_ents);
+  }
+  if (has_collapses) {
+    auto const verts_in_cavs = mark_down(old_mesh, dim, VERT, cav_elems);
+    auto const edges_by_cavs = mark_up(old_mesh, VERT, EDGE, verts_in_cavs);
+    auto const kept = each_eq_to(edges_by_cavs, I8(0));
+    transfer_kept(old_mesh, new_mesh, collapse_quality_cache, -1.0, kept,
+        same_ents2old_ents, same_ents2new_ents);
+    transfer_kept(old_mesh, new_mesh, bits_name(collapse_quality_cache),
+        I8(0), kept, same_ents2old_ents, same_ents2new_ents);
+  }
+}
+
+void print_cavity_cache_stats(
+    Mesh* mesh, char const* what, CavityCacheStats const& stats) {
+  auto const comm = mesh->comm();
+  auto const hits = comm->allreduce(stats.hits, OMEGA_H_SUM);
+  auto const misses = comm->allreduce(stats.misses, OMEGA_H_SUM);
+  auto const seconds = comm->allreduce(stats.seconds, OMEGA_H_MAX);
+  if (!can_print(mesh)) return;
+  auto const total = hits + misses;
+  auto const rate = total ? Real(hits) / Real(total) : 0.0;
+  std::cout << what << " cavity cache hit " << hits << " of " << total
+            << " candidates (" << (rate * 100.0) << "%)";
+  if (misses) {
+    std::cout << ", measuring the rest took " << seconds << " seconds";
+  }
+  /* the time of a few misses is mostly overhead, and would be
+     multiplied by the ratio of hits to misses */
+  constexpr GO min_misses_to_extrapolate = 1000;
+  if (hits && misses >= min_misses_to_extrapolate) {
+    std::cout << " and saved about " << (seconds * Real(hits) / Real(misses))
+              << " seconds";
+  }
+  std::cout << '\n';
+}
+
+}  // end namespace Omega_h
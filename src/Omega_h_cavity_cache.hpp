@@ -0,0 +1,51 @@
+#ifndef OMEGA_H_CAVITY_CACHE_HPP
+#define OMEGA_H_CAVITY_CACHE_HPP
+
+#include <string>
+
+#include <Omega_h_array.hpp>
+
+namespace Omega_h {
+
+class Mesh;
+
+/* caches of the qualities that edge candidates (collapses, swaps)
+   would produce, kept as EDGE tags across the rebuilds of one adapt().
+   a cache is a tag of values plus a tag of bits saying which of the
+   values are current. rebuilds clear the bits of edges whose cavities
+   they touched, and moving vertices or changing the metric drops the
+   caches altogether (see Mesh::react_to_set_tag) */
+
+struct CavityCacheStats {
+  GO hits = 0;
+  GO misses = 0;
+  Real seconds = 0.0;  // measuring the misses
+};
+
+extern char const* const collapse_quality_cache;
+extern char const* const swap_quality_cache;
+
+void add_cavity_caches(Mesh* mesh);
+void remove_cavity_caches(Mesh* mesh);
+
+/* the bits wanted by each candidate which are not current */
+Read<I8> find_cavity_cache_misses(Mesh* mesh, std::string const& name,
+    LOs cands2edges, Read<I8> cand_wanted);
+
+/* stores the values measured for the candidates that missed, takes
+   the owners' values everywhere, and returns the wanted values of all
+   the candidates, -1 wherever they are not current */
+Reals update_cavity_cache(Mesh* mesh, std::string const& name,
+    LOs cands2edges, Read<I8> cand_wanted, LOs misses2cands,
+    Read<I8> miss_bits, Reals miss_values);
+
+/* called by the rebuilds after they form the new edges */
+void transfer_cavity_caches(Mesh* old_mesh, Mesh* new_mesh, Int key_dim,
+    LOs keys2kds, LOs same_ents2old_ents, LOs same_ents2new_ents);
+
+void print_cavity_cache_stats(
+    Mesh* mesh, char const* what, CavityCacheStats const& stats);
+
+}  // end namespace Omega_h
+
+#endif
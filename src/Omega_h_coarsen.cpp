@@ -7,6 +7,7 @@
 #include "Omega_h_collapse.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_indset.hpp"
+#include "Omega_h_malloc.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_modify.hpp"
@@ -77,7 +78,13 @@ static bool coarsen_ghosted(Mesh* mesh, AdaptOpts const& opts,
   }
   #endif
   /* cavity quality checks */
-  auto cand_edge_quals = coarsen_qualities(mesh, cands2edges, cand_edge_codes);
+  CavityCacheStats cache_stats;
+  auto cand_edge_quals =
+      coarsen_qualities(mesh, cands2edges, cand_edge_codes, &cache_stats);
+  if (opts.verbosity >= EACH_REBUILD &&
+      mesh->has_tag(EDGE, collapse_quality_cache)) {
+    print_cavity_cache_stats(mesh, "collapse", cache_stats);
+  }
   cand_edge_codes = filter_coarsen_min_qual(
       cand_edge_codes, cand_edge_quals, opts.min_quality_allowed);
   if (improve == IMPROVE_LOCALLY) {
@@ -125,6 +132,7 @@ static void coarsen_element_based2(Mesh* mesh, AdaptOpts const& opts) {
   auto new_mesh = mesh->copy_meta();
   auto old_verts2new_verts = LOs();
   auto old_lows2new_lows = LOs();
+  Few<LOs, 4> old_dim_ents2new_ents;
   for (Int ent_dim = 0; ent_dim <= mesh->dim(); ++ent_dim) {
     auto keys2prods = LOs();
     auto prod_verts2verts = LOs();
@@ -145,6 +153,8 @@ static void coarsen_element_based2(Mesh* mesh, AdaptOpts const& opts) {
     modify_ents_adapt(mesh, &new_mesh, ent_dim, VERT, keys2verts, keys2prods,
         prod_verts2verts, old_lows2new_lows, &prods2new_ents,
         &same_ents2old_ents, &same_ents2new_ents, &old_ents2new_ents);
+    old_dim_ents2new_ents[ent_dim] = old_ents2new_ents;
+    patch_up_adjs(mesh, &new_mesh, ent_dim, old_dim_ents2new_ents);
     if (ent_dim == VERT) {
       old_verts2new_verts = old_ents2new_ents;
     }
@@ -205,6 +215,7 @@ static bool coarsen_ents(Mesh* mesh, AdaptOpts const& opts, Int ent_dim,
 
 bool coarsen_by_size(Mesh* mesh, AdaptOpts const& opts) {
   OMEGA_H_TIME_FUNCTION;
+  ScopedArenaPhase arena_phase("coarsen_by_size");
   auto comm = mesh->comm();
   auto lengths = mesh->ask_lengths();
   auto edge_is_cand = each_lt(lengths, opts.min_length_desired);
@@ -3,6 +3,7 @@
 
 #include <Omega_h_adapt.hpp>
 #include <Omega_h_adj.hpp>
+#include "Omega_h_cavity_cache.hpp"
 #include "Omega_h_host_few.hpp"
 
 namespace Omega_h {
@@ -15,7 +16,10 @@ HostFew<Read<I8>, 4> mark_dead_ents(
 Adj find_coarsen_domains(
     Mesh* mesh, LOs keys2verts, Int ent_dim, Read<I8> ents_are_dead);
 
-Reals coarsen_qualities(Mesh* mesh, LOs cands2edges, Read<I8> cand_codes);
+/* with a collapse_quality_cache on the mesh, only the candidates
+   whose cavities changed are measured again */
+Reals coarsen_qualities(Mesh* mesh, LOs cands2edges, Read<I8> cand_codes,
+    CavityCacheStats* stats = nullptr);
 
 Read<I8> filter_coarsen_min_qual(
     Read<I8> cand_codes, Reals cand_quals, Real min_qual);
@@ -2,11 +2,13 @@
 
 #include "Omega_h_align.hpp"
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_cavity_cache.hpp"
 #include "Omega_h_collapse.hpp"
 #include "Omega_h_file.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_timer.hpp"
 
 #include <iostream>
 
@@ -16,7 +18,7 @@ template <Int mesh_dim, Int metric_dim>
 Reals coarsen_qualities_tmpl(
     Mesh* mesh, LOs cands2edges, Read<I8> cand_codes) {
   OMEGA_H_CHECK(mesh->dim() == mesh_dim);
-  MetricElementQualities<mesh_dim, metric_dim> measure(mesh);
+  auto metrics = mesh->get_array<Real>(VERT, "metric");
   auto ev2v = mesh->ask_verts_of(EDGE);
   auto cv2v = mesh->ask_elem_verts();
   auto v2c = mesh->ask_up(VERT, mesh_dim);
@@ -35,7 +37,7 @@ Reals coarsen_qualities_tmpl(
       auto v_col = ev2v[e * 2 + eev_col];
       auto eev_onto = 1 - eev_col;
       auto v_onto = ev2v[e * 2 + eev_onto];
-      Real minqual = 1.0;
+      MinMetricQuality<mesh_dim, metric_dim> minqual;
       for (auto vc = v2vc[v_col]; vc < v2vc[v_col + 1]; ++vc) {
         auto c = vc2c[vc];
         auto vc_code = vc_codes[vc];
@@ -51,22 +53,21 @@ Reals coarsen_qualities_tmpl(
         if (will_die) continue;
         OMEGA_H_CHECK(0 <= ccv_col && ccv_col < mesh_dim + 1);
         ccv2v[ccv_col] = v_onto;  // vertices of new cell
-        auto qual = measure.measure(ccv2v);
-        minqual = min2(minqual, qual);
+        minqual.add(gather_vectors<mesh_dim + 1, mesh_dim>(coords, ccv2v),
+            gather_symms<mesh_dim + 1, metric_dim>(metrics, ccv2v));
       }
-      qualities[cand * 2 + eev_col] = minqual;
+      qualities[cand * 2 + eev_col] = minqual.result();
     }
   };
   parallel_for(ncands, f, "coarsen_qualities");
-  auto out = Reals(qualities);
-  return mesh->sync_subset_array(EDGE, out, cands2edges, -1.0, 2);
+  return qualities;
 }
 
-Reals coarsen_qualities(Mesh* mesh, LOs cands2edges, Read<I8> cand_codes) {
-  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_GHOSTED);
+/* before synchronization */
+static Reals measure_coarsen_qualities(
+    Mesh* mesh, LOs cands2edges, Read<I8> cand_codes) {
   auto metrics = mesh->get_array<Real>(VERT, "metric");
   auto metric_dim = get_metrics_dim(mesh->nverts(), metrics);
-  auto cand_quals = Reals();
   if (mesh->dim() == 3 && metric_dim == 3) {
     return coarsen_qualities_tmpl<3, 3>(mesh, cands2edges, cand_codes);
   }
@@ -79,12 +80,37 @@ Reals coarsen_qualities(Mesh* mesh, LOs cands2edges, Read<I8> cand_codes) {
   if (mesh->dim() == 2 && metric_dim == 1) {
     return coarsen_qualities_tmpl<2, 1>(mesh, cands2edges, cand_codes);
   }
+  OMEGA_H_NORETURN(Reals());
+}
+
+Reals coarsen_qualities(Mesh* mesh, LOs cands2edges, Read<I8> cand_codes,
+    CavityCacheStats* stats) {
+  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_GHOSTED);
   if (mesh->dim() == 1) {
     auto edges2verts = mesh->ask_verts_of(EDGE);
     auto cands2verts = unmap(cands2edges, edges2verts, 2);
     return get_1d_cavity_qualities(mesh, VERT, cands2verts);
   }
-  OMEGA_H_NORETURN(Reals());
+  if (!mesh->has_tag(EDGE, collapse_quality_cache)) {
+    auto out = measure_coarsen_qualities(mesh, cands2edges, cand_codes);
+    return mesh->sync_subset_array(EDGE, out, cands2edges, -1.0, 2);
+  }
+  auto miss_bits = find_cavity_cache_misses(
+      mesh, collapse_quality_cache, cands2edges, cand_codes);
+  auto misses2cands = collect_marked(each_neq_to(miss_bits, I8(0)));
+  miss_bits = read(unmap(misses2cands, miss_bits, 1));
+  auto t0 = now();
+  auto miss_quals = measure_coarsen_qualities(
+      mesh, unmap(misses2cands, cands2edges, 1), miss_bits);
+  auto t1 = now();
+  auto out = update_cavity_cache(mesh, collapse_quality_cache, cands2edges,
+      cand_codes, misses2cands, miss_bits, miss_quals);
+  if (stats) {
+    stats->misses += misses2cands.size();
+    stats->hits += cands2edges.size() - misses2cands.size();
+    stats->seconds += t1 - t0;
+  }
+  return out;
 }
 
 Read<I8> filter_coarsen_dirs(Read<I8> codes, Read<I8> keep_dirs) {
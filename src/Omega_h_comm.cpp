@@ -1,6 +1,7 @@
 #include "Omega_h_comm.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 
 #include "Omega_h_array_ops.hpp"
@@ -23,6 +24,104 @@ namespace Omega_h {
 }
 #endif
 
+/* the node-aware exchange copies between ranks with memcpy,
+   so the buffers handed to MPI must be in host memory */
+#if defined(OMEGA_H_USE_MPI) &&                                     \
+    (OMEGA_H_MPI_NEEDS_HOST_COPY ||                                 \
+        !(defined(OMEGA_H_USE_CUDA) || defined(OMEGA_H_USE_HIP) || \
+            defined(OMEGA_H_USE_SYCL)))
+#define OMEGA_H_NODE_AWARE 1
+#else
+#define OMEGA_H_NODE_AWARE 0
+#endif
+
+#ifdef OMEGA_H_USE_MPI
+/* the ranks of a Comm that share a node, the leaders (node rank 0)
+   of all nodes, and a window with one segment per node rank.
+   a rank writes what it sends to its node peers into its own segment,
+   preceded by a header of (offset, bytes) for each node rank,
+   and reads what it receives from theirs. */
+struct Comm::NodeShared {
+  MPI_Comm node = MPI_COMM_NULL;
+  MPI_Comm leaders = MPI_COMM_NULL;
+  I32 ranks_per_node;
+  I32 node_rank;
+  I32 node_size;
+  bool hierarchical;  // the same on all ranks
+  std::vector<I32> node_ranks;  // Comm rank -> node rank, -1 elsewhere
+  MPI_Win window = MPI_WIN_NULL;
+  I64 segment_bytes = 0;
+  std::vector<Byte*> segments;  // node rank -> segment
+  NodeShared(MPI_Comm comm, I32 ranks_per_node_in);
+  ~NodeShared();
+  NodeShared(NodeShared const&) = delete;
+  NodeShared& operator=(NodeShared const&) = delete;
+  void reserve(I64 bytes);
+  void free_window();
+};
+
+Comm::NodeShared::NodeShared(MPI_Comm comm, I32 ranks_per_node_in)
+    : ranks_per_node(ranks_per_node_in) {
+  I32 rank, size;
+  CALL(MPI_Comm_rank(comm, &rank));
+  CALL(MPI_Comm_size(comm, &size));
+  if (ranks_per_node > 0) {
+    CALL(MPI_Comm_split(comm, rank / ranks_per_node, rank, &node));
+  } else {
+    CALL(MPI_Comm_split_type(
+        comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node));
+  }
+  CALL(MPI_Comm_rank(node, &node_rank));
+  CALL(MPI_Comm_size(node, &node_size));
+  CALL(MPI_Comm_split(
+      comm, node_rank == 0 ? 0 : MPI_UNDEFINED, rank, &leaders));
+  I32 counts[2] = {node_rank == 0, node_size};
+  CALL(MPI_Allreduce(MPI_IN_PLACE, &counts[0], 1, MPI_INT, MPI_SUM, comm));
+  CALL(MPI_Allreduce(MPI_IN_PLACE, &counts[1], 1, MPI_INT, MPI_MAX, comm));
+  hierarchical = counts[0] > 1 && counts[1] > 1;
+  std::vector<I32> members(static_cast<std::size_t>(node_size));
+  CALL(MPI_Allgather(&rank, 1, MPI_INT, members.data(), 1, MPI_INT, node));
+  node_ranks.assign(std::size_t(size), -1);
+  for (I32 i = 0; i < node_size; ++i) {
+    node_ranks[std::size_t(members[std::size_t(i)])] = i;
+  }
+}
+
+Comm::NodeShared::~NodeShared() {
+  free_window();
+  if (leaders != MPI_COMM_NULL) MPI_Comm_free(&leaders);
+  MPI_Comm_free(&node);
+}
+
+void Comm::NodeShared::free_window() {
+  if (window == MPI_WIN_NULL) return;
+  CALL(MPI_Win_unlock_all(window));
+  CALL(MPI_Win_free(&window));
+  segments.clear();
+  segment_bytes = 0;
+}
+
+/* collective over the node, and bytes must be the same on all of it */
+void Comm::NodeShared::reserve(I64 bytes) {
+  if (bytes <= segment_bytes) return;
+  auto const new_bytes = std::max(bytes, 2 * segment_bytes);
+  free_window();
+  void* base;
+  CALL(MPI_Win_allocate_shared(MPI_Aint(new_bytes), 1, MPI_INFO_NULL, node,
+      &base, &window));
+  CALL(MPI_Win_lock_all(MPI_MODE_NOCHECK, window));
+  segment_bytes = new_bytes;
+  segments.resize(std::size_t(node_size));
+  for (I32 i = 0; i < node_size; ++i) {
+    MPI_Aint size;
+    int disp_unit;
+    void* segment;
+    CALL(MPI_Win_shared_query(window, i, &size, &disp_unit, &segment));
+    segments[std::size_t(i)] = static_cast<Byte*>(segment);
+  }
+}
+#endif
+
 Comm::Comm() {
 #ifdef OMEGA_H_USE_MPI
   impl_ = MPI_COMM_NULL;
@@ -97,7 +196,9 @@ CommPtr Comm::dup() const {
 #ifdef OMEGA_H_USE_MPI
   MPI_Comm impl2;
   CALL(MPI_Comm_dup(impl_, &impl2));
-  return CommPtr(new Comm(library_, impl2));
+  auto comm2 = CommPtr(new Comm(library_, impl2));
+  comm2->node_ = node_;
+  return comm2;
 #else
   return CommPtr(
       new Comm(library_, srcs_.exists(), srcs_.exists() && srcs_.size() == 1));
@@ -108,7 +209,9 @@ CommPtr Comm::split(I32 color, I32 key) const {
 #ifdef OMEGA_H_USE_MPI
   MPI_Comm impl2;
   CALL(MPI_Comm_split(impl_, color, key, &impl2));
-  return CommPtr(new Comm(library_, impl2));
+  auto comm2 = CommPtr(new Comm(library_, impl2));
+  if (node_) comm2->enable_node_aware(node_->ranks_per_node);
+  return comm2;
 #else
   (void)color;
   (void)key;
@@ -173,7 +276,9 @@ CommPtr Comm::graph(Read<I32> dsts) const {
     h_sources[i] = v_sources[std::size_t(i)];
   MPI_Comm impl2;
   CALL(MPI_Comm_dup(impl_, &impl2));
-  return CommPtr(new Comm(library_, impl2, h_sources.write(), dsts));
+  auto comm2 = CommPtr(new Comm(library_, impl2, h_sources.write(), dsts));
+  comm2->node_ = node_;
+  return comm2;
 #else
   return CommPtr(new Comm(library_, true, dsts.size() == 1));
 #endif
@@ -183,7 +288,9 @@ CommPtr Comm::graph_adjacent(Read<I32> srcs, Read<I32> dsts) const {
 #ifdef OMEGA_H_USE_MPI
   MPI_Comm impl2;
   CALL(MPI_Comm_dup(impl_, &impl2));
-  return CommPtr(new Comm(library_, impl2, srcs, dsts));
+  auto comm2 = CommPtr(new Comm(library_, impl2, srcs, dsts));
+  comm2->node_ = node_;
+  return comm2;
 #else
   OMEGA_H_CHECK(srcs == dsts);
   return CommPtr(new Comm(library_, true, dsts.size() == 1));
@@ -198,9 +305,37 @@ Read<I32> Comm::sources() const { return srcs_; }
 
 Read<I32> Comm::destinations() const { return dsts_; }
 
+void Comm::enable_node_aware(I32 ranks_per_node) {
+#if OMEGA_H_NODE_AWARE
+  node_ = std::make_shared<NodeShared>(impl_, ranks_per_node);
+#else
+  (void)ranks_per_node;
+#endif
+}
+
+bool Comm::is_node_aware() const {
+#ifdef OMEGA_H_USE_MPI
+  return bool(node_);
+#else
+  return false;
+#endif
+}
+
 template <typename T>
 T Comm::allreduce(T x, Omega_h_Op op) const {
 #ifdef OMEGA_H_USE_MPI
+  if (node_ && node_->hierarchical) {
+    /* only one rank per node takes part in the reduction across nodes */
+    auto const type = MpiTraits<T>::datatype();
+    T y = x;
+    CALL(MPI_Reduce(&x, &y, 1, type, mpi_op(op), 0, node_->node));
+    if (node_->leaders != MPI_COMM_NULL) {
+      CALL(MPI_Allreduce(
+          MPI_IN_PLACE, &y, 1, type, mpi_op(op), node_->leaders));
+    }
+    CALL(MPI_Bcast(&y, 1, type, 0, node_->node));
+    return y;
+  }
   CALL(MPI_Allreduce(
       MPI_IN_PLACE, &x, 1, MpiTraits<T>::datatype(), mpi_op(op), impl_));
 #else
@@ -367,6 +502,79 @@ static Future<I32>::requests_type Neighbor_ialltoallv(HostRead<I32> sources,
   return sendrecvreqs;
 }
 
+/* messages to ranks of other nodes go through MPI as usual while
+   those within the node are copied through the shared window.
+   collective over the node even for ranks without node neighbors,
+   since writing a segment must wait until its readers are done
+   with the previous exchange */
+void Comm::node_alltoallv(Byte const* sendbuf, HostRead<LO> sdispls,
+    Byte* recvbuf, HostRead<LO> rdispls, Int packet_bytes) const {
+  OMEGA_H_TIME_FUNCTION;
+  auto& node = *node_;
+  int const tag = 42;
+  auto const indegree = host_srcs_.size();
+  auto const outdegree = host_dsts_.size();
+  auto const header_bytes = I64(node.node_size) * 2 * I64(sizeof(I64));
+  I64 needed = header_bytes;
+  for (LO i = 0; i < outdegree; ++i) {
+    if (node.node_ranks[std::size_t(host_dsts_[i])] < 0) continue;
+    needed += I64(sdispls[i + 1] - sdispls[i]) * packet_bytes;
+  }
+  /* the maximum over the node also keeps anyone from overwriting
+     a segment its peers may still be reading */
+  CALL(MPI_Allreduce(MPI_IN_PLACE, &needed, 1, MPI_INT64_T, MPI_MAX,
+      node.node));
+  node.reserve(needed);
+  std::vector<MPI_Request> requests;
+  requests.reserve(std::size_t(indegree + outdegree));
+  for (LO i = 0; i < indegree; ++i) {
+    if (node.node_ranks[std::size_t(host_srcs_[i])] >= 0) continue;
+    requests.emplace_back();
+    CALL(MPI_Irecv(recvbuf + I64(rdispls[i]) * packet_bytes,
+        (rdispls[i + 1] - rdispls[i]) * packet_bytes, MPI_BYTE, host_srcs_[i],
+        tag, impl_, &requests.back()));
+  }
+  for (LO i = 0; i < outdegree; ++i) {
+    if (node.node_ranks[std::size_t(host_dsts_[i])] >= 0) continue;
+    requests.emplace_back();
+    CALL(MPI_Isend(sendbuf + I64(sdispls[i]) * packet_bytes,
+        (sdispls[i + 1] - sdispls[i]) * packet_bytes, MPI_BYTE, host_dsts_[i],
+        tag, impl_, &requests.back()));
+  }
+  auto const segment = node.segments[std::size_t(node.node_rank)];
+  auto const header = reinterpret_cast<I64*>(segment);
+  auto offset = header_bytes;
+  for (LO i = 0; i < outdegree; ++i) {
+    auto const peer = node.node_ranks[std::size_t(host_dsts_[i])];
+    if (peer < 0) continue;
+    auto const bytes = I64(sdispls[i + 1] - sdispls[i]) * packet_bytes;
+    header[2 * peer] = offset;
+    header[2 * peer + 1] = bytes;
+    if (bytes) {
+      std::memcpy(segment + offset, sendbuf + I64(sdispls[i]) * packet_bytes,
+          std::size_t(bytes));
+    }
+    offset += bytes;
+  }
+  CALL(MPI_Win_sync(node.window));
+  CALL(MPI_Barrier(node.node));
+  CALL(MPI_Win_sync(node.window));
+  for (LO i = 0; i < indegree; ++i) {
+    auto const peer = node.node_ranks[std::size_t(host_srcs_[i])];
+    if (peer < 0) continue;
+    auto const peer_segment = node.segments[std::size_t(peer)];
+    auto const peer_header = reinterpret_cast<I64 const*>(peer_segment);
+    auto const bytes = I64(rdispls[i + 1] - rdispls[i]) * packet_bytes;
+    OMEGA_H_CHECK(peer_header[2 * node.node_rank + 1] == bytes);
+    if (bytes) {
+      std::memcpy(recvbuf + I64(rdispls[i]) * packet_bytes,
+          peer_segment + peer_header[2 * node.node_rank], std::size_t(bytes));
+    }
+  }
+  CALL(MPI_Waitall(
+      int(requests.size()), requests.data(), MPI_STATUSES_IGNORE));
+}
+
 #endif  // end ifdef OMEGA_H_USE_MPI
 
 template <typename T>
@@ -525,47 +733,132 @@ Future<T> Comm::ialltoallv(Read<T> sendbuf_dev, Read<LO> sdispls_dev,
 template <typename T>
 Read<T> Comm::alltoallv(Read<T> sendbuf_dev, Read<LO> sdispls_dev,
     Read<LO> rdispls_dev, Int width) const {
+#ifdef OMEGA_H_USE_MPI
+  return alltoallv(sendbuf_dev, sdispls_dev, rdispls_dev,
+      HostRead<LO>(sdispls_dev), HostRead<LO>(rdispls_dev), width);
+#else
+  return alltoallv(sendbuf_dev, sdispls_dev, rdispls_dev, HostRead<LO>(),
+      HostRead<LO>(), width);
+#endif
+}
+
+template <typename T>
+Read<T> Comm::alltoallv(Read<T> sendbuf_dev, Read<LO> sdispls_dev,
+    Read<LO> rdispls_dev, HostRead<LO> sdispls, HostRead<LO> rdispls,
+    Int width) const {
   ScopedTimer timer("Comm::alltoallv");
 #ifdef OMEGA_H_USE_MPI
 #if OMEGA_H_MPI_NEEDS_HOST_COPY
   auto self_data = self_send_part1(self_dst_, self_src_, &sendbuf_dev,
       &sdispls_dev, &rdispls_dev, width, library_->self_send_threshold());
+  if (self_data.exists()) {
+    sdispls = HostRead<LO>(sdispls_dev);
+    rdispls = HostRead<LO>(rdispls_dev);
+  }
 #endif
-  HostRead<LO> sdispls(sdispls_dev);
-  HostRead<LO> rdispls(rdispls_dev);
   OMEGA_H_CHECK(sendbuf_dev.size() == sdispls.last() * width);
   int nrecvd = rdispls.last() * width;
 #if OMEGA_H_MPI_NEEDS_HOST_COPY
   HostWrite<T> recvbuf(nrecvd);
   HostRead<T> sendbuf(sendbuf_dev);
   OMEGA_H_CHECK(recvbuf.size() == rdispls.last() * width);
-  auto reqs = Neighbor_ialltoallv(host_srcs_, host_dsts_, width,
-      nonnull(sendbuf.data()), nonnull(sdispls.data()),
-      MpiTraits<T>::datatype(), nonnull(recvbuf.data()),
-      nonnull(rdispls.data()), MpiTraits<T>::datatype(), impl_);
-  CALL(MPI_Waitall(reqs.size(), reqs.data(), MPI_STATUSES_IGNORE));
+  if (node_) {
+    node_alltoallv(reinterpret_cast<Byte const*>(sendbuf.data()), sdispls,
+        reinterpret_cast<Byte*>(recvbuf.data()), rdispls,
+        Int(sizeof(T)) * width);
+  } else {
+    auto reqs = Neighbor_ialltoallv(host_srcs_, host_dsts_, width,
+        nonnull(sendbuf.data()), nonnull(sdispls.data()),
+        MpiTraits<T>::datatype(), nonnull(recvbuf.data()),
+        nonnull(rdispls.data()), MpiTraits<T>::datatype(), impl_);
+    CALL(MPI_Waitall(reqs.size(), reqs.data(), MPI_STATUSES_IGNORE));
+  }
   auto recvbuf_dev = Read<T>(recvbuf.write());
   self_send_part2(self_data, self_src_, &recvbuf_dev, rdispls_dev, width);
 #else
+  (void)sdispls_dev;
+  (void)rdispls_dev;
   Write<T> recvbuf_dev_w(nrecvd);
   OMEGA_H_CHECK(recvbuf_dev_w.size() == rdispls.last() * width);
-  auto reqs = Neighbor_ialltoallv(host_srcs_, host_dsts_, width,
-      nonnull(sendbuf_dev.data()), nonnull(sdispls.data()),
-      MpiTraits<T>::datatype(), nonnull(recvbuf_dev_w.data()),
-      nonnull(rdispls.data()), MpiTraits<T>::datatype(), impl_,
-      sendbuf_dev.size(), recvbuf_dev_w.size());
-  CALL(MPI_Waitall(static_cast<int>(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE));
+  if (node_) {
+    node_alltoallv(reinterpret_cast<Byte const*>(sendbuf_dev.data()),
+        sdispls, reinterpret_cast<Byte*>(recvbuf_dev_w.data()), rdispls,
+        Int(sizeof(T)) * width);
+  } else {
+    auto reqs = Neighbor_ialltoallv(host_srcs_, host_dsts_, width,
+        nonnull(sendbuf_dev.data()), nonnull(sdispls.data()),
+        MpiTraits<T>::datatype(), nonnull(recvbuf_dev_w.data()),
+        nonnull(rdispls.data()), MpiTraits<T>::datatype(), impl_,
+        sendbuf_dev.size(), recvbuf_dev_w.size());
+    CALL(MPI_Waitall(
+        static_cast<int>(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE));
+  }
   Read<T> recvbuf_dev = recvbuf_dev_w;
 #endif
 #else   // !defined(OMEGA_H_USE_MPI)
   (void)sdispls_dev;
   (void)rdispls_dev;
+  (void)sdispls;
+  (void)rdispls;
   (void)width;
   auto recvbuf_dev = sendbuf_dev;
 #endif  // !defined(OMEGA_H_USE_MPI)
   return recvbuf_dev;
 }
 
+PersistentAlltoallv::PersistentAlltoallv(CommPtr comm, HostRead<LO> sdispls,
+    HostRead<LO> rdispls, Int packet_bytes)
+    : comm_(comm) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const nsent = sdispls.size() ? sdispls[sdispls.size() - 1] : 0;
+  auto const nrecvd = rdispls.size() ? rdispls[rdispls.size() - 1] : 0;
+  sendbuf_ = Write<Byte>(nsent * packet_bytes, "persistent sendbuf");
+#ifdef OMEGA_H_USE_MPI
+  recvbuf_ = Write<Byte>(nrecvd * packet_bytes, "persistent recvbuf");
+  /* a tag of its own keeps these from matching messages
+     of the non-persistent exchanges on the same Comm */
+  int const tag = 43;
+  HostRead<I32> destinations(comm_->destinations());
+  HostRead<I32> sources(comm_->sources());
+  OMEGA_H_CHECK(sdispls.size() == destinations.size() + 1);
+  OMEGA_H_CHECK(rdispls.size() == sources.size() + 1);
+  requests_.resize(std::size_t(destinations.size() + sources.size()));
+  auto const send_base = nonnull(sendbuf_.data());
+  auto const recv_base = nonnull(recvbuf_.data());
+  for (LO i = 0; i < destinations.size(); ++i) {
+    CALL(MPI_Send_init(send_base + sdispls[i] * packet_bytes,
+        (sdispls[i + 1] - sdispls[i]) * packet_bytes, MPI_BYTE,
+        destinations[i], tag, comm_->get_impl(), &requests_[std::size_t(i)]));
+  }
+  for (LO i = 0; i < sources.size(); ++i) {
+    CALL(MPI_Recv_init(recv_base + rdispls[i] * packet_bytes,
+        (rdispls[i + 1] - rdispls[i]) * packet_bytes, MPI_BYTE, sources[i],
+        tag, comm_->get_impl(),
+        &requests_[std::size_t(destinations.size() + i)]));
+  }
+#else
+  /* without MPI the only message is to ourselves */
+  OMEGA_H_CHECK(nsent == nrecvd);
+  recvbuf_ = sendbuf_;
+#endif
+}
+
+PersistentAlltoallv::~PersistentAlltoallv() {
+#ifdef OMEGA_H_USE_MPI
+  for (auto& request : requests_) MPI_Request_free(&request);
+#endif
+}
+
+void PersistentAlltoallv::exchange() {
+  ScopedTimer timer("PersistentAlltoallv::exchange");
+#ifdef OMEGA_H_USE_MPI
+  if (requests_.empty()) return;
+  CALL(MPI_Startall(int(requests_.size()), requests_.data()));
+  CALL(MPI_Waitall(
+      int(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE));
+#endif
+}
+
 void Comm::barrier() const {
 #ifdef OMEGA_H_USE_MPI
   CALL(MPI_Barrier(impl_));
@@ -573,6 +866,7 @@ void Comm::barrier() const {
 }
 
 #undef CALL
+#undef OMEGA_H_NODE_AWARE
 
 #define INST(T)                                                                \
   template T Comm::allreduce(T x, Omega_h_Op op) const;                        \
@@ -582,6 +876,9 @@ void Comm::barrier() const {
   template Read<T> Comm::alltoall(Read<T> x) const;                            \
   template Read<T> Comm::alltoallv(                                            \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
+  template Read<T> Comm::alltoallv(Read<T> sendbuf, Read<LO> sdispls,          \
+      Read<LO> rdispls, HostRead<LO> host_sdispls, HostRead<LO> host_rdispls,  \
+      Int width) const;                                                        \
   template Future<T> Comm::ialltoallv(                                       \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
 
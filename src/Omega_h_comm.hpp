@@ -2,6 +2,7 @@
 #define OMEGA_H_COMM_HPP
 
 #include <memory>
+#include <vector>
 
 #include <Omega_h_mpi.h>
 #include <Omega_h_array.hpp>
@@ -29,6 +30,9 @@ typedef std::shared_ptr<Comm> CommPtr;
 class Comm {
 #ifdef OMEGA_H_USE_MPI
   MPI_Comm impl_;
+  struct NodeShared;
+  /* shared by this Comm and those derived from it over the same ranks */
+  std::shared_ptr<NodeShared> node_;
 #endif
   Library* library_;
   Read<I32> srcs_;
@@ -62,6 +66,18 @@ class Comm {
   CommPtr graph_inverse() const;
   Read<I32> sources() const;
   Read<I32> destinations() const;
+  /* collective. from then on, alltoallv() between ranks of the same
+     node goes through a shared memory window and only messages to
+     other nodes go through MPI, and allreduce() reduces within each
+     node before reducing across nodes. Comms derived from this one
+     inherit it.
+     ranks_per_node > 0 groups consecutive ranks into pretend nodes
+     instead of asking MPI, which is meant for testing: they must
+     still be able to share memory.
+     does nothing where arrays live in device memory that MPI reads
+     directly. */
+  void enable_node_aware(I32 ranks_per_node = 0);
+  bool is_node_aware() const;
   template <typename T>
   T allreduce(T x, Omega_h_Op op) const;
   bool reduce_or(bool x) const;
@@ -79,6 +95,11 @@ class Comm {
   template <typename T>
   Read<T> alltoallv(
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
+  /* same, with host copies of the displacements
+     which a caller exchanging repeatedly can keep */
+  template <typename T>
+  Read<T> alltoallv(Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls,
+      HostRead<LO> host_sdispls, HostRead<LO> host_rdispls, Int width) const;
   template <typename T>
   Future<T> ialltoallv(
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
@@ -87,6 +108,36 @@ class Comm {
   void send(int rank, const T& x);
   template<typename T>
   void recv(int rank, T& x);
+
+ private:
+#ifdef OMEGA_H_USE_MPI
+  void node_alltoallv(Byte const* sendbuf, HostRead<LO> sdispls,
+      Byte* recvbuf, HostRead<LO> rdispls, Int packet_bytes) const;
+#endif
+};
+
+/* a neighbor exchange over the graph of a Comm whose buffers,
+   displacements and MPI requests are set up once and restarted
+   by each exchange(). callers pack packets of (packet_bytes) into
+   sendbuf() in message order and read them from recvbuf(),
+   which stays valid until the next exchange() */
+class PersistentAlltoallv {
+  CommPtr comm_;
+  Write<Byte> sendbuf_;
+  Write<Byte> recvbuf_;
+#ifdef OMEGA_H_USE_MPI
+  std::vector<MPI_Request> requests_;
+#endif
+
+ public:
+  PersistentAlltoallv(CommPtr comm, HostRead<LO> sdispls,
+      HostRead<LO> rdispls, Int packet_bytes);
+  ~PersistentAlltoallv();
+  PersistentAlltoallv(PersistentAlltoallv const&) = delete;
+  PersistentAlltoallv& operator=(PersistentAlltoallv const&) = delete;
+  Byte* sendbuf() const { return sendbuf_.data(); }
+  Byte const* recvbuf() const { return recvbuf_.data(); }
+  void exchange();
 };
 
 #ifdef OMEGA_H_USE_MPI
@@ -222,6 +273,9 @@ void Comm::recv(int rank, T& x) {
   extern template Read<T> Comm::alltoall(Read<T> x) const;                     \
   extern template Read<T> Comm::alltoallv(                                     \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;   \
+  extern template Read<T> Comm::alltoallv(Read<T> sendbuf, Read<LO> sdispls,   \
+      Read<LO> rdispls, HostRead<LO> host_sdispls, HostRead<LO> host_rdispls,  \
+      Int width) const;                                                        \
   extern template Future<T> Comm::ialltoallv(                                  \
       Read<T> sendbuf, Read<LO> sdispls, Read<LO> rdispls, Int width) const;
 OMEGA_H_EXPL_INST_DECL(I8)
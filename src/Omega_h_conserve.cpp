@@ -10,6 +10,7 @@
 #include "Omega_h_for.hpp"
 #include "Omega_h_functors.hpp"
 #include "Omega_h_graph.hpp"
+#include "Omega_h_halo.hpp"
 #include "Omega_h_host_few.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
@@ -635,10 +636,12 @@ static Graph get_elem_diffusion_graph(Mesh* mesh) {
 
 Reals diffuse_densities_once(
     Mesh* mesh, Graph g, Reals densities, Reals cell_sizes) {
-  auto out = deep_copy(densities);
+  auto out = Write<Real>(densities.size());
   auto max_deg = mesh->dim() + 1;
   auto f = OMEGA_H_LAMBDA(LO e) {
     auto s = cell_sizes[e];
+    auto x = densities[e];
+    auto y = x;
     for (auto ee = g.a2ab[e]; ee < g.a2ab[e + 1]; ++ee) {
       auto oe = g.ab2b[ee];
       auto os = cell_sizes[oe];
@@ -648,13 +651,12 @@ Reals diffuse_densities_once(
          then divide that mass value by (s) to get the density
          delta to add to this density */
       auto factor = mins / (s * max_deg);
-      auto x = densities[e];
       auto ox = densities[oe];
-      out[e] += (ox - x) * factor;
+      y += (ox - x) * factor;
     }
+    out[e] = y;
   };
-  parallel_for(mesh->nelems(), f, "diffuse_densities");
-  return mesh->sync_array(mesh->dim(), Reals(out), 1);
+  return compute_and_sync(mesh, mesh->dim(), out, 1, f, "diffuse_densities");
 }
 
 struct AllBounded : public AndFunctor {
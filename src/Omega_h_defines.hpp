@@ -69,6 +69,26 @@ enum Omega_h_Scales {
 
 enum Omega_h_Family { OMEGA_H_SIMPLEX, OMEGA_H_HYPERCUBE, OMEGA_H_MIXED };
 
+/* how new entities are matched to their existing boundary entities */
+enum Omega_h_Matching {
+  OMEGA_H_MATCH_BY_UPWARD,  // search the vertex-to-boundary upward adjacency
+  OMEGA_H_MATCH_BY_HASH,    // look up sorted vertex tuples in a hash table
+};
+
+/* how Mesh::balance decides where elements go */
+enum Omega_h_Balance {
+  OMEGA_H_BALANCE_RIB,    // recursive inertial bisection of the centroids
+  OMEGA_H_BALANCE_GRAPH,  // multilevel partitioning of the dual graph
+};
+
+/* how host-parallel loop iterations are handed out to threads,
+   see ForPolicy in Omega_h_for.hpp */
+enum Omega_h_Schedule {
+  OMEGA_H_SCHEDULE_STATIC,   // equal contiguous blocks, decided up front
+  OMEGA_H_SCHEDULE_DYNAMIC,  // chunks taken from a shared counter
+  OMEGA_H_SCHEDULE_GUIDED,   // dynamic with chunks shrinking over time
+};
+
 namespace Omega_h {
 
 typedef std::int8_t I8;
@@ -6,18 +6,176 @@
 #include "Omega_h_map.hpp"
 #include "Omega_h_sort.hpp"
 
+#include <map>
+
 namespace Omega_h {
 
-Dist::Dist() {}
+namespace {
 
-Dist::Dist(Dist const& other) { copy(other); }
+/* exchanges whose buffers would be larger than this are not kept
+   persistent, so that big one-off transfers hold no memory */
+constexpr std::size_t persistent_max_bytes = std::size_t(1) << 24;
+
+template <typename T>
+struct BatchTraits;
+
+template <>
+struct BatchTraits<I8> {
+  static constexpr Omega_h_Type type = OMEGA_H_I8;
+  template <typename Field>
+  static auto& array(Field& field) {
+    return field.i8s;
+  }
+};
+
+template <>
+struct BatchTraits<I32> {
+  static constexpr Omega_h_Type type = OMEGA_H_I32;
+  template <typename Field>
+  static auto& array(Field& field) {
+    return field.i32s;
+  }
+};
+
+template <>
+struct BatchTraits<I64> {
+  static constexpr Omega_h_Type type = OMEGA_H_I64;
+  template <typename Field>
+  static auto& array(Field& field) {
+    return field.i64s;
+  }
+};
+
+template <>
+struct BatchTraits<Real> {
+  static constexpr Omega_h_Type type = OMEGA_H_F64;
+  template <typename Field>
+  static auto& array(Field& field) {
+    return field.f64s;
+  }
+};
+
+Int type_bytes(Omega_h_Type type) {
+  Int bytes = 0;
+  apply_to_omega_h_types(
+      type, [&](auto t) { bytes = Int(sizeof(decltype(t))); });
+  return bytes;
+}
+
+/* packet i carries root packets2roots[i], or root i if that is empty */
+template <typename T>
+void pack_batch_field(Byte* packets, LO npackets, Int packet_bytes,
+    Int offset, LOs packets2roots, Read<T> data, Int width) {
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto const root = packets2roots.exists() ? packets2roots[i] : i;
+    auto const packet =
+        reinterpret_cast<T*>(packets + i * packet_bytes + offset);
+    for (Int j = 0; j < width; ++j) packet[j] = data[root * width + j];
+  };
+  parallel_for(npackets, f, "Dist::pack_batch");
+}
+
+/* item i is packet items2packets[i], or packet i if that is empty */
+template <typename T>
+Read<T> unpack_batch_field(Byte const* packets, LO nitems, Int packet_bytes,
+    Int offset, LOs items2packets, Int width) {
+  Write<T> data(nitems * width);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    auto const p = items2packets.exists() ? items2packets[i] : i;
+    auto const packet =
+        reinterpret_cast<T const*>(packets + p * packet_bytes + offset);
+    for (Int j = 0; j < width; ++j) data[i * width + j] = packet[j];
+  };
+  parallel_for(nitems, f, "Dist::unpack_batch");
+  return data;
+}
+
+/* sends packets of type W words, so that the gathers and copies
+   inside Dist::exch() move whole words rather than bytes */
+template <typename W, typename Field>
+void exch_batch(Dist const& dist, std::vector<Field> const& in,
+    std::vector<Field>& out, std::vector<Int> const& offsets,
+    Int packet_bytes, LO nroots) {
+  auto const packet_words = divide_no_remainder(packet_bytes, Int(sizeof(W)));
+  Write<W> packets(nroots * packet_words);
+  auto const sent = reinterpret_cast<Byte*>(packets.data());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    apply_to_omega_h_types(in[i].type, [&](auto t) {
+      using T = decltype(t);
+      pack_batch_field(sent, nroots, packet_bytes, offsets[i], LOs(),
+          BatchTraits<T>::array(in[i]), in[i].width);
+    });
+  }
+  auto const received = dist.exch(Read<W>(packets), packet_words);
+  auto const npackets = divide_no_remainder(received.size(), packet_words);
+  auto const recvd = reinterpret_cast<Byte const*>(received.data());
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    apply_to_omega_h_types(out[i].type, [&](auto t) {
+      using T = decltype(t);
+      BatchTraits<T>::array(out[i]) = unpack_batch_field<T>(
+          recvd, npackets, packet_bytes, offsets[i], LOs(), out[i].width);
+    });
+  }
+}
+
+}  // end anonymous namespace
+
+template <typename T>
+Int DistBatch::add(Read<T> data, Int width, Omega_h_Op op) {
+  OMEGA_H_CHECK(width > 0);
+  Field field;
+  field.type = BatchTraits<T>::type;
+  field.width = width;
+  field.op = op;
+  BatchTraits<T>::array(field) = data;
+  fields_.push_back(field);
+  return size() - 1;
+}
+
+template <typename T>
+Read<T> DistBatch::get(Int i) const {
+  OMEGA_H_CHECK(type(i) == BatchTraits<T>::type);
+  return BatchTraits<T>::array(fields_[std::size_t(i)]);
+}
+
+Int DistBatch::size() const { return Int(fields_.size()); }
+
+Omega_h_Type DistBatch::type(Int i) const {
+  return fields_[std::size_t(i)].type;
+}
+
+Int DistBatch::width(Int i) const { return fields_[std::size_t(i)].width; }
+
+Omega_h_Op DistBatch::op(Int i) const { return fields_[std::size_t(i)].op; }
+
+/* what exch() needs to send in one direction of a persistent Dist */
+struct DistPlan {
+  /* expand() and permute() fused into one gather,
+     empty when content and roots are the same */
+  LOs content2roots;
+  HostRead<LO> host_msgs2content[2];
+  /* the most packets any rank of the exchange sends or receives,
+     so that all of them agree on which packet sizes get a channel */
+  LO max_content = -1;
+  /* by packet size in bytes */
+  std::map<Int, std::unique_ptr<PersistentAlltoallv>> channels;
+};
+
+struct DistPlans {
+  std::unique_ptr<DistPlan> dirs[2];
+};
+
+Dist::Dist() : plans_dir_(0) {}
+
+Dist::Dist(Dist const& other) : plans_dir_(0) { copy(other); }
 
 Dist& Dist::operator=(Dist const& other) {
   copy(other);
   return *this;
 }
 
-Dist::Dist(CommPtr comm_in, Remotes fitems2rroots, LO nrroots) {
+Dist::Dist(CommPtr comm_in, Remotes fitems2rroots, LO nrroots)
+    : plans_dir_(0) {
   set_parent_comm(comm_in);
   set_dest_ranks(fitems2rroots.ranks);
   set_dest_idxs(fitems2rroots.idxs, nrroots);
@@ -25,10 +183,12 @@ Dist::Dist(CommPtr comm_in, Remotes fitems2rroots, LO nrroots) {
 
 void Dist::set_parent_comm(CommPtr parent_comm_in) {
   parent_comm_ = parent_comm_in;
+  plans_.reset();
 }
 
 void Dist::set_dest_ranks(Read<I32> items2ranks_in) {
   OMEGA_H_TIME_FUNCTION;
+  plans_.reset();
   constexpr bool use_small_neighborhood_algorithm = true;
   if (use_small_neighborhood_algorithm) {
     Read<I32> msgs2ranks1;
@@ -75,6 +235,7 @@ void Dist::set_dest_ranks(Read<I32> items2ranks_in) {
 
 void Dist::set_dest_idxs(LOs fitems2rroots, LO nrroots) {
   OMEGA_H_TIME_FUNCTION;
+  plans_.reset();
   auto const rcontent2rroots = exch(fitems2rroots, 1);
   auto const rroots2rcontent = invert_map_by_atomics(rcontent2rroots, nrroots);
   roots2items_[R] = rroots2rcontent.a2ab;
@@ -83,6 +244,7 @@ void Dist::set_dest_idxs(LOs fitems2rroots, LO nrroots) {
 
 void Dist::set_dest_globals(GOs fitems2ritem_globals) {
   begin_code("Dist::set_dest_globals");
+  plans_.reset();
   auto rcontent2ritem_globals = exch(fitems2ritem_globals, 1);
   items2content_[R] = sort_by_keys(rcontent2ritem_globals);
   roots2items_[R] = LOs();
@@ -91,6 +253,7 @@ void Dist::set_dest_globals(GOs fitems2ritem_globals) {
 
 void Dist::set_roots2items(LOs froots2fitems) {
   roots2items_[F] = froots2fitems;
+  plans_.reset();
 }
 
 Dist Dist::invert() const {
@@ -102,13 +265,23 @@ Dist Dist::invert() const {
     out.msgs2content_[i] = msgs2content_[1 - i];
     out.comm_[i] = comm_[1 - i];
   }
+  out.plans_ = plans_;
+  out.plans_dir_ = 1 - plans_dir_;
   return out;
 }
 
+void Dist::persist() {
+  plans_ = std::make_shared<DistPlans>();
+  plans_dir_ = 0;
+}
+
+bool Dist::is_persistent() const { return plans_ != nullptr; }
+
 template <typename T>
 Read<T> Dist::exch(Read<T> data, Int width) const {
   OMEGA_H_TIME_FUNCTION;
   ScopedTimer exch_timer("Dist::exch");
+  if (plans_) return exch_planned(data, width);
   if (roots2items_[F].exists()) {
     data = expand(data, roots2items_[F], width);
   }
@@ -122,6 +295,108 @@ Read<T> Dist::exch(Read<T> data, Int width) const {
   return data;
 }
 
+DistPlan const& Dist::ask_plan() const {
+  auto& plan = plans_->dirs[plans_dir_];
+  if (!plan) {
+    plan.reset(new DistPlan());
+    if (items2content_[F].exists() || roots2items_[F].exists()) {
+      auto content2items = items2content_[F].exists()
+                               ? invert_permutation(items2content_[F])
+                               : LOs(nitems(), 0, 1);
+      plan->content2roots =
+          roots2items_[F].exists()
+              ? unmap(content2items, invert_fan(roots2items_[F]), 1)
+              : content2items;
+    }
+    for (Int i = 0; i < 2; ++i) {
+      plan->host_msgs2content[i] = HostRead<LO>(msgs2content_[i]);
+    }
+  }
+  return *plan;
+}
+
+PersistentAlltoallv* Dist::ask_channel(Int packet_bytes) const {
+#if OMEGA_H_MPI_NEEDS_HOST_COPY
+  /* persistent requests on device buffers need GPU-aware MPI */
+  (void)packet_bytes;
+  return nullptr;
+#else
+  /* a node-aware Comm moves messages within a node through shared
+     memory, which only its alltoallv() does */
+  if (comm_[F]->is_node_aware()) return nullptr;
+  ask_plan();
+  auto& plan = plans_->dirs[plans_dir_];
+  if (plan->max_content < 0) {
+    auto const nsent = msgs2content_[F].last();
+    auto const nrecvd = msgs2content_[R].last();
+    plan->max_content = comm_[F]->allreduce(max2(nsent, nrecvd), OMEGA_H_MAX);
+  }
+  if (std::size_t(plan->max_content) * std::size_t(packet_bytes) >
+      persistent_max_bytes) {
+    return nullptr;
+  }
+  auto& channel = plan->channels[packet_bytes];
+  if (!channel) {
+    channel.reset(new PersistentAlltoallv(comm_[F], plan->host_msgs2content[F],
+        plan->host_msgs2content[R], packet_bytes));
+  }
+  return channel.get();
+#endif
+}
+
+template <typename T>
+Read<T> Dist::exch_planned(Read<T> data, Int width) const {
+  auto const& plan = ask_plan();
+  auto const nsent = msgs2content_[F].last();
+  auto const nrecvd = msgs2content_[R].last();
+  auto const channel = ask_channel(Int(sizeof(T)) * width);
+  if (!channel) {
+    if (plan.content2roots.exists()) {
+      data = unmap(plan.content2roots, data, width);
+    }
+    data = comm_[F]->alltoallv(data, msgs2content_[F], msgs2content_[R],
+        plan.host_msgs2content[F], plan.host_msgs2content[R], width);
+    if (items2content_[R].exists()) {
+      data = unmap(items2content_[R], data, width);
+    }
+    return data;
+  }
+  auto const sendbuf = reinterpret_cast<T*>(channel->sendbuf());
+  auto const content2roots = plan.content2roots;
+  if (content2roots.exists()) {
+    auto pack = OMEGA_H_LAMBDA(LO c) {
+      auto const root = content2roots[c];
+      for (Int j = 0; j < width; ++j) {
+        sendbuf[c * width + j] = data[root * width + j];
+      }
+    };
+    parallel_for(nsent, pack, "Dist::pack");
+  } else {
+    OMEGA_H_CHECK(data.size() == nsent * width);
+    auto pack = OMEGA_H_LAMBDA(LO i) { sendbuf[i] = data[i]; };
+    parallel_for(nsent * width, pack, "Dist::pack");
+  }
+  channel->exchange();
+  auto const recvbuf = reinterpret_cast<T const*>(channel->recvbuf());
+  auto const items2content = items2content_[R];
+  if (items2content.exists()) {
+    auto const nitems = items2content.size();
+    Write<T> out(nitems * width);
+    auto unpack = OMEGA_H_LAMBDA(LO item) {
+      auto const c = items2content[item];
+      for (Int j = 0; j < width; ++j) {
+        out[item * width + j] = recvbuf[c * width + j];
+      }
+    };
+    parallel_for(nitems, unpack, "Dist::unpack");
+    return out;
+  }
+  Write<T> out(nrecvd * width);
+  auto unpack = OMEGA_H_LAMBDA(LO i) { out[i] = recvbuf[i]; };
+  parallel_for(nrecvd * width, unpack, "Dist::unpack");
+  return out;
+}
+
 template <typename T>
 Future<T> Dist::iexch(Read<T> data, Int width) const {
   ScopedTimer exch_timer("Dist::iexch");
@@ -132,9 +407,12 @@ Future<T> Dist::iexch(Read<T> data, Int width) const {
     data = permute(data, items2content_[F], width);
   }
   auto future = comm_[F]->ialltoallv(data, msgs2content_[F], msgs2content_[R], width);
-  auto callback = [this,width](Read<T> buf) {
-    if (this->items2content_[R].exists()) {
-      buf = unmap(this->items2content_[R], buf, width);
+  /* by value, since this Dist may be gone by the time the
+     future completes (Mesh::isync_array() uses a temporary) */
+  auto const items2content = items2content_[R];
+  auto callback = [items2content, width](Read<T> buf) {
+    if (items2content.exists()) {
+      buf = unmap(items2content, buf, width);
     }
     return buf;
   };
@@ -148,6 +426,86 @@ Read<T> Dist::exch_reduce(Read<T> data, Int width, Omega_h_Op op) const {
   return fan_reduce(roots2items_[R], item_data, width, op);
 }
 
+DistBatch Dist::exch(DistBatch const& batch) const {
+  OMEGA_H_TIME_FUNCTION;
+  auto out = batch;
+  auto const nfields = batch.size();
+  if (nfields == 0) return out;
+  /* laying out the widest types first keeps every value aligned,
+     given that the packet size is a multiple of the widest type */
+  std::vector<Int> offsets(std::size_t(nfields), 0);
+  Int packet_bytes = 0;
+  Int align = 1;
+  for (Int bytes = 8; bytes >= 1; bytes /= 2) {
+    for (Int i = 0; i < nfields; ++i) {
+      if (type_bytes(batch.type(i)) != bytes) continue;
+      offsets[std::size_t(i)] = packet_bytes;
+      packet_bytes += bytes * batch.width(i);
+      align = max2(align, bytes);
+    }
+  }
+  packet_bytes = ((packet_bytes + align - 1) / align) * align;
+  auto const nroots = roots2items_[F].exists() ? this->nroots() : nitems();
+  for (Int i = 0; i < nfields; ++i) {
+    apply_to_omega_h_types(batch.type(i), [&](auto t) {
+      using T = decltype(t);
+      OMEGA_H_CHECK(batch.get<T>(i).size() == nroots * batch.width(i));
+    });
+  }
+  /* a persistent Dist packs straight into its send buffer in content
+     order and unpacks straight out of its receive buffer */
+  if (plans_) {
+    auto const& plan = ask_plan();
+    if (auto const channel = ask_channel(packet_bytes)) {
+      auto const nsent = msgs2content_[F].last();
+      for (Int i = 0; i < nfields; ++i) {
+        apply_to_omega_h_types(batch.type(i), [&](auto t) {
+          using T = decltype(t);
+          pack_batch_field(channel->sendbuf(), nsent, packet_bytes,
+              offsets[std::size_t(i)], plan.content2roots, batch.get<T>(i),
+              batch.width(i));
+        });
+      }
+      channel->exchange();
+      auto const nitems = items2content_[R].exists()
+                              ? items2content_[R].size()
+                              : msgs2content_[R].last();
+      for (Int i = 0; i < nfields; ++i) {
+        apply_to_omega_h_types(batch.type(i), [&](auto t) {
+          using T = decltype(t);
+          BatchTraits<T>::array(out.fields_[std::size_t(i)]) =
+              unpack_batch_field<T>(channel->recvbuf(), nitems, packet_bytes,
+                  offsets[std::size_t(i)], items2content_[R], batch.width(i));
+        });
+      }
+      return out;
+    }
+  }
+  if (align == 8) {
+    exch_batch<I64>(*this, batch.fields_, out.fields_, offsets, packet_bytes,
+        nroots);
+  } else if (align == 4) {
+    exch_batch<I32>(*this, batch.fields_, out.fields_, offsets, packet_bytes,
+        nroots);
+  } else {
+    exch_batch<I8>(*this, batch.fields_, out.fields_, offsets, packet_bytes,
+        nroots);
+  }
+  return out;
+}
+
+DistBatch Dist::exch_reduce(DistBatch const& batch) const {
+  auto out = exch(batch);
+  for (auto& field : out.fields_) {
+    apply_to_omega_h_types(field.type, [&](auto t) {
+      using T = decltype(t);
+      auto& array = BatchTraits<T>::array(field);
+      array = fan_reduce(roots2items_[R], array, field.width, field.op);
+    });
+  }
+  return out;
+}
+
 CommPtr Dist::parent_comm() const { return parent_comm_; }
 
 CommPtr Dist::comm() const { return comm_[F]; }
@@ -194,6 +552,7 @@ LO Dist::ndests() const { return invert().nsrcs(); }
    to another. essentially, we have to map from old ranks to
    new ranks, and rebuild graph communicators as well */
 void Dist::change_comm(CommPtr new_comm) {
+  plans_.reset();
   // gather the new ranks of our neighbors
   auto new_sources = comm_[F]->allgather(new_comm->rank());
   auto new_destinations = comm_[R]->allgather(new_comm->rank());
@@ -219,6 +578,8 @@ void Dist::copy(Dist const& other) {
     msgs2content_[i] = other.msgs2content_[i];
     comm_[i] = other.comm_[i];
   }
+  plans_ = other.plans_;
+  plans_dir_ = other.plans_dir_;
 }
 
 Dist create_dist_for_variable_sized(Dist copies2owners, LOs copies2data) {
@@ -257,6 +618,8 @@ Dist create_dist_for_variable_sized(Dist copies2owners, LOs copies2data) {
 }
 
 #define INST_T(T)                                                              \
+  template Int DistBatch::add(Read<T> data, Int width, Omega_h_Op op);         \
+  template Read<T> DistBatch::get(Int i) const;                                \
   template Read<T> Dist::exch(Read<T> data, Int width) const;                  \
   template Future<T> Dist::iexch(Read<T> data, Int width) const;             \
   template Read<T> Dist::exch_reduce(Read<T> data, Int width, Omega_h_Op op)   \
@@ -116,12 +116,48 @@ namespace Omega_h {
    For a depiction of the process, consult Figure 4.3(Page 106)
 */
 
+struct DistPlan;
+struct DistPlans;
+
+/* arrays with one packet per root each, possibly of different types
+   and widths, which Dist::exch() sends interleaved as one packet per
+   root so that the whole batch costs a single round of messages */
+class DistBatch {
+ public:
+  /* op is only used by Dist::exch_reduce() */
+  template <typename T>
+  Int add(Read<T> data, Int width, Omega_h_Op op = OMEGA_H_SUM);
+  template <typename T>
+  Read<T> get(Int i) const;
+  Int size() const;
+  Omega_h_Type type(Int i) const;
+  Int width(Int i) const;
+  Omega_h_Op op(Int i) const;
+
+ private:
+  friend class Dist;
+  struct Field {
+    Omega_h_Type type;
+    Int width;
+    Omega_h_Op op;
+    Read<I8> i8s;
+    Read<I32> i32s;
+    Read<I64> i64s;
+    Reals f64s;
+  };
+  std::vector<Field> fields_;
+};
+
 class Dist {
   CommPtr parent_comm_;
   LOs roots2items_[2];
   LOs items2content_[2];
   LOs msgs2content_[2];
   CommPtr comm_[2];
+  /* shared by copies and inverses of a persistent Dist,
+     plans_dir_ says which of its two directions this one sends */
+  std::shared_ptr<DistPlans> plans_;
+  Int plans_dir_;
 
  public:
   Dist();
@@ -160,12 +196,22 @@ class Dist {
      one may only call this API or set_dest_idxs(), not both */
   void set_dest_globals(GOs fitems2ritem_globals);
   Dist invert() const;
+  /* prepare for many exchanges with this communication pattern:
+     exch() in either direction, by this Dist, its copies or its
+     inverses, will pack with one fused gather, keep its displacements
+     on the host, and reuse buffers and persistent MPI requests.
+     any of the set_* calls above undo this. */
+  void persist();
+  bool is_persistent() const;
   template <typename T>
   Read<T> exch(Read<T> data, Int width) const;
   template <typename T>
   Future<T> iexch(Read<T> data, Int width) const;
   template <typename T>
   Read<T> exch_reduce(Read<T> data, Int width, Omega_h_Op op) const;
+  DistBatch exch(DistBatch const& batch) const;
+  /* reduces each array of the batch by its own op */
+  DistBatch exch_reduce(DistBatch const& batch) const;
   CommPtr parent_comm() const;
   CommPtr comm() const;
   LOs msgs2content() const;
@@ -186,6 +232,12 @@ class Dist {
 
  private:
   void copy(Dist const& other);
+  DistPlan const& ask_plan() const;
+  /* null if this exchange should not be kept persistent. all ranks
+     decide alike, so the first call for a plan is collective */
+  PersistentAlltoallv* ask_channel(Int packet_bytes) const;
+  template <typename T>
+  Read<T> exch_planned(Read<T> data, Int width) const;
   enum { F, R };
 };
 
@@ -199,6 +251,8 @@ class Dist {
 Dist create_dist_for_variable_sized(Dist copies2owners, LOs copies2data);
 
 #define OMEGA_H_EXPL_INST_DECL(T)                                              \
+  extern template Int DistBatch::add(Read<T> data, Int width, Omega_h_Op op);  \
+  extern template Read<T> DistBatch::get(Int i) const;                         \
   extern template Read<T> Dist::exch(Read<T> data, Int width) const;           \
   extern template Future<T> Dist::iexch(Read<T> data, Int width) const;        \
   extern template Read<T> Dist::exch_reduce<T>(                                \
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <sstream>
 
 #include <Omega_h_array_ops.hpp>
@@ -376,7 +377,7 @@ template <Int dim>
 any access(LO size, any& var, ExprReader::Args& args) {
   auto i = static_cast<Int>(any_cast<Real>(args.at(0)));
   auto j =
-      args.size() > 1 ? static_cast<Int>(any_cast<Real>(args.at(0))) : Int(-1);
+      args.size() > 1 ? static_cast<Int>(any_cast<Real>(args.at(1))) : Int(-1);
   if (var.type() == typeid(Vector<dim>)) {
     return (any_cast<Vector<dim>>(var))(i);
   } else if (var.type() == typeid(Tensor<dim>)) {
@@ -386,7 +387,7 @@ any access(LO size, any& var, ExprReader::Args& args) {
     if (array.size() == size * dim) {
       return Reals(get_component(array, dim, i));
     } else if (array.size() == size * matrix_ncomps(dim, dim)) {
-      return Reals(get_component(array, matrix_ncomps(dim, dim), j * dim + i));
+      return Reals(get_component(array, matrix_ncomps(dim, dim), i * dim + j));
     } else {
       std::stringstream ss;
       ss << "Unexpected array size " << array.size() << " in access operator\n";
@@ -689,6 +690,7 @@ ExprEnv::ExprEnv(LO size_in, Int dim_in) : size(size_in), dim(dim_in) {
   if (dim == 2) register_variable("I", any(identity_matrix<2, 2>()));
   if (dim == 1) register_variable("I", any(identity_matrix<1, 1>()));
   register_variable("pi", any(Real(Omega_h::PI)));
+  for (auto& function : functions) builtin_functions.insert(function.first);
 }
 
 void ExprEnv::register_variable(std::string const& name, any const& value) {
@@ -703,6 +705,7 @@ void ExprEnv::register_function(
   OMEGA_H_CHECK(variables.find(name) == variables.end());
   // OMEGA_H_CHECK(functions.find(name) == functions.end());
   functions[name] = value;
+  builtin_functions.erase(name);
 }
 
 void ExprEnv::repeat(any& x) { promote(size, dim, x); }
@@ -856,6 +859,589 @@ any ExprReader::at_reduce(int prod, std::vector<any>& rhs) {
   return any();
 }
 
+enum ExprKind { EXPR_SCALAR, EXPR_VECTOR, EXPR_TENSOR, EXPR_SYMM, EXPR_BOOL };
+
+/* ExprProgram bytecode.
+   Every instruction is EXPR_INSTR_WIDTH integers:
+     opcode, destination, first operand, second operand, third operand, n
+   where operands are register indices and n is a component count or
+   component index, depending on the opcode. */
+
+namespace {
+
+enum : LO {
+  EXPR_LOAD_CONST,      // dst[0:n] = constants[a:a+n]
+  EXPR_LOAD_INPUT,      // dst[0:n] = inputs[a][e*n:e*n+n]
+  EXPR_ZERO,            // dst[0:n] = 0
+  EXPR_ADD,             // dst[0:n] = a + b
+  EXPR_SUB,             // dst[0:n] = a - b
+  EXPR_NEG,             // dst[0:n] = -a
+  EXPR_SCALE,           // dst[0:n] = a * b[0]
+  EXPR_DIV,             // dst[0:n] = a / b[0]
+  EXPR_DIV_MAYBE_ZERO,  // same, but zero where b[0] is zero
+  EXPR_DOT,             // dst[0] = a . b (n components)
+  EXPR_MATVEC,          // dst = a * b, a a tensor and b a vector
+  EXPR_MATMAT,          // dst = a * b, both tensors
+  EXPR_POW,             // dst[0] = a[0] ^ b[0]
+  EXPR_GT,              // dst[0] = a[0] > b[0]
+  EXPR_LT,              // dst[0] = a[0] < b[0]
+  EXPR_EQ,              // dst[0] = a[0] == b[0]
+  EXPR_AND,             // dst[0] = a[0] && b[0]
+  EXPR_OR,              // dst[0] = a[0] || b[0]
+  EXPR_SELECT,          // dst[0:n] = a[0] ? b : c
+  EXPR_EXP,             // dst[0] = f(a[0]) ...
+  EXPR_SQRT,
+  EXPR_SIN,
+  EXPR_COS,
+  EXPR_ERF,
+  EXPR_NORM,            // dst[0] = |a| (n components)
+  EXPR_SET_COMP,        // dst[n] = a[0]
+  EXPR_GET_COMP,        // dst[0] = a[n]
+  EXPR_TO_SYMM,         // dst = the symmetric storage of tensor a
+};
+
+enum : Int {
+  EXPR_INSTR_WIDTH = 6,
+  EXPR_MAX_REGS = 32,
+  EXPR_MAX_INPUTS = 16
+};
+
+/* On host backends each kernel iteration runs the bytecode over a
+   block of entities, which amortizes the instruction dispatch and lets
+   the loops over the block vectorize. Device threads take one entity. */
+#if defined(OMEGA_H_USE_CUDA) || defined(OMEGA_H_USE_KOKKOS)
+constexpr LO expr_block = 1;
+#else
+constexpr LO expr_block = 32;
+#endif
+
+#define OMEGA_H_EXPR_LOOP(expr)                                                \
+  for (Int k = 0; k < n; ++k) {                                                \
+    for (LO q = 0; q < nq; ++q) expr;                                          \
+  }
+
+template <Int dim>
+struct ExprKernel {
+  Read<LO> code;
+  Reals constants;
+  Reals inputs[EXPR_MAX_INPUTS];
+  Write<Real> out;
+  LO size;
+  LO ninstrs;
+  Int result;
+  Int result_ncomps;
+  OMEGA_H_DEVICE void operator()(LO block) const {
+    auto const first = block * expr_block;
+    auto const nq = min2(expr_block, size - first);
+    /* register, component, entity within the block */
+    Real r[EXPR_MAX_REGS][dim * dim][expr_block];
+    for (LO pc = 0; pc < ninstrs; ++pc) {
+      auto const op = code[pc * EXPR_INSTR_WIDTH + 0];
+      auto const d = code[pc * EXPR_INSTR_WIDTH + 1];
+      auto const a = code[pc * EXPR_INSTR_WIDTH + 2];
+      auto const b = code[pc * EXPR_INSTR_WIDTH + 3];
+      auto const c = code[pc * EXPR_INSTR_WIDTH + 4];
+      auto const n = code[pc * EXPR_INSTR_WIDTH + 5];
+      switch (op) {
+        case EXPR_LOAD_CONST:
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = constants[a + k])
+          break;
+        case EXPR_LOAD_INPUT: {
+          auto const& in = inputs[a];
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = in[(first + q) * n + k])
+          break;
+        }
+        case EXPR_ZERO:
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = 0.0)
+          break;
+        case EXPR_ADD:
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = r[a][k][q] + r[b][k][q])
+          break;
+        case EXPR_SUB:
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = r[a][k][q] - r[b][k][q])
+          break;
+        case EXPR_NEG:
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = -r[a][k][q])
+          break;
+        case EXPR_SCALE:
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = r[a][k][q] * r[b][0][q])
+          break;
+        case EXPR_DIV:
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = r[a][k][q] / r[b][0][q])
+          break;
+        case EXPR_DIV_MAYBE_ZERO:
+          OMEGA_H_EXPR_LOOP(r[d][k][q] = (r[b][0][q] != 0.0)
+                                             ? (r[a][k][q] / r[b][0][q])
+                                             : 0.0)
+          break;
+        case EXPR_DOT:
+          for (LO q = 0; q < nq; ++q) {
+            Real sum = 0.0;
+            for (Int k = 0; k < n; ++k) sum += r[a][k][q] * r[b][k][q];
+            r[d][0][q] = sum;
+          }
+          break;
+        case EXPR_MATVEC:
+          /* tensors are stored by rows, as in get_matrix() */
+          for (Int i = 0; i < dim; ++i) {
+            for (LO q = 0; q < nq; ++q) {
+              Real sum = 0.0;
+              for (Int j = 0; j < dim; ++j) {
+                sum += r[a][i * dim + j][q] * r[b][j][q];
+              }
+              r[d][i][q] = sum;
+            }
+          }
+          break;
+        case EXPR_MATMAT:
+          for (Int i = 0; i < dim; ++i) {
+            for (Int j = 0; j < dim; ++j) {
+              for (LO q = 0; q < nq; ++q) {
+                Real sum = 0.0;
+                for (Int k = 0; k < dim; ++k) {
+                  sum += r[a][i * dim + k][q] * r[b][k * dim + j][q];
+                }
+                r[d][i * dim + j][q] = sum;
+              }
+            }
+          }
+          break;
+        case EXPR_POW:
+          for (LO q = 0; q < nq; ++q) {
+            r[d][0][q] = std::pow(r[a][0][q], r[b][0][q]);
+          }
+          break;
+        case EXPR_GT:
+          for (LO q = 0; q < nq; ++q) {
+            r[d][0][q] = (r[a][0][q] > r[b][0][q]) ? 1.0 : 0.0;
+          }
+          break;
+        case EXPR_LT:
+          for (LO q = 0; q < nq; ++q) {
+            r[d][0][q] = (r[a][0][q] < r[b][0][q]) ? 1.0 : 0.0;
+          }
+          break;
+        case EXPR_EQ:
+          for (LO q = 0; q < nq; ++q) {
+            r[d][0][q] = (r[a][0][q] == r[b][0][q]) ? 1.0 : 0.0;
+          }
+          break;
+        case EXPR_AND:
+          for (LO q = 0; q < nq; ++q) {
+            r[d][0][q] =
+                (r[a][0][q] != 0.0 && r[b][0][q] != 0.0) ? 1.0 : 0.0;
+          }
+          break;
+        case EXPR_OR:
+          for (LO q = 0; q < nq; ++q) {
+            r[d][0][q] =
+                (r[a][0][q] != 0.0 || r[b][0][q] != 0.0) ? 1.0 : 0.0;
+          }
+          break;
+        case EXPR_SELECT:
+          OMEGA_H_EXPR_LOOP(
+              r[d][k][q] = (r[a][0][q] != 0.0) ? r[b][k][q] : r[c][k][q])
+          break;
+        case EXPR_EXP:
+          for (LO q = 0; q < nq; ++q) r[d][0][q] = std::exp(r[a][0][q]);
+          break;
+        case EXPR_SQRT:
+          for (LO q = 0; q < nq; ++q) r[d][0][q] = std::sqrt(r[a][0][q]);
+          break;
+        case EXPR_SIN:
+          for (LO q = 0; q < nq; ++q) r[d][0][q] = std::sin(r[a][0][q]);
+          break;
+        case EXPR_COS:
+          for (LO q = 0; q < nq; ++q) r[d][0][q] = std::cos(r[a][0][q]);
+          break;
+        case EXPR_ERF:
+          for (LO q = 0; q < nq; ++q) r[d][0][q] = std::erf(r[a][0][q]);
+          break;
+        case EXPR_NORM:
+          for (LO q = 0; q < nq; ++q) {
+            Real sum = 0.0;
+            for (Int k = 0; k < n; ++k) sum += square(r[a][k][q]);
+            r[d][0][q] = std::sqrt(sum);
+          }
+          break;
+        case EXPR_SET_COMP:
+          for (LO q = 0; q < nq; ++q) r[d][n][q] = r[a][0][q];
+          break;
+        case EXPR_GET_COMP:
+          for (LO q = 0; q < nq; ++q) r[d][0][q] = r[a][n][q];
+          break;
+        case EXPR_TO_SYMM:
+          for (LO q = 0; q < nq; ++q) {
+            Tensor<dim> m;
+            for (Int i = 0; i < dim; ++i) {
+              for (Int j = 0; j < dim; ++j) m(i, j) = r[a][i * dim + j][q];
+            }
+            auto const v = symm2vector(m);
+            for (Int k = 0; k < symm_ncomps(dim); ++k) r[d][k][q] = v[k];
+          }
+          break;
+      }
+    }
+    for (LO q = 0; q < nq; ++q) {
+      for (Int k = 0; k < result_ncomps; ++k) {
+        out[(first + q) * result_ncomps + k] = r[result][k][q];
+      }
+    }
+  }
+};
+
+#undef OMEGA_H_EXPR_LOOP
+
+template <typename T>
+Read<T> to_device(std::vector<T> const& host) {
+  HostWrite<T> out(LO(host.size()));
+  for (LO i = 0; i < out.size(); ++i) out[i] = host[std::size_t(i)];
+  return out.write();
+}
+
+template <Int dim>
+Reals run_expr_kernel(LO size, std::vector<LO> const& code,
+    std::vector<Real> const& constants, std::vector<Reals> const& inputs,
+    Int result, Int result_ncomps) {
+  ExprKernel<dim> kernel;
+  kernel.code = to_device(code);
+  kernel.constants = to_device(constants);
+  for (std::size_t i = 0; i < inputs.size(); ++i) kernel.inputs[i] = inputs[i];
+  kernel.out = Write<Real>(size * result_ncomps);
+  kernel.size = size;
+  kernel.ninstrs = LO(code.size()) / EXPR_INSTR_WIDTH;
+  kernel.result = result;
+  kernel.result_ncomps = result_ncomps;
+  auto const nblocks = (size + expr_block - 1) / expr_block;
+  parallel_for(nblocks, kernel, "eval_expr_program");
+  return kernel.out;
+}
+
+}  // end anonymous namespace
+
+struct ExprCompiler {
+  struct Register {
+    ExprKind kind;
+    bool varying;
+    /* bound to a variable name, so it lives until the end */
+    bool pinned;
+    /* offset of its value in the constant pool, or -1 */
+    LO constant;
+  };
+  ExprEnv& env;
+  std::vector<Register> regs;
+  std::vector<int> free_regs;
+  std::vector<LO> code;
+  std::vector<Real> constants;
+  std::vector<Reals> inputs;
+  std::map<std::string, int> bound;
+  ExprCompiler(ExprEnv& env_in) : env(env_in) {}
+  Int ncomps(ExprKind kind) const {
+    switch (kind) {
+      case EXPR_VECTOR:
+        return env.dim;
+      case EXPR_TENSOR:
+        return square(env.dim);
+      case EXPR_SYMM:
+        return symm_ncomps(env.dim);
+      default:
+        return 1;
+    }
+  }
+  Int ncomps(int reg) const { return ncomps(regs[std::size_t(reg)].kind); }
+  ExprKind kind(int reg) const { return regs[std::size_t(reg)].kind; }
+  bool varying(int reg) const { return regs[std::size_t(reg)].varying; }
+  int allocate(ExprKind kind_in, bool varying_in) {
+    /* in 1D all the non-boolean kinds are single numbers,
+       and every operation on them reduces to its scalar form */
+    if (env.dim == 1 && kind_in != EXPR_BOOL) kind_in = EXPR_SCALAR;
+    int reg;
+    if (!free_regs.empty()) {
+      reg = free_regs.back();
+      free_regs.pop_back();
+    } else {
+      if (int(regs.size()) == EXPR_MAX_REGS) {
+        throw ParserFail("expression needs too many registers to be fused");
+      }
+      reg = int(regs.size());
+      regs.push_back(Register());
+    }
+    regs[std::size_t(reg)] = Register{kind_in, varying_in, false, -1};
+    return reg;
+  }
+  void release(int reg) {
+    if (reg < 0 || regs[std::size_t(reg)].pinned) return;
+    free_regs.push_back(reg);
+  }
+  void instruction(LO op, int d, int a, int b, int c, LO n) {
+    code.insert(code.end(), {op, d, a, b, c, n});
+  }
+  /* allocates the result before releasing the operands,
+     so it never aliases them */
+  int emit(LO op, ExprKind kind_in, int a, int b = -1, int c = -1, LO n = -1) {
+    bool varying_out = false;
+    for (auto operand : {a, b, c}) {
+      if (operand >= 0) varying_out = varying_out || varying(operand);
+    }
+    auto d = allocate(kind_in, varying_out);
+    if (n < 0) n = ncomps(d);
+    instruction(op, d, a, b, c, n);
+    release(a);
+    if (b != a) release(b);
+    if (c != a && c != b) release(c);
+    return d;
+  }
+  int load_constant(Real const* values, ExprKind kind_in) {
+    auto d = allocate(kind_in, false);
+    auto const offset = LO(constants.size());
+    constants.insert(constants.end(), values, values + ncomps(d));
+    regs[std::size_t(d)].constant = offset;
+    instruction(EXPR_LOAD_CONST, d, offset, -1, -1, ncomps(d));
+    return d;
+  }
+  int load_input(Reals array) {
+    ExprKind kind_in;
+    if (array.size() == env.size) {
+      kind_in = EXPR_SCALAR;
+    } else if (array.size() == env.size * env.dim) {
+      kind_in = EXPR_VECTOR;
+    } else if (array.size() == env.size * square(env.dim)) {
+      kind_in = EXPR_TENSOR;
+    } else {
+      throw ParserFail("array of unexpected size can't be fused");
+    }
+    if (int(inputs.size()) == EXPR_MAX_INPUTS) {
+      throw ParserFail("expression reads too many arrays to be fused");
+    }
+    auto d = allocate(kind_in, true);
+    instruction(EXPR_LOAD_INPUT, d, LO(inputs.size()), -1, -1, ncomps(d));
+    inputs.push_back(array);
+    return d;
+  }
+  template <Int dim>
+  int load_value(any const& value) {
+    if (value.type() == typeid(Real)) {
+      auto x = any_cast<Real>(value);
+      return load_constant(&x, EXPR_SCALAR);
+    } else if (value.type() == typeid(Vector<dim>)) {
+      auto x = any_cast<Vector<dim>>(value);
+      return load_constant(scalar_ptr(x), EXPR_VECTOR);
+    } else if (value.type() == typeid(Tensor<dim>)) {
+      auto x = matrix2vector(any_cast<Tensor<dim>>(value));
+      return load_constant(scalar_ptr(x), EXPR_TENSOR);
+    } else if (value.type() == typeid(Vector<symm_ncomps(dim)>)) {
+      auto x = any_cast<Vector<symm_ncomps(dim)>>(value);
+      return load_constant(scalar_ptr(x), EXPR_SYMM);
+    } else if (value.type() == typeid(bool)) {
+      Real x = any_cast<bool>(value) ? 1.0 : 0.0;
+      return load_constant(&x, EXPR_BOOL);
+    } else if (value.type() == typeid(Reals)) {
+      return load_input(any_cast<Reals>(value));
+    }
+    throw ParserFail("variable type can't be fused");
+  }
+  int variable(std::string const& name) {
+    auto bit = bound.find(name);
+    if (bit != bound.end()) return bit->second;
+    auto it = env.variables.find(name);
+    if (it == env.variables.end()) {
+      std::stringstream ss;
+      ss << "unknown variable name \"" << name << "\"\n";
+      throw ParserFail(ss.str());
+    }
+    int reg;
+    if (env.dim == 3) reg = load_value<3>(it->second);
+    else if (env.dim == 2) reg = load_value<2>(it->second);
+    else reg = load_value<1>(it->second);
+    bind(name, reg);
+    return reg;
+  }
+  void bind(std::string const& name, int reg) {
+    regs[std::size_t(reg)].pinned = true;
+    bound[name] = reg;
+  }
+  /* the value of a compile-time constant scalar, used for indices */
+  Real constant_scalar(int reg) const {
+    auto& r = regs[std::size_t(reg)];
+    if (r.kind != EXPR_SCALAR || r.constant < 0) {
+      throw ParserFail("expected a constant in fused expression");
+    }
+    return constants[std::size_t(r.constant)];
+  }
+  void expect(bool condition, char const* what) {
+    if (!condition) {
+      std::stringstream ss;
+      ss << "operand types of " << what << " can't be fused";
+      throw ParserFail(ss.str());
+    }
+  }
+  int add_sub(LO op, int a, int b) {
+    expect(kind(a) == kind(b) && kind(a) != EXPR_BOOL, "+ or -");
+    return emit(op, kind(a), a, b);
+  }
+  int mul(int a, int b) {
+    auto const ka = kind(a);
+    auto const kb = kind(b);
+    expect(ka != EXPR_BOOL && kb != EXPR_BOOL, "*");
+    if (kb == EXPR_SCALAR) return emit(EXPR_SCALE, ka, a, b);
+    if (ka == EXPR_SCALAR) return emit(EXPR_SCALE, kb, b, a);
+    if (ka == EXPR_VECTOR && kb == EXPR_VECTOR) {
+      return emit(EXPR_DOT, EXPR_SCALAR, a, b, -1, ncomps(a));
+    }
+    if (ka == EXPR_TENSOR && kb == EXPR_VECTOR) {
+      return emit(EXPR_MATVEC, EXPR_VECTOR, a, b);
+    }
+    if (ka == EXPR_TENSOR && kb == EXPR_TENSOR) {
+      return emit(EXPR_MATMAT, EXPR_TENSOR, a, b);
+    }
+    expect(false, "*");
+    return -1;
+  }
+  int div(int a, int b) {
+    expect(kind(a) != EXPR_BOOL && kind(b) == EXPR_SCALAR, "/");
+    /* ExprOp::eval divides arrays with divide_each_maybe_zero() */
+    auto const op = varying(b) ? EXPR_DIV_MAYBE_ZERO : EXPR_DIV;
+    return emit(op, kind(a), a, b);
+  }
+  int scalar_binary(LO op, ExprKind kind_out, int a, int b, char const* what) {
+    expect(kind(a) == EXPR_SCALAR && kind(b) == EXPR_SCALAR, what);
+    return emit(op, kind_out, a, b, -1, 1);
+  }
+  int bool_binary(LO op, int a, int b, char const* what) {
+    expect(kind(a) == EXPR_BOOL && kind(b) == EXPR_BOOL, what);
+    return emit(op, EXPR_BOOL, a, b, -1, 1);
+  }
+  int neg(int a) {
+    expect(kind(a) != EXPR_BOOL, "negation");
+    return emit(EXPR_NEG, kind(a), a);
+  }
+  int select(int cond, int a, int b) {
+    expect(kind(cond) == EXPR_BOOL, "?:");
+    expect(kind(a) == kind(b), "?:");
+    return emit(EXPR_SELECT, kind(a), cond, a, b);
+  }
+  int access(int var, std::vector<int> const& args) {
+    expect(!args.empty() && args.size() <= 2, "the access operator");
+    auto const i = Int(constant_scalar(args[0]));
+    auto const j = (args.size() > 1) ? Int(constant_scalar(args[1])) : Int(0);
+    for (auto arg : args) release(arg);
+    Int comp;
+    if (kind(var) == EXPR_VECTOR) {
+      comp = i;
+    } else if (kind(var) == EXPR_TENSOR) {
+      comp = i * env.dim + j;
+    } else {
+      expect(env.dim == 1 && kind(var) == EXPR_SCALAR, "the access operator");
+      comp = 0;
+    }
+    expect(0 <= comp && comp < ncomps(var), "the access operator");
+    return emit(EXPR_GET_COMP, EXPR_SCALAR, var, -1, -1, comp);
+  }
+  int call(std::string const& name, std::vector<int> const& args) {
+    if (!env.builtin_functions.count(name)) {
+      std::stringstream ss;
+      ss << "function \"" << name << "\" can't be fused";
+      throw ParserFail(ss.str());
+    }
+    static std::map<std::string, LO> const unary = {{"exp", EXPR_EXP},
+        {"sqrt", EXPR_SQRT}, {"sin", EXPR_SIN}, {"cos", EXPR_COS},
+        {"erf", EXPR_ERF}};
+    auto uit = unary.find(name);
+    if (uit != unary.end()) {
+      expect(args.size() == 1 && kind(args[0]) == EXPR_SCALAR, name.c_str());
+      return emit(uit->second, EXPR_SCALAR, args[0]);
+    }
+    if (name == "norm") {
+      expect(args.size() == 1 && (kind(args[0]) == EXPR_VECTOR ||
+                                     (env.dim == 1 && kind(args[0]) == EXPR_SCALAR)),
+          "norm()");
+      return emit(EXPR_NORM, EXPR_SCALAR, args[0], -1, -1, ncomps(args[0]));
+    }
+    if (name == "vector") {
+      expect(!args.empty() && args.size() <= std::size_t(env.dim), "vector()");
+      std::vector<int> comps(args);
+      while (comps.size() < std::size_t(env.dim)) comps.push_back(args.back());
+      return assemble(EXPR_VECTOR, comps);
+    }
+    if (name == "matrix" || name == "tensor") {
+      if (env.dim > 1 && args.size() == 1 && constant_scalar(args[0]) == 0.0) {
+        release(args[0]);
+        return emit(EXPR_ZERO, EXPR_TENSOR, -1);
+      }
+      expect(args.size() == std::size_t(square(env.dim)), "matrix()");
+      /* like interleave(), argument k becomes stored component k */
+      return assemble(EXPR_TENSOR, args);
+    }
+    if (name == "symm") {
+      expect(args.size() == 1 && (kind(args[0]) == EXPR_TENSOR ||
+                                     (env.dim == 1 && kind(args[0]) == EXPR_SCALAR)),
+          "symm()");
+      return emit(EXPR_TO_SYMM, EXPR_SYMM, args[0]);
+    }
+    std::stringstream ss;
+    ss << "function \"" << name << "\" can't be fused";
+    throw ParserFail(ss.str());
+  }
+  int assemble(ExprKind kind_out, std::vector<int> const& comps) {
+    bool varying_out = false;
+    for (auto comp : comps) {
+      expect(kind(comp) == EXPR_SCALAR, "vector() or matrix()");
+      varying_out = varying_out || varying(comp);
+    }
+    auto d = allocate(kind_out, varying_out);
+    instruction(EXPR_ZERO, d, -1, -1, -1, ncomps(d));
+    for (std::size_t k = 0; k < comps.size(); ++k) {
+      instruction(EXPR_SET_COMP, d, comps[k], -1, -1, LO(k));
+    }
+    for (std::size_t k = 0; k < comps.size(); ++k) {
+      if (std::find(comps.begin(), comps.begin() + k, comps[k]) ==
+          comps.begin() + k) {
+        release(comps[k]);
+      }
+    }
+    return d;
+  }
+  Reals run(int result) {
+    auto const result_ncomps = ncomps(result);
+    if (env.dim == 3) {
+      return run_expr_kernel<3>(
+          env.size, code, constants, inputs, result, result_ncomps);
+    }
+    if (env.dim == 2) {
+      return run_expr_kernel<2>(
+          env.size, code, constants, inputs, result, result_ncomps);
+    }
+    return run_expr_kernel<1>(
+        env.size, code, constants, inputs, result, result_ncomps);
+  }
+};
+
+int ExprOp::compile(ExprCompiler&) {
+  throw ParserFail("expression operation can't be fused");
+}
+
+ExprProgram::ExprProgram(OpPtr op_in) : op(op_in), fused(false) {}
+
+any ExprProgram::eval(ExprEnv& env) {
+  OMEGA_H_TIME_FUNCTION;
+  fused = false;
+  if (env.size > 0 && env.dim >= 1 && env.dim <= 3) {
+    ExprCompiler compiler(env);
+    int result = -1;
+    try {
+      result = op->compile(compiler);
+    } catch (ParserFail const&) {
+      result = -1;
+    }
+    if (result >= 0 && compiler.varying(result) &&
+        compiler.kind(result) != EXPR_BOOL) {
+      fused = true;
+      return compiler.run(result);
+    }
+  }
+  return op->eval(env);
+}
+
 ExprOp::~ExprOp() {}
 
 struct ConstOp final : public ExprOp {
@@ -864,8 +1450,13 @@ struct ConstOp final : public ExprOp {
   virtual ~ConstOp() override = default;
   ConstOp(double value_in) : value(value_in) {}
   virtual any eval(ExprEnv& env) override ;
+  virtual int compile(ExprCompiler& compiler) override;
 };
 any ConstOp::eval(ExprEnv&) { return value; }
+int ConstOp::compile(ExprCompiler& compiler) {
+  Real const x = value;
+  return compiler.load_constant(&x, EXPR_SCALAR);
+}
 
 struct SemicolonOp final : public ExprOp {
   OpPtr lhs;
@@ -873,11 +1464,16 @@ struct SemicolonOp final : public ExprOp {
   virtual ~SemicolonOp() override = default;
   SemicolonOp(OpPtr lhs_in, OpPtr rhs_in) : lhs(lhs_in), rhs(rhs_in) {}
   virtual any eval(ExprEnv& env) override;
+  virtual int compile(ExprCompiler& compiler) override;
 };
 any SemicolonOp::eval(ExprEnv& env) {
   lhs->eval(env);  // LHS result ignored
   return rhs->eval(env);
 }
+int SemicolonOp::compile(ExprCompiler& compiler) {
+  compiler.release(lhs->compile(compiler));  // LHS result ignored
+  return rhs->compile(compiler);
+}
 
 struct AssignOp final : public ExprOp {
   std::string name;
@@ -886,18 +1482,26 @@ struct AssignOp final : public ExprOp {
   AssignOp(std::string const& name_in, OpPtr rhs_in)
       : name(name_in), rhs(rhs_in) {}
   virtual any eval(ExprEnv& env) override;
+  virtual int compile(ExprCompiler& compiler) override;
 };
 any AssignOp::eval(ExprEnv& env) {
   env.variables[name] = rhs->eval(env);
   return any();
 }
+int AssignOp::compile(ExprCompiler& compiler) {
+  auto const reg = rhs->compile(compiler);
+  compiler.bind(name, reg);
+  return reg;
+}
 
 struct VarOp final : public ExprOp {
   std::string name;
   virtual ~VarOp() override = default;
   VarOp(std::string const& name_in) : name(name_in) {}
   virtual any eval(ExprEnv& env) override;
+  virtual int compile(ExprCompiler& compiler) override;
 };
+int VarOp::compile(ExprCompiler& compiler) { return compiler.variable(name); }
 any VarOp::eval(ExprEnv& env) {
   auto it = env.variables.find(name);
   if (it == env.variables.end()) {
@@ -913,8 +1517,12 @@ struct NegOp final : public ExprOp {
   virtual ~NegOp() override = default;
   NegOp(OpPtr rhs_in) : rhs(rhs_in) {}
   virtual any eval(ExprEnv& env) override;
+  virtual int compile(ExprCompiler& compiler) override;
 };
 any NegOp::eval(ExprEnv& env) { return neg(env.dim, rhs->eval(env)); }
+int NegOp::compile(ExprCompiler& compiler) {
+  return compiler.neg(rhs->compile(compiler));
+}
 
 struct TernaryOp final : public ExprOp {
   OpPtr cond;
@@ -924,7 +1532,14 @@ struct TernaryOp final : public ExprOp {
   TernaryOp(OpPtr cond_in, OpPtr lhs_in, OpPtr rhs_in)
       : cond(cond_in), lhs(lhs_in), rhs(rhs_in) {}
   virtual any eval(ExprEnv& env) override;
+  virtual int compile(ExprCompiler& compiler) override;
 };
+int TernaryOp::compile(ExprCompiler& compiler) {
+  auto const cond_reg = cond->compile(compiler);
+  auto const lhs_reg = lhs->compile(compiler);
+  auto const rhs_reg = rhs->compile(compiler);
+  return compiler.select(cond_reg, lhs_reg, rhs_reg);
+}
 any TernaryOp::eval(ExprEnv& env) {
   auto lhs_val = lhs->eval(env);
   auto rhs_val = rhs->eval(env);
@@ -946,7 +1561,17 @@ struct CallOp final : public ExprOp {
     args.reserve(rhs.size());
   }
   virtual any eval(ExprEnv& env) override;
+  virtual int compile(ExprCompiler& compiler) override;
 };
+int CallOp::compile(ExprCompiler& compiler) {
+  std::vector<int> arg_regs;
+  for (auto& arg : rhs) arg_regs.push_back(arg->compile(compiler));
+  if (compiler.bound.count(name) || compiler.env.variables.count(name)) {
+    /* access operator for vector/matrix */
+    return compiler.access(compiler.variable(name), arg_regs);
+  }
+  return compiler.call(name, arg_regs);
+}
 any CallOp::eval(ExprEnv& env) {
   args.resize(rhs.size());
   for (std::size_t i = 0; i < rhs.size(); ++i) {
@@ -973,31 +1598,46 @@ any CallOp::eval(ExprEnv& env) {
   }
 }
 
-#define OMEGA_H_BINARY_OP(ClassName, func_call)                                \
+#define OMEGA_H_BINARY_OP(ClassName, func_call, compile_call)                  \
   struct ClassName final : public ExprOp {                                     \
     OpPtr lhs;                                                                 \
     OpPtr rhs;                                                                 \
     virtual ~ClassName() override = default;                             \
     ClassName(OpPtr lhs_in, OpPtr rhs_in) : lhs(lhs_in), rhs(rhs_in) {}        \
     virtual any eval(ExprEnv& env) override;                             \
+    virtual int compile(ExprCompiler& compiler) override;                      \
   };                                                                           \
   any ClassName::eval(ExprEnv& env) {                                          \
     auto lhs_val = lhs->eval(env);                                             \
     auto rhs_val = rhs->eval(env);                                             \
     promote(env.size, env.dim, lhs_val, rhs_val);                              \
     return func_call;                                                          \
+  }                                                                            \
+  int ClassName::compile(ExprCompiler& compiler) {                             \
+    auto const a = lhs->compile(compiler);                                     \
+    auto const b = rhs->compile(compiler);                                     \
+    return compile_call;                                                       \
   }
 
-OMEGA_H_BINARY_OP(OrOp, eval_or(lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(AndOp, eval_and(lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(GtOp, gt(lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(LtOp, lt(lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(EqOp, eq(lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(AddOp, add(env.dim, lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(SubOp, sub(env.dim, lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(MulOp, mul(env.size, env.dim, lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(DivOp, div(env.dim, lhs_val, rhs_val));
-OMEGA_H_BINARY_OP(PowOp, eval_pow(env.dim, lhs_val, rhs_val));
+OMEGA_H_BINARY_OP(OrOp, eval_or(lhs_val, rhs_val),
+    compiler.bool_binary(EXPR_OR, a, b, "||"));
+OMEGA_H_BINARY_OP(AndOp, eval_and(lhs_val, rhs_val),
+    compiler.bool_binary(EXPR_AND, a, b, "&&"));
+OMEGA_H_BINARY_OP(GtOp, gt(lhs_val, rhs_val),
+    compiler.scalar_binary(EXPR_GT, EXPR_BOOL, a, b, ">"));
+OMEGA_H_BINARY_OP(LtOp, lt(lhs_val, rhs_val),
+    compiler.scalar_binary(EXPR_LT, EXPR_BOOL, a, b, "<"));
+OMEGA_H_BINARY_OP(EqOp, eq(lhs_val, rhs_val),
+    compiler.scalar_binary(EXPR_EQ, EXPR_BOOL, a, b, "=="));
+OMEGA_H_BINARY_OP(AddOp, add(env.dim, lhs_val, rhs_val),
+    compiler.add_sub(EXPR_ADD, a, b));
+OMEGA_H_BINARY_OP(SubOp, sub(env.dim, lhs_val, rhs_val),
+    compiler.add_sub(EXPR_SUB, a, b));
+OMEGA_H_BINARY_OP(MulOp, mul(env.size, env.dim, lhs_val, rhs_val),
+    compiler.mul(a, b));
+OMEGA_H_BINARY_OP(DivOp, div(env.dim, lhs_val, rhs_val), compiler.div(a, b));
+OMEGA_H_BINARY_OP(PowOp, eval_pow(env.dim, lhs_val, rhs_val),
+    compiler.scalar_binary(EXPR_POW, EXPR_SCALAR, a, b, "^"));
 
 #undef OMEGA_H_BINARY_OP
 
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <map>
+#include <set>
 #include <vector>
 
 #include <Omega_h_any.hpp>
@@ -22,18 +23,46 @@ struct ExprEnv {
   void repeat(any& x);
   std::map<std::string, any> variables;
   std::map<std::string, Function> functions;
+  /* functions registered by the constructor and not since replaced,
+     only these can be compiled by ExprProgram */
+  std::set<std::string> builtin_functions;
   LO size;
   Int dim;
   std::string string(int verbose=0);
 };
 
+struct ExprCompiler;
+
 struct ExprOp {
   virtual ~ExprOp();
   virtual any eval(ExprEnv& env) = 0;
+  /* emits the bytecode computing this operation and returns the
+     register holding its result; throws ParserFail if it can't */
+  virtual int compile(ExprCompiler& compiler);
 };
 
 using OpPtr = std::shared_ptr<ExprOp>;
 
+/* Evaluates an ExprOp tree over arrays in one fused parallel_for.
+   The tree is lowered into a flat register bytecode in which each
+   register holds the scalar, vector, tensor or symmetric tensor value
+   of one entity, so none of the intermediate arrays that ExprOp::eval
+   creates are materialized.
+   Expressions the bytecode can't represent (user-registered functions,
+   results that don't vary per entity or are booleans) fall back to
+   ExprOp::eval. Unlike ExprOp::eval, assignments inside the expression
+   are not stored back into the ExprEnv. */
+class ExprProgram {
+ public:
+  explicit ExprProgram(OpPtr op_in);
+  any eval(ExprEnv& env);
+  bool was_fused() const { return fused; }
+
+ private:
+  OpPtr op;
+  bool fused;
+};
+
 class ExprOpsReader final : public Reader {
  public:
   ExprOpsReader();
@@ -2,11 +2,30 @@
 
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <algorithm>
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <type_traits>
+#include <vector>
+
+/* arrays read from .osh files can alias the mapped file only when
+   they live in host memory managed by SharedAlloc */
+#if (defined(__unix__) || defined(__APPLE__)) &&                               \
+    !defined(OMEGA_H_USE_KOKKOS) && !defined(OMEGA_H_USE_CUDA)
+#define OMEGA_H_MAP_OSH
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #ifdef OMEGA_H_USE_ZLIB
 #include <zlib.h>
@@ -34,6 +53,93 @@ static_assert(sizeof(LO) == 4, "osh format assumes 32 bit LO");
 static_assert(sizeof(GO) == 8, "osh format assumes 64 bit GO");
 static_assert(sizeof(Real) == 8, "osh format assumes 64 bit Real");
 
+/* since version 11, the data of an uncompressed array starts at an
+   offset from the beginning of the stream that is a multiple of
+   osh_alignment, preceded by the I8 number of padding bytes */
+constexpr std::streamoff osh_alignment = 8;
+
+void write_padding(std::ostream& stream) {
+  auto const pos = std::streamoff(stream.tellp());
+  I8 npad = 0;
+  if (pos >= 0) {
+    npad = I8((osh_alignment - (pos + 1) % osh_alignment) % osh_alignment);
+  }
+  stream.put(char(npad));
+  for (I8 i = 0; i < npad; ++i) stream.put('\0');
+}
+
+void read_padding(std::istream& stream) {
+  I8 npad;
+  stream.read(reinterpret_cast<char*>(&npad), sizeof(npad));
+  OMEGA_H_CHECK(0 <= npad && npad < osh_alignment);
+  stream.ignore(npad);
+}
+
+#ifdef OMEGA_H_MAP_OSH
+struct MappedFile {
+  char* data;
+  std::size_t size;
+  MappedFile(char* data_in, std::size_t size_in)
+      : data(data_in), size(size_in) {}
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+  ~MappedFile() { ::munmap(data, size); }
+};
+
+/* returns nullptr when the file can't be mapped, and the caller
+   should fall back to reading it through a stream */
+std::shared_ptr<MappedFile> map_file(filesystem::path const& filepath) {
+  int fd = ::open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) return nullptr;
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+    ::close(fd);
+    return nullptr;
+  }
+  auto const size = std::size_t(st.st_size);
+  /* private and writable, so that a stray write into an aliased
+     array copies the page instead of faulting or changing the file */
+  void* data =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) return nullptr;
+  return std::make_shared<MappedFile>(static_cast<char*>(data), size);
+}
+
+/* lets the stream-based reader parse a mapped file,
+   while read_array() takes uncompressed arrays in place */
+class MappedBuf : public std::streambuf {
+ public:
+  explicit MappedBuf(std::shared_ptr<MappedFile> file_in) : file(file_in) {
+    setg(file->data, file->data, file->data + file->size);
+  }
+  /* just the bytes [offset, offset + size) of the file */
+  MappedBuf(std::shared_ptr<MappedFile> file_in, std::size_t offset,
+      std::size_t size)
+      : file(file_in) {
+    OMEGA_H_CHECK(offset + size <= file->size);
+    setg(file->data + offset, file->data + offset, file->data + offset + size);
+  }
+  char* position() const { return gptr(); }
+  std::size_t remaining() const { return std::size_t(egptr() - gptr()); }
+  void advance(std::size_t n) { setg(eback(), gptr() + n, egptr()); }
+  std::shared_ptr<MappedFile> file;
+};
+
+template <typename T>
+bool alias_mapped(std::istream& stream, LO size, Read<T>& array) {
+  auto buf = dynamic_cast<MappedBuf*>(stream.rdbuf());
+  if (buf == nullptr) return false;
+  auto const bytes = static_cast<std::size_t>(size) * sizeof(T);
+  auto const ptr = buf->position();
+  if (reinterpret_cast<std::uintptr_t>(ptr) % alignof(T) != 0) return false;
+  if (buf->remaining() < bytes) return false;
+  array = Write<T>(size, reinterpret_cast<T*>(ptr), buf->file);
+  buf->advance(bytes);
+  return true;
+}
+#endif
+
 OMEGA_H_INLINE std::uint32_t bswap32(std::uint32_t a) {
 #if defined(__GNUC__) && !defined(__CUDA_ARCH__)
   a = __builtin_bswap32(a);
@@ -87,6 +193,245 @@ struct SwapBytes<T, 8> {
 
 unsigned char const magic[2] = {0xa1, 0x1a};
 
+#ifdef OMEGA_H_USE_ZLIB
+
+/* since version 12, compressed arrays are split into chunks of
+   osh_chunk_bytes which are filtered and deflated independently,
+   and the compressed size of each chunk is stored up front so that
+   chunks can be located without decompressing the ones before them */
+constexpr std::size_t osh_chunk_bytes = std::size_t(1) << 20;
+
+enum : I8 {
+  FILTER_NONE = 0,
+  /* byte b of element i goes to position (b * n + i) of the chunk */
+  FILTER_SHUFFLE = 1,
+  /* integers are replaced by their difference from the previous
+     element of the chunk before shuffling */
+  FILTER_DELTA_SHUFFLE = 2,
+};
+
+template <typename T>
+I8 default_filter() {
+  if (sizeof(T) == 1) return FILTER_NONE;
+  if (std::is_integral<T>::value) return FILTER_DELTA_SHUFFLE;
+  return FILTER_SHUFFLE;
+}
+
+template <typename T>
+void delta_encode(T* a, LO n, std::true_type) {
+  using U = typename std::make_unsigned<T>::type;
+  for (LO i = n - 1; i > 0; --i) a[i] = T(U(a[i]) - U(a[i - 1]));
+}
+
+template <typename T>
+void delta_encode(T*, LO, std::false_type) {
+  OMEGA_H_NORETURN();
+}
+
+template <typename T>
+void delta_decode(T* a, LO n, std::true_type) {
+  using U = typename std::make_unsigned<T>::type;
+  for (LO i = 1; i < n; ++i) a[i] = T(U(a[i]) + U(a[i - 1]));
+}
+
+template <typename T>
+void delta_decode(T*, LO, std::false_type) {
+  OMEGA_H_NORETURN();
+}
+
+void shuffle(
+    char const* in, char* out, std::size_t n, std::size_t width) {
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t b = 0; b < width; ++b) out[b * n + i] = in[i * width + b];
+  }
+}
+
+void unshuffle(
+    char const* in, char* out, std::size_t n, std::size_t width) {
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t b = 0; b < width; ++b) out[i * width + b] = in[b * n + i];
+  }
+}
+
+/* turns n native values into the bytes that get deflated */
+template <typename T>
+void encode_chunk(T const* in, LO n, I8 filter, bool needs_swapping,
+    std::vector<T>& tmp, std::vector<char>& out) {
+  tmp.assign(in, in + n);
+  if (filter == FILTER_DELTA_SHUFFLE) {
+    delta_encode(tmp.data(), n, std::is_integral<T>());
+  }
+  if (needs_swapping) {
+    for (auto& val : tmp) SwapBytes<T>::swap(&val);
+  }
+  auto const bytes = std::size_t(n) * sizeof(T);
+  out.resize(bytes);
+  if (filter == FILTER_NONE) {
+    std::memcpy(out.data(), tmp.data(), bytes);
+  } else {
+    shuffle(reinterpret_cast<char const*>(tmp.data()), out.data(),
+        std::size_t(n), sizeof(T));
+  }
+}
+
+/* the inverse of encode_chunk, from inflated bytes to native values */
+template <typename T>
+void decode_chunk(std::vector<char> const& in, LO n, I8 filter,
+    bool needs_swapping, T* out) {
+  auto const bytes = std::size_t(n) * sizeof(T);
+  OMEGA_H_CHECK(in.size() == bytes);
+  if (filter == FILTER_NONE) {
+    std::memcpy(out, in.data(), bytes);
+  } else {
+    unshuffle(
+        in.data(), reinterpret_cast<char*>(out), std::size_t(n), sizeof(T));
+  }
+  if (needs_swapping) {
+    for (LO i = 0; i < n; ++i) SwapBytes<T>::swap(&out[i]);
+  }
+  if (filter == FILTER_DELTA_SHUFFLE) {
+    delta_decode(out, n, std::is_integral<T>());
+  }
+}
+
+template <typename T>
+void write_chunked_array(std::ostream& stream, T const* data, LO size,
+    bool needs_swapping, bool use_filter) {
+  I8 const filter = use_filter ? default_filter<T>() : I8(FILTER_NONE);
+  LO const chunk_size = LO(osh_chunk_bytes / sizeof(T));
+  LO const nchunks = (size + chunk_size - 1) / chunk_size;
+  write_value(stream, filter, needs_swapping);
+  write_value(stream, chunk_size, needs_swapping);
+  auto const nchunks_size = std::size_t(nchunks);
+  std::vector<std::vector< ::Bytef>> compressed(nchunks_size);
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<T> tmp;
+    std::vector<char> filtered;
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (LO c = 0; c < nchunks; ++c) {
+      LO const begin = c * chunk_size;
+      LO const n = std::min(chunk_size, size - begin);
+      encode_chunk(data + begin, n, filter, needs_swapping, tmp, filtered);
+      auto const source_bytes = uLong(filtered.size());
+      auto dest_bytes = ::compressBound(source_bytes);
+      auto& dest = compressed[std::size_t(c)];
+      dest.resize(dest_bytes);
+      int ret = ::compress2(dest.data(), &dest_bytes,
+          reinterpret_cast<::Bytef const*>(filtered.data()), source_bytes,
+          Z_BEST_SPEED);
+      OMEGA_H_CHECK(ret == Z_OK);
+      dest.resize(dest_bytes);
+    }
+  }
+  for (auto const& chunk : compressed) {
+    write_value(stream, I64(chunk.size()), needs_swapping);
+  }
+  for (auto const& chunk : compressed) {
+    stream.write(reinterpret_cast<char const*>(chunk.data()),
+        std::streamsize(chunk.size()));
+  }
+}
+
+template <typename T>
+void read_chunked_array(
+    std::istream& stream, HostWrite<T> host, bool needs_swapping) {
+  LO const size = host.size();
+  I8 filter;
+  read_value(stream, filter, needs_swapping);
+  OMEGA_H_CHECK(FILTER_NONE <= filter && filter <= FILTER_DELTA_SHUFFLE);
+  OMEGA_H_CHECK(filter != FILTER_DELTA_SHUFFLE || std::is_integral<T>::value);
+  LO chunk_size;
+  read_value(stream, chunk_size, needs_swapping);
+  OMEGA_H_CHECK(chunk_size > 0);
+  LO const nchunks = (size + chunk_size - 1) / chunk_size;
+  std::vector<std::size_t> offsets(std::size_t(nchunks) + 1, 0);
+  for (LO c = 0; c < nchunks; ++c) {
+    I64 compressed_bytes;
+    read_value(stream, compressed_bytes, needs_swapping);
+    OMEGA_H_CHECK(compressed_bytes >= 0);
+    offsets[std::size_t(c) + 1] =
+        offsets[std::size_t(c)] + std::size_t(compressed_bytes);
+  }
+  std::vector< ::Bytef> compressed(offsets.back());
+  stream.read(reinterpret_cast<char*>(compressed.data()),
+      std::streamsize(compressed.size()));
+  OMEGA_H_CHECK(bool(stream));
+  T* data = nonnull(host.data());
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<char> filtered;
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (LO c = 0; c < nchunks; ++c) {
+      LO const begin = c * chunk_size;
+      LO const n = std::min(chunk_size, size - begin);
+      filtered.resize(std::size_t(n) * sizeof(T));
+      auto dest_bytes = uLong(filtered.size());
+      auto const source = compressed.data() + offsets[std::size_t(c)];
+      auto const source_bytes =
+          uLong(offsets[std::size_t(c) + 1] - offsets[std::size_t(c)]);
+      int ret = ::uncompress(reinterpret_cast<::Bytef*>(filtered.data()),
+          &dest_bytes, source, source_bytes);
+      OMEGA_H_CHECK(ret == Z_OK);
+      OMEGA_H_CHECK(dest_bytes == uLong(filtered.size()));
+      decode_chunk(filtered, n, filter, needs_swapping, data + begin);
+    }
+  }
+}
+
+#endif
+
+/* stands in for the stream that binary::write() sends a part to.
+   arrays that would be compressed are copied and set aside instead,
+   and finish() compresses them into place. finish() only touches
+   those copies, so it can run on another thread while the mesh
+   keeps changing. */
+class PartSnapshot : public std::ostream {
+ public:
+  PartSnapshot() : std::ostream(&buf_) {}
+#ifdef OMEGA_H_USE_ZLIB
+  template <typename T>
+  void defer(HostRead<T> host, bool needs_swapping, bool use_filter) {
+    auto const copy = std::make_shared<std::vector<T>>(
+        host.data(), host.data() + host.size());
+    auto const pos = std::size_t(tellp());
+    deferred_.emplace_back(pos, [=](std::ostream& stream) {
+      write_chunked_array(stream, copy->data(), LO(copy->size()),
+          needs_swapping, use_filter);
+    });
+  }
+#endif
+  std::string finish() {
+    auto const literal = buf_.str();
+    if (deferred_.empty()) return literal;
+    std::ostringstream stream;
+    std::size_t done = 0;
+    for (auto const& deferred : deferred_) {
+      stream.write(literal.data() + done,
+          std::streamsize(deferred.first - done));
+      deferred.second(stream);
+      done = deferred.first;
+    }
+    stream.write(
+        literal.data() + done, std::streamsize(literal.size() - done));
+    deferred_.clear();
+    return stream.str();
+  }
+
+ private:
+  std::stringbuf buf_;
+  std::vector<std::pair<std::size_t, std::function<void(std::ostream&)>>>
+      deferred_;
+};
+
 }  // end anonymous namespace
 
 template <typename T>
@@ -117,47 +462,55 @@ void read_value(std::istream& stream, T& val, bool needs_swapping) {
 
 template <typename T>
 void write_array(std::ostream& stream, Read<T> array, bool is_compressed,
-    bool needs_swapping) {
+    bool needs_swapping, bool use_filter) {
   if( !array.exists() ) return;
   LO size = array.size();
   write_value(stream, size, needs_swapping);
-  Read<T> swapped = swap_bytes(array, needs_swapping);
-  HostRead<T> uncompressed(swapped);
-  I64 uncompressed_bytes =
-      static_cast<I64>(static_cast<std::size_t>(size) * sizeof(T));
 #ifdef OMEGA_H_USE_ZLIB
   if (is_compressed) {
-    uLong source_bytes = static_cast<uLong>(uncompressed_bytes);
-    uLong dest_bytes = ::compressBound(source_bytes);
-    auto compressed = new ::Bytef[dest_bytes];
-    int ret = ::compress2(compressed, &dest_bytes,
-        reinterpret_cast<const ::Bytef*>(nonnull(uncompressed.data())),
-        source_bytes, Z_BEST_SPEED);
-    OMEGA_H_CHECK(ret == Z_OK);
-    I64 compressed_bytes = static_cast<I64>(dest_bytes);
-    write_value(stream, compressed_bytes, needs_swapping);
-    stream.write(reinterpret_cast<const char*>(compressed), compressed_bytes);
-    delete[] compressed;
-  } else
+    HostRead<T> host(array);
+    if (auto snapshot = dynamic_cast<PartSnapshot*>(&stream)) {
+      snapshot->defer(host, needs_swapping, use_filter);
+    } else {
+      write_chunked_array(stream, nonnull(host.data()), size, needs_swapping,
+          use_filter);
+    }
+    return;
+  }
 #else
   OMEGA_H_CHECK(is_compressed == false);
+  (void)use_filter;
 #endif
-  {
-    stream.write(reinterpret_cast<const char*>(nonnull(uncompressed.data())),
-        uncompressed_bytes);
-  }
+  Read<T> swapped = swap_bytes(array, needs_swapping);
+  HostRead<T> uncompressed(swapped);
+  I64 uncompressed_bytes =
+      static_cast<I64>(static_cast<std::size_t>(size) * sizeof(T));
+  write_padding(stream);
+  stream.write(reinterpret_cast<const char*>(nonnull(uncompressed.data())),
+      uncompressed_bytes);
 }
 
 template <typename T>
 void read_array(std::istream& stream, Read<T>& array, bool is_compressed,
-    bool needs_swapping) {
+    bool needs_swapping, I32 version) {
   LO size;
   read_value(stream, size, needs_swapping);
   OMEGA_H_CHECK(size >= 0);
   I64 uncompressed_bytes =
       static_cast<I64>(static_cast<std::size_t>(size) * sizeof(T));
+  if (!is_compressed && version >= 11) {
+    read_padding(stream);
+#ifdef OMEGA_H_MAP_OSH
+    if (!needs_swapping && alias_mapped(stream, size, array)) return;
+#endif
+  }
   HostWrite<T> uncompressed(size);
 #ifdef OMEGA_H_USE_ZLIB
+  if (is_compressed && version >= 12) {
+    read_chunked_array(stream, uncompressed, needs_swapping);
+    array = uncompressed.write();
+    return;
+  }
   if (is_compressed) {
     I64 compressed_bytes;
     read_value(stream, compressed_bytes, needs_swapping);
@@ -329,14 +682,14 @@ static void read_tag(std::istream& stream, Mesh* mesh, Int d,
     I32 n_class_ids;
     read_value(stream, n_class_ids, needs_swapping);
     if (n_class_ids > 0) {
-      read_array(stream, class_ids, is_compressed, needs_swapping);
+      read_array(stream, class_ids, is_compressed, needs_swapping, version);
     }
   }
 
   auto f = [&](auto t) {
     using T = decltype(t);
     Read<T> array;
-    read_array(stream, array, is_compressed, needs_swapping);
+    read_array(stream, array, is_compressed, needs_swapping, version);
     if(is_rc_tag(name)) {
       mesh->set_rc_from_mesh_array(d,ncomps,class_ids,name,array);
     }
@@ -379,13 +732,91 @@ static void read_sets(std::istream& stream, Mesh* mesh, bool needs_swapping) {
   }
 }
 
-void write(std::ostream& stream, Mesh* mesh) {
+/* an order-sensitive checksum of the stored downward connectivity,
+   which tells read_adjs() whether the stored derived adjacencies
+   still belong to the entities they are read with */
+static std::uint64_t down_checksum(Mesh* mesh) {
+  std::uint64_t h = 14695981039346656037ULL;
+  auto mix = [&](std::uint64_t x) { h = (h ^ x) * 1099511628211ULL; };
+  for (Int d = 1; d <= mesh->dim(); ++d) {
+    auto down = mesh->ask_down(d, d - 1);
+    HostRead<LO> ab2b(down.ab2b);
+    mix(std::uint64_t(ab2b.size()));
+    for (LO i = 0; i < ab2b.size(); ++i) mix(std::uint32_t(ab2b[i]));
+    if (d > 1) {
+      HostRead<I8> codes(down.codes);
+      for (LO i = 0; i < codes.size(); ++i) mix(std::uint8_t(codes[i]));
+    }
+  }
+  return h;
+}
+
+/* since version 13: the number of stored adjacencies and, if any,
+   the checksum of the downward connectivity followed by each
+   adjacency as its dimensions and arrays */
+static void write_adjs(std::ostream& stream, Mesh* mesh, bool save_adjs,
+    bool is_compressed, bool needs_swapping) {
+  std::vector<std::pair<Int, Int>> saved;
+  if (save_adjs) {
+    for (Int from = 0; from <= mesh->dim(); ++from) {
+      for (Int to = from; to <= mesh->dim(); ++to) {
+        if (mesh->has_adj(from, to)) saved.emplace_back(from, to);
+      }
+    }
+  }
+  I32 nadjs = I32(saved.size());
+  write_value(stream, nadjs, needs_swapping);
+  if (nadjs == 0) return;
+  write_value(stream, I64(down_checksum(mesh)), needs_swapping);
+  for (auto const& from_to : saved) {
+    auto adj = mesh->get_adj(from_to.first, from_to.second);
+    write_value(stream, I8(from_to.first), needs_swapping);
+    write_value(stream, I8(from_to.second), needs_swapping);
+    write_array(stream, adj.a2ab, is_compressed, needs_swapping);
+    write_array(stream, adj.ab2b, is_compressed, needs_swapping);
+    if (from_to.first < from_to.second) {
+      write_array(stream, adj.codes, is_compressed, needs_swapping);
+    }
+  }
+}
+
+/* installs the stored adjacencies unless the checksum shows that
+   they were written for different connectivity, in which case they
+   are left to be derived */
+static void read_adjs(std::istream& stream, Mesh* mesh, bool is_compressed,
+    bool needs_swapping, I32 version) {
+  I32 nadjs;
+  read_value(stream, nadjs, needs_swapping);
+  OMEGA_H_CHECK(nadjs >= 0);
+  if (nadjs == 0) return;
+  I64 checksum;
+  read_value(stream, checksum, needs_swapping);
+  bool const is_valid = (std::uint64_t(checksum) == down_checksum(mesh));
+  for (I32 i = 0; i < nadjs; ++i) {
+    I8 from, to;
+    read_value(stream, from, needs_swapping);
+    read_value(stream, to, needs_swapping);
+    OMEGA_H_CHECK(0 <= from && from <= to && to <= mesh->dim());
+    Adj adj;
+    read_array(stream, adj.a2ab, is_compressed, needs_swapping, version);
+    read_array(stream, adj.ab2b, is_compressed, needs_swapping, version);
+    if (from < to) {
+      read_array(stream, adj.codes, is_compressed, needs_swapping, version);
+    }
+    if (!is_valid || mesh->has_adj(from, to)) continue;
+    if (adj.a2ab.size() != mesh->nents(from) + 1) continue;
+    mesh->add_adj(from, to, adj);
+  }
+}
+
+void write(std::ostream& stream, Mesh* mesh, bool compress, bool save_adjs) {
   begin_code("binary::write(stream,Mesh)");
   stream.write(reinterpret_cast<const char*>(magic), sizeof(magic));
 // write_value(stream, latest_version); moved to /version at version 4
 #ifdef OMEGA_H_USE_ZLIB
-  I8 is_compressed = true;
+  I8 is_compressed = compress;
 #else
+  OMEGA_H_CHECK(!compress);
   I8 is_compressed = false;
 #endif
   bool needs_swapping = !is_little_endian_cpu();
@@ -426,6 +857,7 @@ void write(std::ostream& stream, Mesh* mesh) {
       write_array(stream, parents.codes, is_compressed, needs_swapping);
     }
   }
+  write_adjs(stream, mesh, save_adjs, is_compressed, needs_swapping);
   end_code();
 }
 
@@ -450,9 +882,9 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
   mesh->set_verts(nverts);
   for (Int d = 1; d <= mesh->dim(); ++d) {
     Adj down;
-    read_array(stream, down.ab2b, is_compressed, needs_swapping);
+    read_array(stream, down.ab2b, is_compressed, needs_swapping, version);
     if (d > 1) {
-      read_array(stream, down.codes, is_compressed, needs_swapping);
+      read_array(stream, down.codes, is_compressed, needs_swapping, version);
     }
     mesh->set_ents(d, down);
   }
@@ -464,8 +896,8 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
     }
     if (mesh->comm()->size() > 1) {
       Remotes owners;
-      read_array(stream, owners.ranks, is_compressed, needs_swapping);
-      read_array(stream, owners.idxs, is_compressed, needs_swapping);
+      read_array(stream, owners.ranks, is_compressed, needs_swapping, version);
+      read_array(stream, owners.idxs, is_compressed, needs_swapping, version);
       mesh->set_owners(d, owners);
     }
   }
@@ -478,17 +910,22 @@ void read(std::istream& stream, Mesh* mesh, I32 version) {
     if (has_parents) {
       for (Int d = 0; d <= mesh->dim(); ++d) {
         Parents parents;
-        read_array(stream, parents.parent_idx, is_compressed, needs_swapping);
-        read_array(stream, parents.codes, is_compressed, needs_swapping);
+        read_array(
+            stream, parents.parent_idx, is_compressed, needs_swapping, version);
+        read_array(
+            stream, parents.codes, is_compressed, needs_swapping, version);
         mesh->set_parents(d, parents);
       }
     }
   }
+  if (version >= 13) {
+    read_adjs(stream, mesh, is_compressed, needs_swapping, version);
+  }
 }
 
 static void write_int_file(
-    filesystem::path const& filepath, Mesh* mesh, I32 value) {
-  if (mesh->comm()->rank() == 0) {
+    filesystem::path const& filepath, CommPtr comm, I32 value) {
+  if (comm->rank() == 0) {
     std::ofstream file(filepath.c_str());
     OMEGA_H_CHECK(file.is_open());
     file << value << '\n';
@@ -496,11 +933,24 @@ static void write_int_file(
 }
 
 static void write_nparts(filesystem::path const& path, Mesh* mesh) {
-  write_int_file(path / "nparts", mesh, mesh->comm()->size());
+  write_int_file(path / "nparts", mesh->comm(), mesh->comm()->size());
 }
 
 static void write_version(filesystem::path const& path, Mesh* mesh) {
-  write_int_file(path / "version", mesh, latest_version);
+  write_int_file(path / "version", mesh->comm(), latest_version);
+}
+
+/* present only when the parts were written into container files,
+   nparts_per_file consecutive ranks to a file */
+static filesystem::path nparts_per_file_path(filesystem::path const& path) {
+  return path / "nparts_per_file";
+}
+
+static filesystem::path container_path(filesystem::path const& path, I32 i) {
+  auto filepath = path;
+  filepath /= "parts" + std::to_string(i);
+  filepath += ".osh";
+  return filepath;
 }
 
 I32 read_nparts(filesystem::path const& path, CommPtr comm) {
@@ -520,6 +970,22 @@ I32 read_nparts(filesystem::path const& path, CommPtr comm) {
   return nparts;
 }
 
+static I32 read_nparts_per_file(filesystem::path const& path, CommPtr comm) {
+  I32 nparts_per_file = 0;
+  if (comm->rank() == 0) {
+    auto const filepath = nparts_per_file_path(path);
+    std::ifstream file(filepath.c_str());
+    if (file.is_open()) {
+      file >> nparts_per_file;
+      if (!file) {
+        Omega_h_fail("could not read file \"%s\"\n", filepath.c_str());
+      }
+    }
+  }
+  comm->bcast(nparts_per_file);
+  return nparts_per_file;
+}
+
 I32 read_version(filesystem::path const& path, CommPtr comm) {
   I32 version;
   if (comm->rank() == 0) {
@@ -538,7 +1004,8 @@ I32 read_version(filesystem::path const& path, CommPtr comm) {
   return version;
 }
 
-void write(filesystem::path const& path, Mesh* mesh) {
+void write(
+    filesystem::path const& path, Mesh* mesh, bool compress, bool save_adjs) {
   begin_code("binary::write(path,Mesh)");
   if (path.extension().string() != ".osh" && can_print(mesh)) {
     std::cout
@@ -550,22 +1017,228 @@ void write(filesystem::path const& path, Mesh* mesh) {
   auto filepath = path;
   filepath /= std::to_string(mesh->comm()->rank());
   filepath += ".osh";
-  std::ofstream file(filepath.c_str());
-  OMEGA_H_CHECK(file.is_open());
-  write(file, mesh);
+  /* rather than truncating the file, which would invalidate pages
+     another mesh may still be mapping, replace it */
+  auto tmppath = filepath;
+  tmppath += ".tmp";
+  {
+    std::ofstream file(tmppath.c_str(), std::ios::binary);
+    OMEGA_H_CHECK(file.is_open());
+    write(file, mesh, compress, save_adjs);
+    OMEGA_H_CHECK(bool(file));
+  }
+#ifdef _WIN32
+  std::remove(filepath.c_str());
+#endif
+  if (std::rename(tmppath.c_str(), filepath.c_str()) != 0) {
+    Omega_h_fail("could not rename \"%s\" to \"%s\": %s\n", tmppath.c_str(),
+        filepath.c_str(), std::strerror(errno));
+  }
   write_nparts(path, mesh);
   write_version(path, mesh);
+  auto const stale = nparts_per_file_path(path);
+  if (mesh->comm()->rank() == 0 && filesystem::exists(stale)) {
+    filesystem::remove(stale);
+  }
   mesh->comm()->barrier();
   end_code();
 }
 
+/* a container file starts with its number of parts and, for each,
+   the rank that wrote it and the offset and size of its bytes in the
+   file. every part starts at a multiple of osh_alignment, so arrays
+   that were aligned within the part stay aligned when it is mapped */
+static void write_containers(filesystem::path const& path, CommPtr comm,
+    std::string const& part, I32 naggregators) {
+  auto const nparts = comm->size();
+  naggregators = std::max(1, std::min(naggregators, nparts));
+  auto const nparts_per_file = (nparts + naggregators - 1) / naggregators;
+  auto const file = comm->rank() / nparts_per_file;
+  auto const group = comm->split(file, comm->rank());
+  auto const is_writer = (group->rank() == 0);
+  auto const nwords =
+      LO((I64(part.size()) + osh_alignment - 1) / osh_alignment);
+  HostWrite<I64> words(nwords);
+  if (nwords) {
+    words[nwords - 1] = 0;
+    std::memcpy(nonnull(words.data()), part.data(), part.size());
+  }
+  auto const offset = group->exscan(GO(nwords), OMEGA_H_SUM);
+  auto const total = group->allreduce(GO(nwords), OMEGA_H_SUM);
+  OMEGA_H_CHECK(total <= GO(std::numeric_limits<LO>::max()));
+  auto const to_writer = Read<I32>(nwords, 0);
+  auto const gathered =
+      Dist(group, Remotes(to_writer, LOs(nwords, LO(offset), 1)),
+          is_writer ? LO(total) : 0)
+          .exch(Read<I64>(words.write()), 1);
+  auto const index =
+      Dist(group, Remotes(Read<I32>({0}), LOs({group->rank()})),
+          is_writer ? group->size() : 0)
+          .exch(Read<I64>({comm->rank(), offset, I64(part.size())}), 3);
+  if (is_writer) {
+    bool const needs_swapping = !is_little_endian_cpu();
+    auto const filepath = container_path(path, file);
+    auto tmppath = filepath;
+    tmppath += ".tmp";
+    {
+      std::ofstream stream(tmppath.c_str(), std::ios::binary);
+      OMEGA_H_CHECK(stream.is_open());
+      auto const nfile_parts = group->size();
+      auto const header_bytes =
+          std::streamoff(sizeof(I32)) + nfile_parts * std::streamoff(20);
+      auto const data_begin = ((header_bytes + osh_alignment - 1) /
+                                  osh_alignment) *
+                              osh_alignment;
+      auto const host_index = HostRead<I64>(index);
+      write_value(stream, I32(nfile_parts), needs_swapping);
+      for (I32 i = 0; i < nfile_parts; ++i) {
+        write_value(stream, I32(host_index[i * 3 + 0]), needs_swapping);
+        write_value(stream,
+            I64(data_begin + host_index[i * 3 + 1] * osh_alignment),
+            needs_swapping);
+        write_value(stream, host_index[i * 3 + 2], needs_swapping);
+      }
+      for (auto i = header_bytes; i < data_begin; ++i) stream.put('\0');
+      auto const host_gathered = HostRead<I64>(gathered);
+      stream.write(reinterpret_cast<char const*>(host_gathered.data()),
+          std::streamsize(total * osh_alignment));
+      OMEGA_H_CHECK(bool(stream));
+    }
+#ifdef _WIN32
+    std::remove(filepath.c_str());
+#endif
+    if (std::rename(tmppath.c_str(), filepath.c_str()) != 0) {
+      Omega_h_fail("could not rename \"%s\" to \"%s\": %s\n",
+          tmppath.c_str(), filepath.c_str(), std::strerror(errno));
+    }
+  }
+  write_int_file(path / "nparts", comm, nparts);
+  write_int_file(path / "version", comm, latest_version);
+  write_int_file(nparts_per_file_path(path), comm, nparts_per_file);
+  comm->barrier();
+}
+
+static void create_directory_once(filesystem::path const& path, CommPtr comm) {
+  if (comm->rank() == 0) filesystem::create_directory(path);
+  comm->barrier();
+}
+
+void write_aggregated(filesystem::path const& path, Mesh* mesh,
+    I32 naggregators, bool compress, bool save_adjs) {
+  begin_code("binary::write_aggregated(path,Mesh)");
+  auto const comm = mesh->comm();
+  create_directory_once(path, comm);
+  std::ostringstream stream;
+  write(stream, mesh, compress, save_adjs);
+  write_containers(path, comm, stream.str(), naggregators);
+  end_code();
+}
+
+AsyncWriter::AsyncWriter(filesystem::path const& path, Mesh* mesh,
+    I32 naggregators, bool compress, bool save_adjs)
+    : path_(path), comm_(mesh->comm()), naggregators_(naggregators) {
+  begin_code("binary::AsyncWriter(path,Mesh)");
+  auto snapshot = std::make_shared<PartSnapshot>();
+  write(*snapshot, mesh, compress, save_adjs);
+  thread_ = std::thread([this, snapshot]() {
+    try {
+      part_ = snapshot->finish();
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+  });
+  end_code();
+}
+
+/* the destructor must neither throw nor talk to the other ranks,
+   so a writer that was never waited on only joins its thread and
+   says that nothing was written */
+AsyncWriter::~AsyncWriter() {
+  if (!thread_.joinable()) return;
+  thread_.join();
+  std::cerr << "binary::AsyncWriter: rank " << comm_->rank()
+            << " destroyed without wait(), \"" << path_.string()
+            << "\" was not written\n";
+}
+
+void AsyncWriter::wait() {
+  if (!thread_.joinable()) return;
+  begin_code("binary::AsyncWriter::wait()");
+  thread_.join();
+  if (error_) std::rethrow_exception(error_);
+  create_directory_once(path_, comm_);
+  write_containers(path_, comm_, part_, naggregators_);
+  part_ = std::string();
+  end_code();
+}
+
+/* finds this rank's part in its container and reads it from there */
+static void read_contained(filesystem::path const& path, Mesh* mesh,
+    I32 version, I32 nparts_per_file) {
+  auto const rank = mesh->comm()->rank();
+  auto const filepath = container_path(path, rank / nparts_per_file);
+  bool const needs_swapping = !is_little_endian_cpu();
+  std::ifstream file(filepath.c_str(), std::ios::binary);
+  if (!file.is_open()) {
+    Omega_h_fail("could not open file \"%s\"\n", filepath.c_str());
+  }
+  I32 nfile_parts;
+  read_value(file, nfile_parts, needs_swapping);
+  I64 offset = -1;
+  I64 size = -1;
+  for (I32 i = 0; i < nfile_parts; ++i) {
+    I32 part_rank;
+    I64 part_offset;
+    I64 part_size;
+    read_value(file, part_rank, needs_swapping);
+    read_value(file, part_offset, needs_swapping);
+    read_value(file, part_size, needs_swapping);
+    if (part_rank == rank) {
+      offset = part_offset;
+      size = part_size;
+    }
+  }
+  OMEGA_H_CHECK(bool(file));
+  if (offset < 0) {
+    Omega_h_fail("part %d is missing from \"%s\"\n", rank, filepath.c_str());
+  }
+#ifdef OMEGA_H_MAP_OSH
+  auto mapped = map_file(filepath);
+  if (mapped) {
+    MappedBuf buf(mapped, std::size_t(offset), std::size_t(size));
+    std::istream stream(&buf);
+    read(stream, mesh, version);
+    OMEGA_H_CHECK(bool(stream));
+    return;
+  }
+#endif
+  file.seekg(offset);
+  read(file, mesh, version);
+  OMEGA_H_CHECK(bool(file));
+}
+
 void read_in_comm(
     filesystem::path const& path, CommPtr comm, Mesh* mesh, I32 version) {
   ScopedTimer timer("binary::read_in_comm(path, comm, mesh, version)");
   mesh->set_comm(comm);
+  auto const nparts_per_file = read_nparts_per_file(path, comm);
+  if (nparts_per_file > 0) {
+    read_contained(path, mesh, version, nparts_per_file);
+    return;
+  }
   auto filepath = path;
   filepath /= std::to_string(mesh->comm()->rank());
   if (version != -1) filepath += ".osh";
+#ifdef OMEGA_H_MAP_OSH
+  auto mapped = map_file(filepath);
+  if (mapped) {
+    MappedBuf buf(mapped);
+    std::istream stream(&buf);
+    read(stream, mesh, version);
+    OMEGA_H_CHECK(bool(stream));
+    return;
+  }
+#endif
   std::ifstream file(filepath.c_str(), std::ios::binary);
   OMEGA_H_CHECK(file.is_open());
   read(file, mesh, version);
@@ -617,9 +1290,10 @@ Mesh read(filesystem::path const& path, CommPtr comm, bool strict) {
   template Read<T> swap_bytes(Read<T> array, bool is_little_endian);           \
   template void write_value(std::ostream& stream, T val, bool);                \
   template void read_value(std::istream& stream, T& val, bool);                \
-  template void write_array(std::ostream& stream, Read<T> array, bool, bool);  \
-  template void read_array(                                                    \
-      std::istream& stream, Read<T>& array, bool is_compressed, bool);
+  template void write_array(                                                   \
+      std::ostream& stream, Read<T> array, bool, bool, bool);                  \
+  template void read_array(std::istream& stream, Read<T>& array,             \
+      bool is_compressed, bool, I32 version);
 OMEGA_H_INST(I8)
 OMEGA_H_INST(I32)
 OMEGA_H_INST(I64)
@@ -1,7 +1,10 @@
 #ifndef OMEGA_H_FILE_HPP
 #define OMEGA_H_FILE_HPP
 
+#include <exception>
 #include <iosfwd>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <Omega_h_config.h>
@@ -82,6 +85,19 @@ Mesh read(std::istream& stream, CommPtr comm);
 Mesh read(filesystem::path const& filename, CommPtr comm);
 void write(std::ostream& stream, Mesh* mesh);
 void write(filesystem::path const& filepath, Mesh* mesh);
+/* writes binary format 4.1, which read_sliced() can read in parallel */
+void write_binary(std::ostream& stream, Mesh* mesh);
+void write_binary(filesystem::path const& filepath, Mesh* mesh);
+/* each rank reads only its own slice of the nodes and of the elements
+   of highest dimension, seeking straight to them, and the slices are
+   then partitioned by assemble_slices(), so no rank holds the whole
+   mesh. only binary files of format 4.1 with contiguous node tags can
+   be sliced, others are read by read(). elements are classified by
+   their model entities, and lower dimensional entities are classified
+   from them as by finalize_classification(), ignoring the lower
+   dimensional elements in the file. like exodus::read_sliced(), this
+   needs a number of ranks that recursive bisection can split evenly. */
+Mesh read_sliced(filesystem::path const& filename, CommPtr comm);
 
 #ifdef OMEGA_H_USE_GMSH
 
@@ -172,7 +188,15 @@ class FullWriter {
 
 namespace binary {
 
-void write(filesystem::path const& path, Mesh* mesh);
+/* writes each part to a temporary file and renames it into place,
+   so meshes still aliasing a previously mapped part stay valid.
+   Uncompressed parts of the native byte order are mapped on read
+   and their arrays use the file pages in place.
+   With save_adjs, the upward adjacencies, stars and duals the mesh
+   has already derived are stored too, and read() installs them
+   instead of deriving them again. */
+void write(filesystem::path const& path, Mesh* mesh,
+    bool compress = OMEGA_H_DEFAULT_COMPRESS, bool save_adjs = false);
 Mesh read(filesystem::path const& path, Library* lib, bool strict = false);
 Mesh read(filesystem::path const& path, CommPtr comm, bool strict = false);
 I32 read(filesystem::path const& path, CommPtr comm, Mesh* mesh,
@@ -182,7 +206,40 @@ I32 read_version(filesystem::path const& path, CommPtr comm);
 void read_in_comm(
     filesystem::path const& path, CommPtr comm, Mesh* mesh, I32 version);
 
-constexpr I32 latest_version = 10;
+/* instead of a file per rank, groups of consecutive ranks send their
+   parts to the first rank of the group, which writes them all into one
+   container file, so that only naggregators ranks touch the file
+   system. read() and read_in_comm() find the parts in the containers,
+   for any number of reading ranks. */
+void write_aggregated(filesystem::path const& path, Mesh* mesh,
+    I32 naggregators, bool compress = OMEGA_H_DEFAULT_COMPRESS,
+    bool save_adjs = false);
+
+/* writes like write_aggregated(), but the constructor only copies
+   the mesh arrays and returns, leaving a background thread to compress
+   them, so the mesh can change while that happens. wait() sends the
+   parts to the aggregators and writes the files. it is collective
+   and must be called before the writer is destroyed; the destructor
+   only joins the thread and writes nothing. */
+class AsyncWriter {
+ public:
+  AsyncWriter(filesystem::path const& path, Mesh* mesh, I32 naggregators,
+      bool compress = OMEGA_H_DEFAULT_COMPRESS, bool save_adjs = false);
+  AsyncWriter(AsyncWriter const&) = delete;
+  AsyncWriter& operator=(AsyncWriter const&) = delete;
+  ~AsyncWriter();
+  void wait();
+
+ private:
+  filesystem::path path_;
+  CommPtr comm_;
+  I32 naggregators_;
+  std::string part_;
+  std::exception_ptr error_;
+  std::thread thread_;
+};
+
+constexpr I32 latest_version = 13;
 
 template <typename T>
 void swap_bytes(T&);
@@ -196,15 +253,16 @@ template <typename T>
 void read_value(std::istream& stream, T& val, bool needs_swapping);
 template <typename T>
 void write_array(std::ostream& stream, Read<T> array, bool is_compressed,
-    bool needs_swapping);
+    bool needs_swapping, bool use_filter = true);
 template <typename T>
 void read_array(std::istream& stream, Read<T>& array, bool is_compressed,
-    bool needs_swapping);
+    bool needs_swapping, I32 version = latest_version);
 
 void write(std::ostream& stream, std::string const& val, bool needs_swapping);
 void read(std::istream& stream, std::string& val, bool needs_swapping);
 
-void write(std::ostream& stream, Mesh* mesh);
+void write(std::ostream& stream, Mesh* mesh,
+    bool compress = OMEGA_H_DEFAULT_COMPRESS, bool save_adjs = false);
 void read(std::istream& stream, Mesh* mesh, I32 version);
 
 #define INST_DECL(T)                                                           \
@@ -213,9 +271,9 @@ void read(std::istream& stream, Mesh* mesh, I32 version);
   extern template void write_value(std::ostream& stream, T val, bool);         \
   extern template void read_value(std::istream& stream, T& val, bool);         \
   extern template void write_array(                                            \
-      std::ostream& stream, Read<T> array, bool, bool);                        \
+      std::ostream& stream, Read<T> array, bool, bool, bool);                  \
   extern template void read_array(                                             \
-      std::istream& stream, Read<T>& array, bool, bool);
+      std::istream& stream, Read<T>& array, bool, bool, I32);
 INST_DECL(I8)
 INST_DECL(I32)
 INST_DECL(I64)
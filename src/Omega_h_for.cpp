@@ -1,7 +1,104 @@
 #include <Omega_h_for.hpp>
 
+#include <Omega_h_fail.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
 namespace Omega_h {
 #if defined(OMEGA_H_USE_CUDA) && (!defined(OMEGA_H_USE_KOKKOS))
 int block_size_cuda = 256;
 #endif
+
+namespace {
+
+struct ForPolicies {
+  std::mutex mutex;
+  std::map<std::string, ForPolicy> by_name;
+  bool has_fallback = false;
+  ForPolicy fallback = default_for_policy();
+  /* checked without the lock so that kernels pay
+     nothing when no overrides were requested */
+  std::atomic<bool> empty{true};
+};
+
+ForPolicies& global_for_policies() {
+  static ForPolicies policies;
+  return policies;
+}
+
+Omega_h_Schedule parse_schedule(std::string const& kind) {
+  if (kind == "static") return OMEGA_H_SCHEDULE_STATIC;
+  if (kind == "dynamic") return OMEGA_H_SCHEDULE_DYNAMIC;
+  if (kind == "guided") return OMEGA_H_SCHEDULE_GUIDED;
+  Omega_h_fail("unknown parallel_for schedule \"%s\", expected "
+               "static, dynamic or guided\n",
+      kind.c_str());
+  OMEGA_H_NORETURN(OMEGA_H_SCHEDULE_STATIC);
+}
+
+}  // end anonymous namespace
+
+ForPolicy get_for_policy(char const* name) {
+  auto& policies = global_for_policies();
+  if (policies.empty || name == nullptr || name[0] == '\0') {
+    return default_for_policy();
+  }
+  std::lock_guard<std::mutex> lock(policies.mutex);
+  auto it = policies.by_name.find(name);
+  if (it != policies.by_name.end()) return it->second;
+  if (policies.has_fallback) return policies.fallback;
+  return default_for_policy();
+}
+
+void set_for_policy(char const* name, ForPolicy policy) {
+  OMEGA_H_CHECK(policy.chunk >= 0);
+  auto& policies = global_for_policies();
+  std::lock_guard<std::mutex> lock(policies.mutex);
+  if (std::string(name) == "*") {
+    policies.has_fallback = true;
+    policies.fallback = policy;
+  } else {
+    policies.by_name[name] = policy;
+  }
+  policies.empty = false;
+}
+
+void set_for_policies(char const* spec) {
+  std::stringstream stream(spec);
+  std::string entry;
+  while (std::getline(stream, entry, ',')) {
+    if (entry.empty()) continue;
+    auto const eq = entry.find('=');
+    if (eq == std::string::npos || eq == 0) {
+      Omega_h_fail("parallel_for schedule entry \"%s\" is not of the form "
+                   "name=kind[:chunk]\n",
+          entry.c_str());
+    }
+    auto const name = entry.substr(0, eq);
+    auto value = entry.substr(eq + 1);
+    ForPolicy policy = default_for_policy();
+    auto const colon = value.find(':');
+    if (colon != std::string::npos) {
+      policy.chunk = LO(std::atoi(value.substr(colon + 1).c_str()));
+      value = value.substr(0, colon);
+    }
+    policy.schedule = parse_schedule(value);
+    set_for_policy(name.c_str(), policy);
+  }
+}
+
+void clear_for_policies() {
+  auto& policies = global_for_policies();
+  std::lock_guard<std::mutex> lock(policies.mutex);
+  policies.by_name.clear();
+  policies.has_fallback = false;
+  policies.fallback = default_for_policy();
+  policies.empty = true;
+}
+
 }  // namespace Omega_h
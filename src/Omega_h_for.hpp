@@ -9,10 +9,38 @@
 
 #ifdef OMEGA_H_USE_KOKKOS
 #include <Omega_h_kokkos.hpp>
+#elif defined(OMEGA_H_USE_OPENMP)
+#include <omp.h>
+#include <vector>
 #endif
 
 namespace Omega_h {
 
+/* How parallel_for distributes iterations among threads.
+   Static scheduling suits uniform kernels; kernels whose iterations
+   vary a lot in cost (walking variable-length stars, for example)
+   balance better with dynamic or guided scheduling.
+   Only the OpenMP backend honors this, the others ignore it. */
+struct ForPolicy {
+  Omega_h_Schedule schedule;
+  LO chunk;  // zero selects the OpenMP default chunk size
+};
+
+constexpr ForPolicy default_for_policy() {
+  return ForPolicy{OMEGA_H_SCHEDULE_STATIC, 0};
+}
+
+/* Per-kernel overrides, keyed by the name given to parallel_for.
+   They are read at Library initialization from the OMEGA_H_SCHEDULE
+   environment variable and the --osh-schedule flag, whose value is a
+   comma-separated list such as
+     coarsen_qualities=dynamic:64,swap3d_qualities=guided
+   where the name "*" sets the policy of all other named kernels. */
+ForPolicy get_for_policy(char const* name);
+void set_for_policy(char const* name, ForPolicy policy);
+void set_for_policies(char const* spec);
+void clear_for_policies();
+
 #if defined(OMEGA_H_USE_CUDA) && !defined(OMEGA_H_USE_KOKKOS)
 
 namespace details {
@@ -82,6 +110,49 @@ void for_each(InputIterator first, InputIterator last, UnaryFunction&& f) {
 }
 
 #endif
+
+#if defined(OMEGA_H_USE_OPENMP) && !defined(OMEGA_H_USE_KOKKOS)
+
+namespace details {
+
+/* thread_times, if given, receives the time each thread spent
+   in its share of the iterations, excluding the final barrier */
+template <typename T>
+void openmp_parallel_for(
+    LO n, T const& f, ForPolicy policy, double* thread_times) {
+  auto const chunk = (policy.chunk > 0) ? policy.chunk : LO(1);
+#pragma omp parallel
+  {
+    auto const t0 = thread_times ? omp_get_wtime() : 0.0;
+    switch (policy.schedule) {
+      case OMEGA_H_SCHEDULE_STATIC:
+        if (policy.chunk > 0) {
+#pragma omp for schedule(static, chunk) nowait
+          for (LO i = 0; i < n; ++i) f(i);
+        } else {
+#pragma omp for schedule(static) nowait
+          for (LO i = 0; i < n; ++i) f(i);
+        }
+        break;
+      case OMEGA_H_SCHEDULE_DYNAMIC:
+#pragma omp for schedule(dynamic, chunk) nowait
+        for (LO i = 0; i < n; ++i) f(i);
+        break;
+      case OMEGA_H_SCHEDULE_GUIDED:
+#pragma omp for schedule(guided, chunk) nowait
+        for (LO i = 0; i < n; ++i) f(i);
+        break;
+    }
+    if (thread_times) {
+      thread_times[omp_get_thread_num()] = omp_get_wtime() - t0;
+    }
+  }
+}
+
+}  // namespace details
+
+#endif
+
 template <typename UnaryFunction>
 void parallel_for(LO n, UnaryFunction&& f) {
   OMEGA_H_TIME_FUNCTION;
@@ -90,10 +161,19 @@ void parallel_for(LO n, UnaryFunction&& f) {
   ::Omega_h::for_each(first, last, f);
 }
 
+/* When profiling is on, named kernels also report how unevenly
+   their iterations were spread over the threads (see
+   profile::print_imbalance). */
+template <typename T>
+void parallel_for(
+    LO n, T const& f, ForPolicy for_policy, char const* name = "");
+
 template <typename T>
 void parallel_for(LO n, T const& f, char const* name = "") {
 #if defined(OMEGA_H_USE_KOKKOS)
   if (n > 0) Kokkos::parallel_for(name, policy(n), f);
+#elif defined(OMEGA_H_USE_OPENMP)
+  parallel_for(n, f, get_for_policy(name), name);
 #else
   (void)name;
   auto const first = IntIterator(0);
@@ -103,6 +183,28 @@ void parallel_for(LO n, T const& f, char const* name = "") {
 #endif
 }
 
+template <typename T>
+void parallel_for(
+    LO n, T const& f, ForPolicy for_policy, char const* name) {
+#if defined(OMEGA_H_USE_OPENMP) && !defined(OMEGA_H_USE_KOKKOS)
+  if (n <= 0) return;
+  Omega_h::entering_parallel = true;
+  auto const f2 = f;
+  Omega_h::entering_parallel = false;
+  if (profile::global_singleton_history && name[0] != '\0') {
+    std::vector<double> thread_times(std::size_t(omp_get_max_threads()), -1.0);
+    details::openmp_parallel_for(n, f2, for_policy, thread_times.data());
+    profile::record_imbalance(
+        name, thread_times.data(), int(thread_times.size()));
+  } else {
+    details::openmp_parallel_for(n, f2, for_policy, nullptr);
+  }
+#else
+  (void)for_policy;
+  parallel_for(n, f, name);
+#endif
+}
+
 template <typename T>
 void parallel_for(char const* name, LO n, T const& f) {
   parallel_for(n, f, name);
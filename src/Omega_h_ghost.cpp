@@ -2,8 +2,11 @@
 
 #include "Omega_h_for.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_migrate.hpp"
+#include "Omega_h_owners.hpp"
+#include "Omega_h_unmap_mesh.hpp"
 
 namespace Omega_h {
 
@@ -117,6 +120,134 @@ void ghost_mesh(Mesh* mesh, Int nlayers, bool verbose) {
   migrate_mesh(mesh, elems2owners, OMEGA_H_GHOSTED, verbose);
 }
 
+std::shared_ptr<GhostCache> drop_ghosts(Mesh* mesh) {
+  OMEGA_H_TIME_FUNCTION;
+  auto cache = std::make_shared<GhostCache>();
+  auto const dim = mesh->dim();
+  /* reusing takes the tags the element-based mesh has by then,
+     and the other adjacencies can be derived again */
+  cache->ghosted = std::make_shared<Mesh>(mesh->copy_meta());
+  cache->ghosted->set_verts(mesh->nverts());
+  for (Int d = 1; d <= dim; ++d) {
+    cache->ghosted->set_ents(d, mesh->ask_down(d, d - 1));
+  }
+  for (Int d = 0; d <= dim; ++d) {
+    cache->ghosted->set_owners(d, mesh->ask_owners(d));
+  }
+  auto const elems_are_owned = mesh->owned(dim);
+  cache->kept[dim] = collect_marked(elems_are_owned);
+  for (Int d = 0; d < dim; ++d) {
+    /* only what the owned elements here are made of */
+    auto const l2h = mesh->ask_up(d, dim);
+    cache->kept[d] = collect_marked(mark_down(l2h, elems_are_owned));
+  }
+  auto new_mesh = mesh->copy_meta();
+  new_mesh.set_verts(cache->kept[VERT].size());
+  LOs old_lows2new_lows;
+  for (Int d = 0; d <= dim; ++d) {
+    auto const kept = cache->kept[d];
+    if (d > VERT) unmap_down(mesh, &new_mesh, d, kept, old_lows2new_lows);
+    unmap_tags(mesh, &new_mesh, d, kept);
+    /* owners are chosen among the copies that stay exactly as
+       migrating to the element-based partitioning chooses them */
+    auto const copies2old_owners =
+        Dist(mesh->comm(), unmap(kept, mesh->ask_owners(d)), mesh->nents(d));
+    new_mesh.set_owners(d, update_ownership(copies2old_owners, Read<I32>()));
+    old_lows2new_lows = invert_injective_map(kept, mesh->nents(d));
+  }
+  *mesh = new_mesh;
+  for (Int d = 0; d <= dim; ++d) {
+    cache->globals[d] = mesh->globals(d);
+    cache->owners[d] = mesh->ask_owners(d);
+  }
+  return cache;
+}
+
+static bool is_left_by(Mesh* mesh, GhostCache const& cache) {
+  for (Int d = 0; d <= mesh->dim(); ++d) {
+    if (mesh->nents(d) != cache.kept[d].size()) return false;
+    /* anything that changes the entities replaces these arrays,
+       and the cache keeps the old ones alive, so comparing
+       addresses is enough */
+    auto const owners = mesh->ask_owners(d);
+    if (mesh->globals(d).data() != cache.globals[d].data() ||
+        owners.ranks.data() != cache.owners[d].ranks.data() ||
+        owners.idxs.data() != cache.owners[d].idxs.data()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* ghosting keeps the owners of the element-based mesh, which need
+   not be the ones the dropped layer had */
+static Remotes owners_onto_ghosts(
+    Mesh* mesh, Mesh* ghosted, Int d, LOs kept) {
+  auto const owners = mesh->ask_owners(d);
+  auto const owner_idxs = mesh->sync_array(d, kept, 1);
+  Write<LO> kept_owners(kept.size() * 2);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    kept_owners[i * 2 + 0] = owners.ranks[i];
+    kept_owners[i * 2 + 1] = owner_idxs[i];
+  };
+  parallel_for(kept.size(), f, "owners_onto_ghosts");
+  auto const nents = ghosted->nents(d);
+  auto data = map_onto(read(kept_owners), kept, nents, LO(-1), 2);
+  /* the copies that stayed all agree on their owner */
+  data = ghosted->reduce_array(d, data, 2, OMEGA_H_MAX);
+  data = ghosted->sync_array(d, data, 2);
+  Write<I32> ranks(nents);
+  Write<LO> idxs(nents);
+  auto g = OMEGA_H_LAMBDA(LO e) {
+    ranks[e] = data[e * 2 + 0];
+    idxs[e] = data[e * 2 + 1];
+  };
+  parallel_for(nents, g, "owners_onto_ghosts");
+  return Remotes(ranks, idxs);
+}
+
+template <typename T>
+static void sync_onto_ghosts(
+    Mesh* ghosted, Int d, TagBase const* tag, LOs kept) {
+  auto const ncomps = tag->ncomps();
+  auto const kept_data = as<T>(tag)->array();
+  auto const data = map_onto(kept_data, kept, ghosted->nents(d), T(0), ncomps);
+  ghosted->add_tag<T>(
+      d, tag->name(), ncomps, ghosted->sync_array(d, data, ncomps), true);
+}
+
+bool reuse_ghosts(Mesh* mesh, GhostCache const& cache) {
+  OMEGA_H_TIME_FUNCTION;
+  auto can_reuse = is_left_by(mesh, cache);
+  /* reverse class fields, also while they are held as mesh tags,
+     need their class IDs, which add_tag() would drop */
+  for (Int d = 0; d <= mesh->dim(); ++d) {
+    if (mesh->nrctags(d)) can_reuse = false;
+    for (Int i = 0; i < mesh->ntags(d); ++i) {
+      if (is_rc_tag(mesh->get_tag(d, i)->name())) can_reuse = false;
+    }
+  }
+  if (!mesh->comm()->reduce_and(can_reuse)) return false;
+  auto ghosted = *cache.ghosted;
+  for (Int d = 0; d <= mesh->dim(); ++d) {
+    ghosted.set_owners(
+        d, owners_onto_ghosts(mesh, &ghosted, d, cache.kept[d]));
+    while (ghosted.ntags(d)) {
+      ghosted.remove_tag(d, ghosted.get_tag(d, 0)->name());
+    }
+    for (Int i = 0; i < mesh->ntags(d); ++i) {
+      auto const tag = mesh->get_tag(d, i);
+      apply_to_omega_h_types(tag->type(), [&](auto t) {
+        using T = decltype(t);
+        sync_onto_ghosts<T>(&ghosted, d, tag, cache.kept[d]);
+      });
+    }
+  }
+  ghosted.class_sets = mesh->class_sets;
+  *mesh = ghosted;
+  return true;
+}
+
 void partition_by_verts(Mesh* mesh, bool verbose) {
   /* vertex-based partitioning is defined as gathering the elements
    * adjacent to owned vertices, hence the graph from owned vertices
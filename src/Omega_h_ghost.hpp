@@ -3,6 +3,8 @@
 
 #include <Omega_h_dist.hpp>
 
+#include <memory>
+
 namespace Omega_h {
 
 class Mesh;
@@ -25,6 +27,33 @@ void get_own_verts2own_elem_uses(
 Remotes push_elem_uses(RemoteGraph own_verts2own_elems, Dist own_verts2verts);
 
 void ghost_mesh(Mesh* mesh, Int nlayers, bool verbose);
+
+/* what drop_ghosts() removed, kept so that ghosting the element-based
+ * mesh it left can bring the same ghosts back without migrating.
+ * ghosted has only the downward adjacencies and owners of the ghosted
+ * mesh, no tags. kept maps the entities that stayed to their index in
+ * it, and the globals and owners identify the element-based mesh.
+ */
+struct GhostCache {
+  std::shared_ptr<Mesh> ghosted;
+  LOs kept[4];
+  GOs globals[4];
+  Remotes owners[4];
+};
+
+/* goes from a ghosted to an element-based partitioning.
+ * the owned elements and their closure are already on this rank,
+ * so the mesh is restricted to them in place rather than migrated,
+ * and only the owners of shared entities are chosen again.
+ */
+std::shared_ptr<GhostCache> drop_ghosts(Mesh* mesh);
+/* undoes drop_ghosts() if the mesh is still the element-based mesh
+ * it left and has no reverse class fields, taking the tags the mesh
+ * has now and synchronizing them onto the ghosts. unless that holds
+ * on every rank, returns false on all of them and changes nothing.
+ */
+bool reuse_ghosts(Mesh* mesh, GhostCache const& cache);
+
 void partition_by_verts(Mesh* mesh, bool verbose);
 void partition_by_elems(Mesh* mesh, bool verbose);
 
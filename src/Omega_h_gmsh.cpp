@@ -3,14 +3,19 @@
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
+#include <map>
 #include <cctype>
 #include <sstream>
 #include <unordered_map>
 
+#include "Omega_h_array_ops.hpp"
 #include "Omega_h_build.hpp"
 #include "Omega_h_class.hpp"
 #include "Omega_h_element.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_linpart.hpp"
 #include "Omega_h_map.hpp"
+#include "Omega_h_profile.hpp"
 #include "Omega_h_vector.hpp"
 
 #ifdef OMEGA_H_USE_GMSH
@@ -145,14 +150,27 @@ static void read(
   }
 }
 
+/* counts and tags are size_t in binary format 4.1, int everywhere else */
+template <class T>
+static void read_size(std::istream& stream, T& value, Real format,
+    bool is_binary, bool needs_swapping) {
+  if (is_binary && format >= 4.1) {
+    I64 wide;
+    binary::read_value(stream, wide, needs_swapping);
+    value = static_cast<T>(wide);
+  } else {
+    read(stream, value, is_binary, needs_swapping);
+  }
+}
+
 static void read_internal_entities_section(Mesh& mesh, Real format,
     std::vector<std::string>& physical_names, std::istream& stream,
     bool is_binary, bool needs_swapping) {
   Int num_points, num_curves, num_surfaces, num_volumes;
-  read(stream, num_points, is_binary, needs_swapping);
-  read(stream, num_curves, is_binary, needs_swapping);
-  read(stream, num_surfaces, is_binary, needs_swapping);
-  read(stream, num_volumes, is_binary, needs_swapping);
+  read_size(stream, num_points, format, is_binary, needs_swapping);
+  read_size(stream, num_curves, format, is_binary, needs_swapping);
+  read_size(stream, num_surfaces, format, is_binary, needs_swapping);
+  read_size(stream, num_volumes, format, is_binary, needs_swapping);
   while (num_points-- > 0) {
     Int tag;
     Vector<3> point;
@@ -167,7 +185,7 @@ static void read_internal_entities_section(Mesh& mesh, Real format,
       read(stream, point[1], is_binary, needs_swapping);
       read(stream, point[2], is_binary, needs_swapping);
     }
-    read(stream, num_physicals, is_binary, needs_swapping);
+    read_size(stream, num_physicals, format, is_binary, needs_swapping);
     while (num_physicals-- > 0) {
       Int physical;
       read(stream, physical, is_binary, needs_swapping);
@@ -194,7 +212,7 @@ static void read_internal_entities_section(Mesh& mesh, Real format,
       read(stream, max_point[0], is_binary, needs_swapping);
       read(stream, max_point[1], is_binary, needs_swapping);
       read(stream, max_point[2], is_binary, needs_swapping);
-      read(stream, num_physicals, is_binary, needs_swapping);
+      read_size(stream, num_physicals, format, is_binary, needs_swapping);
       while (num_physicals-- > 0) {
         Int physical;
         read(stream, physical, is_binary, needs_swapping);
@@ -205,7 +223,8 @@ static void read_internal_entities_section(Mesh& mesh, Real format,
         }
       }
       Int num_bounding_points;
-      read(stream, num_bounding_points, is_binary, needs_swapping);
+      read_size(
+          stream, num_bounding_points, format, is_binary, needs_swapping);
       while (num_bounding_points-- > 0) {
         Int points_tag;
         read(stream, points_tag, is_binary, needs_swapping);
@@ -269,15 +288,16 @@ void read_internal(std::istream& stream, Mesh* mesh) {
   std::map<int, int> node_number_map;
   int nnodes;
   if (format >= 4.0) {
-    eat_newlines(stream);
+    // binary data starts right after the line, and may start with '\n'
+    if (!is_binary) eat_newlines(stream);
     int num_entity_blocks;
-    read(stream, num_entity_blocks, is_binary, needs_swapping);
-    read(stream, nnodes, is_binary, needs_swapping);
+    read_size(stream, num_entity_blocks, format, is_binary, needs_swapping);
+    read_size(stream, nnodes, format, is_binary, needs_swapping);
     node_coords.reserve(std::size_t(nnodes));
     if (format >= 4.1) {
       int node_tag;
-      read(stream, node_tag, is_binary, needs_swapping);  // min
-      read(stream, node_tag, is_binary, needs_swapping);  // max
+      read_size(stream, node_tag, format, is_binary, needs_swapping);  // min
+      read_size(stream, node_tag, format, is_binary, needs_swapping);  // max
       for (int entity_block = 0; entity_block < num_entity_blocks;
            ++entity_block) {
         int class_id, class_dim;
@@ -285,10 +305,10 @@ void read_internal(std::istream& stream, Mesh* mesh) {
         read(stream, class_id, is_binary, needs_swapping);
         int node_type, num_block_nodes;
         read(stream, node_type, is_binary, needs_swapping);
-        read(stream, num_block_nodes, is_binary, needs_swapping);
+        read_size(stream, num_block_nodes, format, is_binary, needs_swapping);
         for (int block_node = 0; block_node < num_block_nodes; ++block_node) {
           int node_number;
-          read(stream, node_number, is_binary, needs_swapping);
+          read_size(stream, node_number, format, is_binary, needs_swapping);
           const auto position = int(node_coords.size() + block_node);
           node_number_map[node_number] = position;
         }
@@ -346,14 +366,14 @@ void read_internal(std::istream& stream, Mesh* mesh) {
   std::array<std::vector<int>, 4> ent_nodes;
   Omega_h_Family family = OMEGA_H_SIMPLEX;
   if (format >= 4.0) {
-    eat_newlines(stream);
+    if (!is_binary) eat_newlines(stream);
     int num_entity_blocks, total_num_ents;
-    read(stream, num_entity_blocks, is_binary, needs_swapping);
-    read(stream, total_num_ents, is_binary, needs_swapping);
+    read_size(stream, num_entity_blocks, format, is_binary, needs_swapping);
+    read_size(stream, total_num_ents, format, is_binary, needs_swapping);
     if (format >= 4.1) {
-      int element_tag;
-      read(stream, element_tag, is_binary, needs_swapping);  // min
-      read(stream, element_tag, is_binary, needs_swapping);  // max
+      int tag;
+      read_size(stream, tag, format, is_binary, needs_swapping);  // min
+      read_size(stream, tag, format, is_binary, needs_swapping);  // max
     }
     for (int entity_block = 0; entity_block < num_entity_blocks;
          ++entity_block) {
@@ -367,7 +387,7 @@ void read_internal(std::istream& stream, Mesh* mesh) {
       }
       int ent_type, num_block_ents;
       read(stream, ent_type, is_binary, needs_swapping);
-      read(stream, num_block_ents, is_binary, needs_swapping);
+      read_size(stream, num_block_ents, format, is_binary, needs_swapping);
       Int dim = type_dim(ent_type);
       OMEGA_H_CHECK(dim == class_dim);
       if (type_family(ent_type) == OMEGA_H_HYPERCUBE) {
@@ -381,10 +401,10 @@ void read_internal(std::istream& stream, Mesh* mesh) {
       for (int block_ent = 0; block_ent < num_block_ents; ++block_ent) {
         ent_class_ids[dim].push_back(class_id);
         int ent_number;
-        read(stream, ent_number, is_binary, needs_swapping);
+        read_size(stream, ent_number, format, is_binary, needs_swapping);
         for (int ent_node = 0; ent_node < nodes_per_ent; ++ent_node) {
           int node_number;
-          read(stream, node_number, is_binary, needs_swapping);
+          read_size(stream, node_number, format, is_binary, needs_swapping);
           auto it = node_number_map.find(node_number);
           OMEGA_H_CHECK(it != node_number_map.end());
           ent_nodes[dim].push_back(it->second);
@@ -533,6 +553,233 @@ Mesh read(filesystem::path const& filename, CommPtr comm) {
   return gmsh::read(file, comm);
 }
 
+namespace {
+
+/* a block of node or element records in a binary 4.1 file,
+   all of the same entity and type */
+struct SlicedBlock {
+  Int dim;
+  Int tag;
+  Int type;
+  GO size;
+  std::streamoff data;  // where its records start
+};
+
+template <typename T>
+void read_records(std::istream& stream, std::streamoff offset, T* data,
+    GO n, std::string const& what) {
+  stream.seekg(offset);
+  stream.read(
+      reinterpret_cast<char*>(data), std::streamsize(n * GO(sizeof(T))));
+  if (!stream) Omega_h_fail("could not read %s from Gmsh file\n", what.c_str());
+}
+
+/* reads the section headers and the block headers that follow them,
+   skipping over the records */
+std::vector<SlicedBlock> read_block_headers(std::istream& stream,
+    std::string const& section, bool needs_swapping, GO* p_nrecords,
+    GO* p_min_tag, GO* p_max_tag) {
+  seek_line(stream, section);
+  I64 nblocks, nrecords, min_tag, max_tag;
+  binary::read_value(stream, nblocks, needs_swapping);
+  binary::read_value(stream, nrecords, needs_swapping);
+  binary::read_value(stream, min_tag, needs_swapping);
+  binary::read_value(stream, max_tag, needs_swapping);
+  std::vector<SlicedBlock> blocks(static_cast<std::size_t>(nblocks));
+  for (auto& block : blocks) {
+    I32 parametric_or_type;
+    I64 size;
+    binary::read_value(stream, block.dim, needs_swapping);
+    binary::read_value(stream, block.tag, needs_swapping);
+    binary::read_value(stream, parametric_or_type, needs_swapping);
+    binary::read_value(stream, size, needs_swapping);
+    block.size = size;
+    block.data = stream.tellg();
+    GO record_words;
+    if (section == "$Nodes") {
+      if (parametric_or_type != 0) {
+        Omega_h_fail("Gmsh nodes with parametric coordinates are not "
+                     "supported\n");
+      }
+      block.type = GMSH_VERT;
+      // the tags of the block come first, then its coordinates
+      record_words = 4;
+    } else {
+      block.type = parametric_or_type;
+      record_words =
+          1 + element_degree(type_family(block.type), type_dim(block.type), 0);
+    }
+    stream.seekg(block.data + std::streamoff(size * record_words * 8));
+  }
+  OMEGA_H_CHECK(bool(stream));
+  *p_nrecords = nrecords;
+  *p_min_tag = min_tag;
+  *p_max_tag = max_tag;
+  return blocks;
+}
+
+}  // end anonymous namespace
+
+Mesh read_sliced(filesystem::path const& filename, CommPtr comm) {
+  ScopedTimer timer("gmsh::read_sliced");
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  if (!file.is_open()) {
+    Omega_h_fail("couldn't open \"%s\"\n", filename.c_str());
+  }
+  seek_line(file, "$MeshFormat");
+  Real format;
+  Int file_type;
+  Int data_size;
+  file >> format >> file_type >> data_size;
+  if (file_type != 1 || format < 4.1) {
+    file.close();
+    return gmsh::read(filename, comm);
+  }
+  OMEGA_H_CHECK(data_size == sizeof(I64));
+  eat_newlines(file);
+  bool needs_swapping = false;
+  {
+    int one;
+    binary::read_value(file, one, false);
+    if (one != 1) {
+      needs_swapping = true;
+      binary::swap_bytes(one);
+      OMEGA_H_CHECK(one == 1);
+    }
+  }
+  Mesh mesh(comm->library());
+  std::vector<std::string> physical_names;
+  if (seek_optional_section(file, "$PhysicalNames")) {
+    Int num_physicals;
+    file >> num_physicals;
+    for (auto i = 0; i < num_physicals; ++i) {
+      Int dim, number;
+      std::string name;
+      file >> dim >> number >> name;
+      physical_names.push_back(name.substr(1, name.size() - 2));
+    }
+  }
+  if (seek_optional_section(file, "$Entities")) {
+    read_internal_entities_section(
+        mesh, format, physical_names, file, true, needs_swapping);
+  }
+  /* every rank reads the block headers, then only the records of
+     its slice of the nodes and of the elements of highest dimension */
+  GO nnodes, min_node_tag, max_node_tag;
+  auto const node_blocks = read_block_headers(
+      file, "$Nodes", needs_swapping, &nnodes, &min_node_tag, &max_node_tag);
+  if (max_node_tag - min_node_tag + 1 != nnodes) {
+    Omega_h_fail("gmsh::read_sliced needs contiguous node tags\n");
+  }
+  GO nall_elems, min_elem_tag, max_elem_tag;
+  auto const elem_blocks = read_block_headers(file, "$Elements",
+      needs_swapping, &nall_elems, &min_elem_tag, &max_elem_tag);
+  Int dim = 0;
+  for (auto& block : elem_blocks) dim = std::max(dim, type_dim(block.type));
+  if (dim == 0) {
+    Omega_h_fail("There were no Elements of dimension higher than zero!\n");
+  }
+  auto family = OMEGA_H_SIMPLEX;
+  GO nelems = 0;
+  for (auto& block : elem_blocks) {
+    if (type_dim(block.type) != dim) continue;
+    if (nelems == 0) family = type_family(block.type);
+    OMEGA_H_CHECK(type_family(block.type) == family);
+    nelems += block.size;
+  }
+  auto const deg = element_degree(family, dim, VERT);
+  GO nodes_begin, nodes_end;
+  suggest_slices(nnodes, comm->size(), comm->rank(), &nodes_begin, &nodes_end);
+  auto const nslice_nodes = LO(nodes_end - nodes_begin);
+  HostWrite<GO> h_node_tags(nslice_nodes);
+  HostWrite<Real> h_coords(nslice_nodes * 3);
+  {
+    GO block_offset = 0;
+    LO slice_offset = 0;
+    for (auto& block : node_blocks) {
+      auto const begin = std::max(nodes_begin - block_offset, GO(0));
+      auto const end = std::min(nodes_end - block_offset, block.size);
+      block_offset += block.size;
+      if (end <= begin) continue;
+      read_records(file, block.data + std::streamoff(begin * 8),
+          h_node_tags.data() + slice_offset, end - begin, "node tags");
+      read_records(file,
+          block.data + std::streamoff((block.size + begin * 3) * 8),
+          h_coords.data() + slice_offset * 3, (end - begin) * 3,
+          "node coordinates");
+      slice_offset += LO(end - begin);
+    }
+    OMEGA_H_CHECK(slice_offset == nslice_nodes);
+  }
+  GO elems_begin, elems_end;
+  suggest_slices(nelems, comm->size(), comm->rank(), &elems_begin, &elems_end);
+  auto const nslice_elems = LO(elems_end - elems_begin);
+  HostWrite<GO> h_records(nslice_elems * (1 + deg));
+  Write<ClassId> slice_class_ids_w(nslice_elems);
+  {
+    GO block_offset = 0;
+    LO slice_offset = 0;
+    for (auto& block : elem_blocks) {
+      if (type_dim(block.type) != dim) continue;
+      auto const begin = std::max(elems_begin - block_offset, GO(0));
+      auto const end = std::min(elems_end - block_offset, block.size);
+      block_offset += block.size;
+      if (end <= begin) continue;
+      read_records(file, block.data + std::streamoff(begin * (1 + deg) * 8),
+          h_records.data() + slice_offset * (1 + deg),
+          (end - begin) * (1 + deg), "elements");
+      auto const class_id = block.tag;
+      auto const first = slice_offset;
+      auto f = OMEGA_H_LAMBDA(LO i) {
+        slice_class_ids_w[first + i] = class_id;
+      };
+      parallel_for(LO(end - begin), f, "set_elem_class_ids");
+      slice_offset += LO(end - begin);
+    }
+    OMEGA_H_CHECK(slice_offset == nslice_elems);
+  }
+  /* the records are decoded on the device, by as many threads as it has */
+  auto const node_tags =
+      binary::swap_bytes(GOs(h_node_tags.write()), needs_swapping);
+  auto const file_coords =
+      binary::swap_bytes(Reals(h_coords.write()), needs_swapping);
+  auto const records =
+      binary::swap_bytes(GOs(h_records.write()), needs_swapping);
+  Write<GO> slice_conn_w(nslice_elems * deg);
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    for (Int j = 0; j < deg; ++j) {
+      slice_conn_w[e * deg + j] = records[e * (1 + deg) + 1 + j] - min_node_tag;
+    }
+  };
+  parallel_for(nslice_elems, f, "decode_gmsh_elements");
+  /* the nodes were sliced in file order, but assemble_slices() wants
+     them sliced in the order of their tags */
+  auto const file_nodes2slice_nodes = Dist(comm,
+      globals_to_linear_owners(
+          comm, subtract_from_each(node_tags, min_node_tag), nnodes),
+      nslice_nodes);
+  auto const slice_coords = file_nodes2slice_nodes.exch(
+      resize_vectors(file_coords, 3, dim), dim);
+  Dist slice_elems2elems;
+  Dist slice_verts2verts;
+  LOs conn;
+  assemble_slices(comm, family, dim, nelems, elems_begin, GOs(slice_conn_w),
+      nnodes, nodes_begin, slice_coords, &slice_elems2elems, &conn,
+      &slice_verts2verts);
+  auto const slice_node_globals =
+      GOs{nslice_nodes, nodes_begin, 1, "slice node globals"};
+  auto const node_globals = slice_verts2verts.exch(slice_node_globals, 1);
+  build_from_elems2verts(&mesh, comm, family, dim, conn, node_globals);
+  mesh.add_coords(slice_verts2verts.exch(slice_coords, dim));
+  mesh.add_tag<ClassId>(dim, "class_id", 1,
+      slice_elems2elems.exch(Read<ClassId>(slice_class_ids_w), 1));
+  classify_elements(&mesh);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  finalize_classification(&mesh);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  return mesh;
+}
+
 #ifdef OMEGA_H_USE_GMSH
 
 Mesh read_parallel(filesystem::path filename, CommPtr comm) {
@@ -771,6 +1018,82 @@ void write(filesystem::path const& filepath, Mesh* mesh) {
   gmsh::write(stream, mesh);
 }
 
+void write_binary(std::ostream& stream, Mesh* mesh) {
+  OMEGA_H_CHECK(mesh->comm()->size() == 1);
+  stream << "$MeshFormat\n";
+  stream << "4.1 1 " << sizeof(I64) << '\n';
+  binary::write_value(stream, I32(1), false);
+  stream << "\n$EndMeshFormat\n";
+  stream << "$Nodes\n";
+  auto const nverts = mesh->nverts();
+  auto const dim = mesh->dim();
+  binary::write_value(stream, I64(1), false);
+  binary::write_value(stream, I64(nverts), false);
+  binary::write_value(stream, I64(1), false);
+  binary::write_value(stream, I64(nverts), false);
+  binary::write_value(stream, I32(dim), false);
+  binary::write_value(stream, I32(1), false);
+  binary::write_value(stream, I32(0), false);
+  binary::write_value(stream, I64(nverts), false);
+  for (LO i = 0; i < nverts; ++i) {
+    binary::write_value(stream, I64(i + 1), false);
+  }
+  auto const h_coords = HostRead<Real>(mesh->coords());
+  for (LO i = 0; i < nverts; ++i) {
+    for (Int j = 0; j < dim; ++j) {
+      binary::write_value(stream, h_coords[i * dim + j], false);
+    }
+    for (Int j = dim; j < 3; ++j) binary::write_value(stream, 0.0, false);
+  }
+  stream << "\n$EndNodes\n";
+  stream << "$Elements\n";
+  auto const family = mesh->family();
+  // one block per model entity, as Gmsh writes them
+  std::array<std::map<ClassId, std::vector<LO>>, 4> blocks;
+  I64 nblocks = 0;
+  I64 gmsh_nelems = 0;
+  for (Int ent_dim = VERT; ent_dim <= dim; ++ent_dim) {
+    auto const h_class_ids =
+        HostRead<ClassId>(mesh->get_array<ClassId>(ent_dim, "class_id"));
+    auto const h_class_dims =
+        HostRead<Byte>(mesh->get_array<Byte>(ent_dim, "class_dim"));
+    for (LO i = 0; i < mesh->nents(ent_dim); ++i) {
+      if (h_class_dims[i] != ent_dim) continue;
+      blocks[std::size_t(ent_dim)][h_class_ids[i]].push_back(i);
+      ++gmsh_nelems;
+    }
+    nblocks += I64(blocks[std::size_t(ent_dim)].size());
+  }
+  binary::write_value(stream, nblocks, false);
+  binary::write_value(stream, gmsh_nelems, false);
+  binary::write_value(stream, I64(1), false);
+  binary::write_value(stream, gmsh_nelems, false);
+  I64 gmsh_elem_i = 0;
+  for (Int ent_dim = VERT; ent_dim <= dim; ++ent_dim) {
+    auto const h_ents2verts = HostRead<LO>(mesh->ask_verts_of(ent_dim));
+    auto const deg = element_degree(family, ent_dim, VERT);
+    for (auto const& block : blocks[std::size_t(ent_dim)]) {
+      binary::write_value(stream, I32(ent_dim), false);
+      binary::write_value(stream, I32(block.first), false);
+      binary::write_value(stream, I32(gmsh_type(family, ent_dim)), false);
+      binary::write_value(stream, I64(block.second.size()), false);
+      for (auto i : block.second) {
+        binary::write_value(stream, ++gmsh_elem_i, false);
+        for (Int j = 0; j < deg; ++j) {
+          auto const node = I64(h_ents2verts[i * deg + j] + 1);
+          binary::write_value(stream, node, false);
+        }
+      }
+    }
+  }
+  stream << "\n$EndElements\n";
+}
+
+void write_binary(filesystem::path const& filepath, Mesh* mesh) {
+  std::ofstream stream(filepath.c_str(), std::ios::binary);
+  gmsh::write_binary(stream, mesh);
+}
+
 #ifdef OMEGA_H_USE_GMSH
 
 void write_parallel(filesystem::path const& filename, Mesh& mesh) {
@@ -0,0 +1,51 @@
+#ifndef OMEGA_H_HALO_HPP
+#define OMEGA_H_HALO_HPP
+
+#include <Omega_h_for.hpp>
+#include <Omega_h_mesh.hpp>
+
+namespace Omega_h {
+
+template <typename F>
+void parallel_for_each(LOs ents, F const& f, char const* name = "") {
+  auto g = OMEGA_H_LAMBDA(LO i) { f(ents[i]); };
+  parallel_for(ents.size(), g, name);
+}
+
+/* fills out, which has width values per entity of dimension ent_dim,
+   by calling f(e) for each entity e owned here, and synchronizes it
+   while f is still running:
+   f first runs over the boundary entities, whose values other ranks
+   are waiting for, then isync_array() sends them while f runs over
+   the interior, and finally the unowned entities are filled in from
+   what arrived.
+   f must only write the values of the entity it was given, and only
+   read values that were synchronized before this call. */
+template <typename T, typename F>
+Read<T> compute_and_sync(Mesh* mesh, Int ent_dim, Write<T> out, Int width,
+    F const& f, char const* name = "") {
+  OMEGA_H_CHECK(out.size() == mesh->nents(ent_dim) * width);
+  auto const split = mesh->ask_halo_split(ent_dim);
+  if (!mesh->could_be_shared(ent_dim)) {
+    parallel_for_each(split.interior, f, name);
+    return out;
+  }
+  parallel_for_each(split.boundary, f, name);
+  /* the Dist expands owners to their copies before sending,
+     so writing the interior of out below does not touch
+     the buffers in flight */
+  auto future = mesh->isync_array(ent_dim, Read<T>(out), width);
+  parallel_for_each(split.interior, f, name);
+  auto const synced = future.get();
+  auto const unowned = split.unowned;
+  auto fill = OMEGA_H_LAMBDA(LO i) {
+    auto const e = unowned[i];
+    for (Int j = 0; j < width; ++j) out[e * width + j] = synced[e * width + j];
+  };
+  parallel_for(unowned.size(), fill, name);
+  return out;
+}
+
+}  // end namespace Omega_h
+
+#endif
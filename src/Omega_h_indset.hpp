@@ -8,10 +8,18 @@ namespace Omega_h {
 
 class Mesh;
 
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Graph graph, Reals quality, Read<I8> candidates);
-Read<I8> find_indset(
-    Mesh* mesh, Int ent_dim, Reals quality, Read<I8> candidates);
+/* what one search for an independent set communicated on this rank:
+   rounds of synchronization, each also taking a global reduction,
+   and the bytes received, counting those a rank sends itself */
+struct IndsetStats {
+  Int rounds = 0;
+  GO bytes = 0;
+};
+
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Graph graph, Reals quality,
+    Read<I8> candidates, IndsetStats* stats = nullptr);
+Read<I8> find_indset(Mesh* mesh, Int ent_dim, Reals quality,
+    Read<I8> candidates, IndsetStats* stats = nullptr);
 
 }  // end namespace Omega_h
 
@@ -4,44 +4,87 @@
 #include <Omega_h_array_ops.hpp>
 #include <Omega_h_for.hpp>
 #include <Omega_h_indset.hpp>
+#include <Omega_h_map.hpp>
 #include <Omega_h_mesh.hpp>
+#include <Omega_h_random.hpp>
 
 namespace Omega_h {
 namespace indset {
 
 enum { NOT_IN, IN, UNKNOWN };
 
+/* ties in quality are broken by a random number drawn from the global
+   ID rather than by the ID itself, which would decide runs of equal
+   quality one node per round, in order of their IDs */
+struct QualityCompare {
+  Reals quality;
+  Reals tiebreak;
+  GOs global;
+  QualityCompare() = default;
+  QualityCompare(Reals quality_in, GOs global_in)
+      : quality(quality_in),
+        tiebreak(unit_uniform_random_reals_from_globals(global_in, 0, 0)),
+        global(global_in) {}
+  OMEGA_H_DEVICE bool operator()(LO u, LO v) const {
+    auto const v_qual = quality[v];
+    auto const u_qual = quality[u];
+    if (u_qual != v_qual) return u_qual < v_qual;
+    if (tiebreak[u] != tiebreak[v]) return tiebreak[u] < tiebreak[v];
+    // neighbor has equal quality and random number, tiebreaker by global ID
+    return global[u] < global[v];
+  }
+};
+
+template <class Compare>
+OMEGA_H_DEVICE void decide(LOs const& xadj, LOs const& adj,
+    Read<I8> const& old_state, Write<I8> const& new_state,
+    Compare const& compare, LO v) {
+  if (old_state[v] != UNKNOWN) return;
+  auto begin = xadj[v];
+  auto end = xadj[v + 1];
+  // nodes adjacent to chosen ones are rejected
+  for (auto j = begin; j < end; ++j) {
+    auto u = adj[j];
+    if (old_state[u] == IN) {
+      new_state[v] = NOT_IN;
+      return;
+    }
+  }
+  // check if node is a local maximum
+  for (auto j = begin; j < end; ++j) {
+    auto u = adj[j];
+    // neighbor was rejected, ignore its presence
+    if (old_state[u] == NOT_IN) continue;
+    if (!compare(u, v)) return;
+  }
+  // only local maxima reach this line
+  new_state[v] = IN;
+}
+
 template <class Compare>
 inline Read<I8> local_iteration(
     LOs xadj, LOs adj, Read<I8> old_state, Compare compare) {
   auto n = xadj.size() - 1;
   Write<I8> new_state = deep_copy(old_state);
   auto f = OMEGA_H_LAMBDA(LO v) {
-    if (old_state[v] != UNKNOWN) return;
-    auto begin = xadj[v];
-    auto end = xadj[v + 1];
-    // nodes adjacent to chosen ones are rejected
-    for (auto j = begin; j < end; ++j) {
-      auto u = adj[j];
-      if (old_state[u] == IN) {
-        new_state[v] = NOT_IN;
-        return;
-      }
-    }
-    // check if node is a local maximum
-    for (auto j = begin; j < end; ++j) {
-      auto u = adj[j];
-      // neighbor was rejected, ignore its presence
-      if (old_state[u] == NOT_IN) continue;
-      if (!compare(u, v)) return;
-    }
-    // only local maxima reach this line
-    new_state[v] = IN;
+    decide(xadj, adj, old_state, new_state, compare, v);
   };
   parallel_for(n, std::move(f));
   return new_state;
 }
 
+/* decides only the given nodes, leaving the others as they were */
+template <class Compare>
+inline Read<I8> local_iteration(
+    LOs xadj, LOs adj, LOs nodes, Read<I8> old_state, Compare compare) {
+  Write<I8> new_state = deep_copy(old_state);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    decide(xadj, adj, old_state, new_state, compare, nodes[i]);
+  };
+  parallel_for(nodes.size(), std::move(f));
+  return new_state;
+}
+
 template <class Compare>
 Read<I8> iteration(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> old_state,
     Compare compare) {
@@ -50,23 +93,72 @@ Read<I8> iteration(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> old_state,
   return synced_state;
 }
 
-template <class Compare>
-Read<I8> find(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> candidates,
-    Compare compare) {
-  auto n = xadj.size() - 1;
-  OMEGA_H_CHECK(candidates.size() == n);
-  auto initial_state = Write<I8>(n);
+inline Read<I8> initial_state(Read<I8> candidates) {
+  auto initial_state = Write<I8>(candidates.size());
   auto f = OMEGA_H_LAMBDA(LO i) {
     if (candidates[i])
       initial_state[i] = UNKNOWN;
     else
       initial_state[i] = NOT_IN;
   };
-  parallel_for(n, f);
+  parallel_for(candidates.size(), f);
+  return initial_state;
+}
+
+/* synchronizes every entity after every round of decisions */
+template <class Compare>
+Read<I8> find_synced(Mesh* mesh, Int dim, LOs xadj, LOs adj,
+    Read<I8> candidates, Compare compare, IndsetStats* stats = nullptr) {
+  auto n = xadj.size() - 1;
+  OMEGA_H_CHECK(candidates.size() == n);
   auto comm = mesh->comm();
-  auto state = Read<I8>(initial_state);
+  auto state = initial_state(candidates);
   while (get_max(comm, state) == UNKNOWN) {
     state = iteration(mesh, dim, xadj, adj, state, compare);
+    if (stats && mesh->could_be_shared(dim)) {
+      ++stats->rounds;
+      stats->bytes += n;
+    }
+  }
+  return state;
+}
+
+/* each node joins the set once it beats all its undecided neighbors,
+   which are the ones decided later in the greedy order of compare,
+   so the set does not depend on how many rounds were taken.
+   a neighbor that looks undecided may already have been decided
+   on another rank, and that only delays the decision, so the nodes
+   owned here are decided as far as they can be before any
+   communication, and then only the unowned copies are updated */
+template <class Compare>
+Read<I8> find(Mesh* mesh, Int dim, LOs xadj, LOs adj, Read<I8> candidates,
+    Compare compare, IndsetStats* stats = nullptr) {
+  auto n = xadj.size() - 1;
+  OMEGA_H_CHECK(candidates.size() == n);
+  auto state = initial_state(candidates);
+  if (!mesh->could_be_shared(dim)) {
+    while (get_max(state) == UNKNOWN) {
+      state = local_iteration(xadj, adj, state, compare);
+    }
+    return state;
+  }
+  auto comm = mesh->comm();
+  auto const split = mesh->ask_halo_split(dim);
+  auto const owned = collect_marked(mesh->owned(dim));
+  while (get_max(comm, state) == UNKNOWN) {
+    while (true) {
+      auto const next = local_iteration(xadj, adj, owned, state, compare);
+      if (next == state) break;
+      state = next;
+    }
+    auto const received = split.owners2unowned.exch(state, 1);
+    auto const synced = deep_copy(state);
+    map_into(received, split.unowned, synced, 1);
+    state = synced;
+    if (stats) {
+      ++stats->rounds;
+      stats->bytes += split.unowned.size();
+    }
   }
   return state;
 }
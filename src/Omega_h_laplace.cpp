@@ -4,7 +4,7 @@
 #include <iostream>
 
 #include "Omega_h_array_ops.hpp"
-#include "Omega_h_map.hpp"
+#include "Omega_h_halo.hpp"
 #include "Omega_h_mark.hpp"
 #include "Omega_h_mesh.hpp"
 
@@ -18,18 +18,29 @@ Reals solve_laplacian(
   auto state = initial;
   auto star = mesh->ask_star(VERT);
   auto interior = mark_by_class_dim(mesh, VERT, mesh->dim());
-  auto boundary = invert_marks(interior);
-  auto b2v = collect_marked(boundary);
-  auto weights = Reals(star.ab2b.size(), 1.0);
-  auto bc_data = read(unmap(b2v, initial, width));
   bool done = false;
   Int niters = 0;
   do {
-    auto new_state_nobc = graph_weighted_average(star, weights, state, width);
-    auto new_state_w = deep_copy(new_state_nobc);
-    map_into(bc_data, b2v, new_state_w, width);
-    auto new_state = Reals(new_state_w);
-    new_state = mesh->sync_array(VERT, new_state, width);
+    /* each vertex not on the boundary takes the average
+       of its neighbors, the boundary keeps its initial values */
+    Write<Real> new_state_w(state.size());
+    auto f = OMEGA_H_LAMBDA(LO v) {
+      auto const begin = star.a2ab[v];
+      auto const end = star.a2ab[v + 1];
+      for (Int j = 0; j < width; ++j) {
+        if (!interior[v]) {
+          new_state_w[v * width + j] = initial[v * width + j];
+          continue;
+        }
+        Real sum = 0.0;
+        for (auto vv = begin; vv < end; ++vv) {
+          sum += state[star.ab2b[vv] * width + j];
+        }
+        new_state_w[v * width + j] = sum / Real(end - begin);
+      }
+    };
+    auto new_state = compute_and_sync(mesh, VERT, new_state_w, width, f,
+        "solve_laplacian");
     auto local_done = are_close(state, new_state, tol, floor);
     done = comm->reduce_and(local_done);
     state = new_state;
@@ -1,8 +1,11 @@
 #include <Omega_h_config.h>
 #include <Omega_h_cmdline.hpp>
+#include <Omega_h_for.hpp>
 #include <Omega_h_library.hpp>
 #include <Omega_h_malloc.hpp>
 #include <Omega_h_profile.hpp>
+#include <Omega_h_shared_alloc.hpp>
+#include <Omega_h_trace.hpp>
 #include <Omega_h_dbg.hpp>
 
 #include <csignal>
@@ -104,14 +107,28 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
       "--osh-time-chop", "only print functions whose percent time is greater than given value (e.g. --osh-time-chop=2)");
   osh_time_chop_flag.add_arg<double>("0.0");
   cmdline.add_flag("--osh-time-with-filename", "add file name to function name in profile output");
+  auto& osh_trace_flag = cmdline.add_flag("--osh-trace",
+      "record a timeline of timed functions and allocations into (prefix).(rank).ohtrace");
+  osh_trace_flag.add_arg<std::string>("prefix");
+  cmdline.add_flag("--osh-trace-json",
+      "also write each rank's timeline as Chrome trace-event JSON");
 
   cmdline.add_flag("--osh-signal", "catch signals and print a stacktrace");
   cmdline.add_flag("--osh-fpe", "enable floating-point exceptions");
   cmdline.add_flag("--osh-silent", "suppress all output");
   cmdline.add_flag("--osh-pool", "use memory pooling");
+  cmdline.add_flag(
+      "--osh-arena", "reuse temporary arrays within adaptation passes");
+  cmdline.add_flag("--osh-hash-matching",
+      "match new entities to their boundaries with a hash table");
+  auto& schedule_flag = cmdline.add_flag("--osh-schedule",
+      "per-kernel OpenMP schedules (e.g. coarsen_qualities=dynamic:64)");
+  schedule_flag.add_arg<std::string>("policies");
   auto& self_send_flag =
       cmdline.add_flag("--osh-self-send", "control self send threshold");
   self_send_flag.add_arg<int>("value");
+  cmdline.add_flag("--osh-node-aware",
+      "exchange through shared memory between ranks of the same node");
   auto& mpi_ranks_flag =
       cmdline.add_flag("--osh-mpi-ranks-per-node", "mpi ranks per node (for CUDA+MPI)");
   mpi_ranks_flag.add_arg<int>("value");
@@ -131,6 +148,11 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
     Omega_h::profile::global_singleton_history =
       new Omega_h::profile::History(world_, true, chop, add_filename);
   }
+  if (cmdline.parsed("--osh-trace")) {
+    Omega_h::profile::global_trace = new Omega_h::profile::Trace(world_,
+        cmdline.get<std::string>("--osh-trace", "prefix"),
+        cmdline.parsed("--osh-trace-json"));
+  }
   if (cmdline.parsed("--osh-fpe")) {
     enable_floating_point_exceptions();
   }
@@ -138,7 +160,18 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
   if (cmdline.parsed("--osh-self-send")) {
     self_send_threshold_ = cmdline.get<int>("--osh-self-send", "value");
   }
+  if (auto const policies = std::getenv("OMEGA_H_SCHEDULE")) {
+    set_for_policies(policies);
+  }
+  if (cmdline.parsed("--osh-schedule")) {
+    set_for_policies(
+        cmdline.get<std::string>("--osh-schedule", "policies").c_str());
+  }
+  if (cmdline.parsed("--osh-node-aware")) world_->enable_node_aware();
   silent_ = cmdline.parsed("--osh-silent");
+  default_matching_ = cmdline.parsed("--osh-hash-matching")
+                          ? OMEGA_H_MATCH_BY_HASH
+                          : OMEGA_H_MATCH_BY_UPWARD;
 #ifdef OMEGA_H_USE_KOKKOS
   if (!Kokkos::is_initialized()) {
     if(argv != nullptr && argc != nullptr) {
@@ -175,10 +208,13 @@ void Library::initialize(char const* head_desc, int* argc, char*** argv
   cudaFree(nullptr);
 #endif
   if (cmdline.parsed("--osh-pool")) enable_pooling();
+  if (cmdline.parsed("--osh-arena")) enable_arena();
+  if (cmdline.parsed("--osh-memory")) start_tracking_allocations();
 }
 
 Library::Library(Library const& other)
-    : world_(other.world_),
+    : default_matching_(other.default_matching_),
+      world_(other.world_),
       self_(other.self_)
 #ifdef OMEGA_H_USE_MPI
       ,
@@ -192,22 +228,32 @@ Library::Library(Library const& other)
 }
 
 Library::~Library() {
+  if (Omega_h::profile::global_trace) {
+    auto const trace = Omega_h::profile::global_trace;
+    Omega_h::profile::global_trace = nullptr;
+    trace->finish();
+    delete trace;
+  }
   if (Omega_h::profile::global_singleton_history) {
     double total_runtime = now() - Omega_h::profile::global_singleton_history->start_time;
     if (world_->rank() == 0) {
       // FIXME - parallelize?
       Omega_h::profile::print_top_down_and_bottom_up(
           *Omega_h::profile::global_singleton_history, total_runtime);
+      Omega_h::profile::print_imbalance(
+          *Omega_h::profile::global_singleton_history);
     }
     Omega_h::profile::print_top_sorted(
           *Omega_h::profile::global_singleton_history, total_runtime);
     delete Omega_h::profile::global_singleton_history;
     Omega_h::profile::global_singleton_history = nullptr;
   }
+  if (global_allocs) stop_tracking_allocations(this);
   // need to destroy all Comm objects prior to MPI_Finalize()
   world_ = CommPtr();
   self_ = CommPtr();
   disable_pooling();
+  disable_arena();
 #ifdef OMEGA_H_USE_KOKKOS
   if (we_called_kokkos_init) {
     KokkosPool::destroyGlobalPool();
@@ -239,4 +285,8 @@ CommPtr Library::self() {
 
 LO Library::self_send_threshold() const { return self_send_threshold_; }
 
+Omega_h_Matching Library::default_matching() const {
+  return default_matching_;
+}
+
 }  // end namespace Omega_h
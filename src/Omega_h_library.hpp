@@ -36,6 +36,8 @@ class Library {
   void add_to_timer(std::string const& name, double nsecs);
   LO self_send_threshold() const;
   LO self_send_threshold_;
+  Omega_h_Matching default_matching() const;
+  Omega_h_Matching default_matching_;
   bool silent_;
   std::vector<std::string> argv_;
 
@@ -1,7 +1,9 @@
+#include <Omega_h_arena.hpp>
 #include <Omega_h_fail.hpp>
 #include <Omega_h_malloc.hpp>
 #include <Omega_h_pool.hpp>
 #include <Omega_h_profile.hpp>
+#include <Omega_h_shared_alloc.hpp>
 #include <cstdlib>
 
 namespace Omega_h {
@@ -77,14 +79,62 @@ void disable_pooling() {
 
 bool is_pooling_enabled() { return pooling_enabled; }
 
+static Arena* device_arena = nullptr;
+
+struct OpenPhase {
+  std::string name;
+  ArenaStats stats_at_begin;
+};
+
+static std::vector<OpenPhase> open_phases;
+
+void enable_arena() {
+  OMEGA_H_CHECK(device_arena == nullptr);
+  device_arena = new Arena(device_malloc, device_free);
+}
+
+void disable_arena() {
+  delete device_arena;
+  device_arena = nullptr;
+  open_phases.clear();
+}
+
+bool is_arena_enabled() { return device_arena != nullptr; }
+
+std::size_t arena_cached_bytes() {
+  if (!device_arena) return 0;
+  return device_arena->cached_bytes;
+}
+
+void begin_arena_phase(char const* name) {
+  if (!device_arena) return;
+  open_phases.push_back({name, get_stats(*device_arena)});
+  begin_phase(*device_arena);
+}
+
+void end_arena_phase() {
+  if (!device_arena) return;
+  end_phase(*device_arena);
+  auto const& phase = open_phases.back();
+  auto const stats = get_stats(*device_arena) - phase.stats_at_begin;
+  if (global_allocs) {
+    global_allocs->phase_records.push_back({phase.name, stats.allocations,
+        stats.reused_allocations, stats.reused_bytes, stats.released_bytes});
+  }
+  open_phases.pop_back();
+}
+
 void* maybe_pooled_device_malloc(std::size_t size) {
   if (device_pool) return allocate(*device_pool, size);
+  if (device_arena) return allocate(*device_arena, size);
   return device_malloc(size);
 }
 
 void maybe_pooled_device_free(void* ptr, std::size_t size) {
   if (device_pool)
     deallocate(*device_pool, ptr, size);
+  else if (device_arena)
+    deallocate(*device_arena, ptr, size);
   else
     device_free(ptr, size);
 }
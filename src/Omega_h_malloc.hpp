@@ -15,6 +15,28 @@ void disable_pooling();
 
 bool is_pooling_enabled();
 
+void enable_arena();
+void disable_arena();
+
+bool is_arena_enabled();
+std::size_t arena_cached_bytes();
+
+/* While a phase is open, arrays freed by SharedAlloc are kept in the
+   arena and reused by later allocations of the same size class.
+   Closing the outermost phase releases them all at once.
+   These are no-ops unless the arena is enabled. */
+void begin_arena_phase(char const* name);
+void end_arena_phase();
+
+struct ScopedArenaPhase {
+  ScopedArenaPhase(char const* name) { begin_arena_phase(name); }
+  ~ScopedArenaPhase() { end_arena_phase(); }
+  ScopedArenaPhase(ScopedArenaPhase const&) = delete;
+  ScopedArenaPhase(ScopedArenaPhase&&) = delete;
+  ScopedArenaPhase& operator=(ScopedArenaPhase const&) = delete;
+  ScopedArenaPhase& operator=(ScopedArenaPhase&&) = delete;
+};
+
 void* maybe_pooled_device_malloc(std::size_t size);
 void maybe_pooled_device_free(void* ptr, std::size_t size);
 void* maybe_pooled_host_malloc(std::size_t size);
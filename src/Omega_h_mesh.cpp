@@ -6,6 +6,7 @@
 
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_bcast.hpp"
+#include "Omega_h_cavity_cache.hpp"
 #include "Omega_h_compare.hpp"
 #include "Omega_h_element.hpp"
 #include "Omega_h_for.hpp"
@@ -15,6 +16,7 @@
 #include "Omega_h_mark.hpp"
 #include "Omega_h_migrate.hpp"
 #include "Omega_h_quality.hpp"
+#include "Omega_h_repartition.hpp"
 #include "Omega_h_shape.hpp"
 #include "Omega_h_timer.hpp"
 #include "Omega_h_int_scan.hpp"
@@ -30,10 +32,14 @@ Mesh::Mesh() {
   dim_ = -1;
   for (Int i = 0; i <= 3; ++i) nents_[i] = -1;
   for (Int i = 0; i <= 7; ++i) nents_type_[i] = -1;
+  for (Int i = 0; i <= 3; ++i) {
+    for (Int j = 0; j <= 3; ++j) adjs_patched_[i][j] = false;
+  }
   parting_ = -1;
   nghost_layers_ = -1;
   library_ = nullptr;
   matched_ = -1;
+  matching_ = OMEGA_H_MATCH_BY_UPWARD;
 }
 
 Mesh::Mesh(Library* library_in) : Mesh() { set_library(library_in); }
@@ -41,6 +47,7 @@ Mesh::Mesh(Library* library_in) : Mesh() { set_library(library_in); }
 void Mesh::set_library(Library* library_in) {
   OMEGA_H_CHECK(library_in != nullptr);
   library_ = library_in;
+  matching_ = library_in->default_matching();
 }
 
 Library* Mesh::library() const { return library_; }
@@ -75,12 +82,15 @@ void Mesh::set_comm(CommPtr const& new_comm) {
     }
   }
   comm_ = new_comm;
+  for (auto& split : halo_splits_) split.reset();
 }
 
 void Mesh::set_family(Omega_h_Family family_in) { family_ = family_in; }
 
 void Mesh::set_matched(I8 is_matched) { matched_ = is_matched; }
 
+void Mesh::set_matching(Omega_h_Matching matching) { matching_ = matching; }
+
 void Mesh::set_dim(Int dim_in) {
   OMEGA_H_CHECK(dim_ == -1);
   OMEGA_H_CHECK(dim_in >= 1);
@@ -117,6 +127,7 @@ void Mesh::set_ents(Int ent_dim, Adj down) {
   auto deg = element_degree(family(), ent_dim, ent_dim - 1);
   nents_[ent_dim] = divide_no_remainder(hl2l.size(), deg);
   add_adj(ent_dim, ent_dim - 1, down);
+  ghost_cache_.reset();
 }
 
 void Mesh::set_model_ents(Int ent_dim, LOs Ids) {
@@ -313,6 +324,7 @@ void Mesh::react_to_set_tag(Int ent_dim, std::string const& name) {
   if ((ent_dim == VERT) && (is_coordinates || (name == "metric"))) {
     remove_tag(EDGE, "length");
     remove_tag(dim(), "quality");
+    remove_cavity_caches(this);
   }
   if ((ent_dim == VERT) && is_coordinates) {
     remove_tag(dim(), "size");
@@ -492,6 +504,17 @@ Adj Mesh::ask_up(Topo_type from_type, Topo_type to_type) {
   return ask_adj(from_type, to_type);
 }
 
+void Mesh::add_patched_adj(Int from, Int to, Adj adj) {
+  add_adj(from, to, adj);
+  adjs_patched_[from][to] = true;
+}
+
+bool Mesh::adj_is_patched(Int from, Int to) const {
+  check_dim(from);
+  check_dim(to);
+  return has_adj(from, to) && adjs_patched_[from][to];
+}
+
 Graph Mesh::ask_star(Int ent_dim) {
   OMEGA_H_CHECK(ent_dim < dim());
   return ask_adj(ent_dim, ent_dim);
@@ -580,6 +603,7 @@ void Mesh::add_adj(Int from, Int to, Adj adj) {
     OMEGA_H_CHECK(adj.a2ab.size() == nents(from) + 1);
   }
   adjs_[from][to] = std::make_shared<Adj>(adj);
+  adjs_patched_[from][to] = false;
 }
 
 void Mesh::add_adj(Topo_type from_type, Topo_type to_type, Adj adj) {
@@ -622,6 +646,14 @@ Adj Mesh::derive_adj(Int from, Int to) {
     return up;
   } else if (to < from) {
     OMEGA_H_CHECK(to + 1 < from);
+    /* the vertices of `from` are themselves derived through
+       from->(to+1) when not stored, so only match by hash once
+       they are known, otherwise the two derivations recurse */
+    if (matching_ == OMEGA_H_MATCH_BY_HASH && to > VERT &&
+        has_adj(from, VERT)) {
+      return reflect_down_by_hash(
+          ask_verts_of(from), ask_verts_of(to), family_, from, to);
+    }
     Adj h2m = ask_adj(from, to + 1);
     Adj m2l = ask_adj(to + 1, to);
     Adj h2l = transit(h2m, m2l, family_, from, to);
@@ -697,6 +729,7 @@ Adj Mesh::ask_adj(Int from, Int to) {
   }
   Adj derived = derive_adj(from, to);
   adjs_[from][to] = std::make_shared<Adj>(derived);
+  adjs_patched_[from][to] = false;
   return derived;
 }
 
@@ -813,6 +846,8 @@ void Mesh::set_owners(Int ent_dim, Remotes owners) {
   OMEGA_H_CHECK(nents(ent_dim) == owners.idxs.size());
   owners_[ent_dim] = owners;
   dists_[ent_dim] = DistPtr();
+  halo_splits_[ent_dim].reset();
+  ghost_cache_.reset();
 }
 
 void Mesh::set_match_owners(Int ent_dim, Remotes match_owners) {
@@ -861,11 +896,49 @@ Dist Mesh::ask_dist(Int ent_dim) {
     auto owners = ask_owners(ent_dim);
     OMEGA_H_CHECK(owners.ranks.exists());
     OMEGA_H_CHECK(owners.idxs.exists());
-    dists_[ent_dim] = std::make_shared<Dist>(comm_, owners, nents(ent_dim));
+    Dist dist(comm_, owners, nents(ent_dim));
+    /* sync_array() and reduce_array() go through this Dist
+       until the owners change */
+    dist.persist();
+    dists_[ent_dim] = std::make_shared<Dist>(dist);
   }
   return *(dists_[ent_dim]);
 }
 
+HaloSplit Mesh::ask_halo_split(Int ent_dim) {
+  check_dim2(ent_dim);
+  if (!halo_splits_[ent_dim]) {
+    auto split = std::make_shared<HaloSplit>();
+    auto const n = nents(ent_dim);
+    if (!could_be_shared(ent_dim)) {
+      split->interior = LOs(n, 0, 1);
+      split->boundary = LOs({});
+      split->unowned = LOs({});
+    } else {
+      auto const is_owned = owned(ent_dim);
+      auto const owners2copies = ask_dist(ent_dim).invert().roots2items();
+      Write<I8> is_interior(n);
+      Write<I8> is_boundary(n);
+      auto f = OMEGA_H_LAMBDA(LO e) {
+        auto const ncopies = owners2copies[e + 1] - owners2copies[e];
+        is_interior[e] = is_owned[e] && ncopies == 1;
+        is_boundary[e] = is_owned[e] && ncopies > 1;
+      };
+      parallel_for(n, f, "ask_halo_split");
+      split->interior = collect_marked(read(is_interior));
+      split->boundary = collect_marked(read(is_boundary));
+      split->unowned = collect_marked(invert_marks(is_owned));
+      auto const owners = ask_owners(ent_dim);
+      auto const unowned2owners =
+          Remotes(unmap(split->unowned, owners.ranks, 1),
+              unmap(split->unowned, owners.idxs, 1));
+      split->owners2unowned = Dist(comm_, unowned2owners, n).invert();
+    }
+    halo_splits_[ent_dim] = split;
+  }
+  return *(halo_splits_[ent_dim]);
+}
+
 Omega_h_Parting Mesh::parting() const {
   OMEGA_H_CHECK(parting_ != -1);
   return Omega_h_Parting(parting_);
@@ -897,22 +970,63 @@ void Mesh::set_parting(Omega_h_Parting parting_in, Int nlayers, bool verbose) {
   if (parting_ == parting_in && nghost_layers_ == nlayers) {
     return;
   }
+  auto const count_ents = [this]() {
+    GO n = 0;
+    for (Int d = 0; d <= dim(); ++d) n += nents(d);
+    return n;
+  };
+  auto stats = parting_stats_;
   if (parting_in == OMEGA_H_ELEM_BASED) {
     OMEGA_H_CHECK(nlayers == 0);
-    if (comm_->size() > 1) partition_by_elems(this, verbose);
+    ghost_cache_.reset();
+    if (comm_->size() > 1) {
+      if (parting_ == OMEGA_H_GHOSTED && is_matched() <= 0 &&
+          !has_any_parents()) {
+        auto const nghost_layers = nghost_layers_;
+        auto cache = drop_ghosts(this);
+        ghost_cache_ = (nghost_layers == 1) ? cache : nullptr;
+        stats.kept += count_ents();
+      } else {
+        partition_by_elems(this, verbose);
+        stats.migrated += count_ents();
+      }
+    }
   } else if (parting_in == OMEGA_H_GHOSTED) {
     if (parting_ != OMEGA_H_GHOSTED || nlayers < nghost_layers_) {
       set_parting(OMEGA_H_ELEM_BASED, 0, false);
+      stats = parting_stats_;
+    }
+    /* only good for this change, and freed before migrating */
+    auto cache = std::move(ghost_cache_);
+    ghost_cache_.reset();
+    if (comm_->size() > 1) {
+      if (nlayers == 1 && parting_ == OMEGA_H_ELEM_BASED && cache &&
+          reuse_ghosts(this, *cache)) {
+        stats.kept += count_ents();
+      } else {
+        cache.reset();
+        ghost_mesh(this, nlayers, verbose);
+        stats.migrated += count_ents();
+      }
     }
-    if (comm_->size() > 1) ghost_mesh(this, nlayers, verbose);
   } else if (parting_in == OMEGA_H_VERT_BASED) {
     OMEGA_H_CHECK(nlayers == 1);
-    if (comm_->size() > 1) partition_by_verts(this, verbose);
+    ghost_cache_.reset();
+    if (comm_->size() > 1) {
+      partition_by_verts(this, verbose);
+      stats.migrated += count_ents();
+    }
   }
+  parting_stats_ = stats;
   parting_ = parting_in;
   nghost_layers_ = nlayers;
+  for (auto& split : halo_splits_) split.reset();
 }
 
+PartingStats Mesh::parting_stats() const { return parting_stats_; }
+
+void Mesh::drop_ghost_cache() { ghost_cache_.reset(); }
+
 void Mesh::set_parting(Omega_h_Parting parting_in, bool verbose) {
   if (parting_in == OMEGA_H_ELEM_BASED)
     set_parting(parting_in, 0, verbose);
@@ -1189,6 +1303,47 @@ void Mesh::reduce_tag(Int ent_dim, std::string const& name, Omega_h_Op op) {
     }
   }
 }
+DistBatch Mesh::sync_arrays(Int ent_dim, DistBatch const& arrays) {
+  OMEGA_H_TIME_FUNCTION;
+  check_dim2(ent_dim);
+  if (!could_be_shared(ent_dim)) return arrays;
+  return ask_dist(ent_dim).invert().exch(arrays);
+}
+DistBatch Mesh::reduce_arrays(Int ent_dim, DistBatch const& arrays) {
+  check_dim2(ent_dim);
+  if (!could_be_shared(ent_dim)) return arrays;
+  return ask_dist(ent_dim).exch_reduce(arrays);
+}
+static DistBatch batch_tags(Mesh* mesh, Int ent_dim,
+    std::vector<std::string> const& names, Omega_h_Op op) {
+  DistBatch batch;
+  for (auto& name : names) {
+    auto tagbase = mesh->get_tagbase(ent_dim, name);
+    apply_to_omega_h_types(tagbase->type(), [&](auto t) {
+      using T = decltype(t);
+      batch.add(as<T>(tagbase)->array(), tagbase->ncomps(), op);
+    });
+  }
+  return batch;
+}
+static void set_batch_tags(Mesh* mesh, Int ent_dim,
+    std::vector<std::string> const& names, DistBatch const& batch) {
+  for (Int i = 0; i < batch.size(); ++i) {
+    apply_to_omega_h_types(batch.type(i), [&](auto t) {
+      using T = decltype(t);
+      mesh->set_tag(ent_dim, names[std::size_t(i)], batch.get<T>(i));
+    });
+  }
+}
+void Mesh::sync_tags(Int ent_dim, std::vector<std::string> const& names) {
+  auto batch = batch_tags(this, ent_dim, names, OMEGA_H_SUM);
+  set_batch_tags(this, ent_dim, names, sync_arrays(ent_dim, batch));
+}
+void Mesh::reduce_tags(
+    Int ent_dim, std::vector<std::string> const& names, Omega_h_Op op) {
+  auto batch = batch_tags(this, ent_dim, names, op);
+  set_batch_tags(this, ent_dim, names, reduce_arrays(ent_dim, batch));
+}
 
 bool Mesh::operator==(Mesh& other) {
   auto opts = MeshCompareOpts::init(this, VarCompareOpts::zero_tolerance());
@@ -1225,8 +1380,10 @@ Mesh Mesh::copy_meta() const {
   m.dim_ = this->dim_;
   m.comm_ = this->comm_;
   m.parting_ = this->parting_;
+  m.matching_ = this->matching_;
   m.nghost_layers_ = this->nghost_layers_;
   m.rib_hints_ = this->rib_hints_;
+  m.parting_stats_ = this->parting_stats_;
   m.class_sets = this->class_sets;
   if (this->matched_ > 0) {
     m.matched_ = this->matched_;
@@ -1238,6 +1395,49 @@ Mesh Mesh::copy_meta() const {
   return m;
 }
 
+/* roughly what migrating one element sends: its tags, and for each
+   of its vertices the vertex's global number and tags */
+static Real element_bytes(Mesh* mesh) {
+  auto tag_bytes = [&](Int ent_dim) {
+    Real bytes = 0;
+    for (Int i = 0; i < mesh->ntags(ent_dim); ++i) {
+      auto const tag = mesh->get_tag(ent_dim, i);
+      Int type_bytes = 8;
+      if (tag->type() == OMEGA_H_I8) type_bytes = 1;
+      if (tag->type() == OMEGA_H_I32) type_bytes = 4;
+      bytes += tag->ncomps() * type_bytes;
+    }
+    return bytes;
+  };
+  auto const nverts = element_degree(mesh->family(), mesh->dim(), VERT);
+  return tag_bytes(mesh->dim()) +
+         nverts * (Real(sizeof(GO)) + tag_bytes(VERT));
+}
+
+BalanceStats Mesh::balance(BalanceOpts const& opts) {
+  OMEGA_H_TIME_FUNCTION;
+  if (comm_->size() == 1) return BalanceStats();
+  set_parting(OMEGA_H_ELEM_BASED);
+  auto const weights =
+      opts.weights.exists() ? opts.weights : Reals(nelems(), 1.0);
+  inertia::Rib hints;
+  if (rib_hints_) hints = *rib_hints_;
+  auto const graph = build_dual_graph(this, weights);
+  auto const parts = (opts.method == OMEGA_H_BALANCE_GRAPH)
+                         ? partition_multilevel(graph, opts.imbalance,
+                               opts.migration_cost, &hints)
+                         : partition_rib(graph, &hints);
+  rib_hints_ = std::make_shared<inertia::Rib>(hints);
+  auto const stats = assess_partition(graph, parts, element_bytes(this));
+  Dist owners2new;
+  owners2new.set_parent_comm(comm_);
+  owners2new.set_dest_ranks(parts);
+  owners2new.set_roots2items(LOs(nelems() + 1, 0, 1));
+  owners2new.set_dest_globals(globals(dim()));
+  migrate_mesh(this, owners2new.invert(), OMEGA_H_ELEM_BASED, false);
+  return stats;
+}
+
 Mesh::RibPtr Mesh::rib_hints() const { return rib_hints_; }
 
 void Mesh::set_rib_hints(RibPtr hints) { rib_hints_ = hints; }
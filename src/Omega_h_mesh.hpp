@@ -32,6 +32,48 @@ struct ClassPair {
 
 using ClassSets = std::map<std::string, std::vector<ClassPair>>;
 
+/* the entities of one dimension on this rank, by what synchronizing
+   an array over them involves: boundary entities are owned here and
+   have copies on other ranks, interior entities are owned here and
+   nowhere else, and unowned entities receive their owner's values */
+struct HaloSplit {
+  LOs interior;
+  LOs boundary;
+  LOs unowned;
+  /* sends owners' values to the unowned entities only, in that order,
+     when they could be shared */
+  Dist owners2unowned;
+};
+
+struct BalanceOpts {
+  Omega_h_Balance method = OMEGA_H_BALANCE_RIB;
+  Reals weights;  // one per element, all ones if left empty
+  /* OMEGA_H_BALANCE_GRAPH: the largest part weight allowed
+     relative to the average, and what moving one element
+     away from its rank costs relative to cutting one side */
+  Real imbalance = 1.05;
+  Real migration_cost = 1.0;
+};
+
+/* the partition Mesh::balance chose, before migrating to it */
+struct BalanceStats {
+  GO edge_cut = 0;  // element sides between two ranks
+  Real imbalance = 1.0;
+  GO migrated = 0;  // elements leaving their rank
+  GO migrated_bytes = 0;  // estimated from element connectivity and tags
+};
+
+/* entities that changes of partitioning built by migrating, and
+   entities they kept in place instead, on this rank since the mesh
+   was built. dropping ghosts keeps every entity in place, and so does
+   ghosting again a mesh that has not changed since */
+struct PartingStats {
+  GO migrated = 0;
+  GO kept = 0;
+};
+
+struct GhostCache;
+
 class Mesh {
  public:
   Mesh();
@@ -40,6 +82,7 @@ class Mesh {
   void set_comm(CommPtr const& comm);
   void set_family(Omega_h_Family family);
   void set_matched(I8 is_matched);
+  void set_matching(Omega_h_Matching matching);
   void set_dim(Int dim_in);
   void set_verts(LO nverts_in);
   void set_verts_type(LO nverts_in);
@@ -55,6 +98,7 @@ class Mesh {
   }
   inline Omega_h_Family family() const { return family_; }
   inline I8 is_matched() const { return matched_; }
+  inline Omega_h_Matching matching() const { return matching_; }
   LO nents(Int ent_dim) const;
   LO nents(Topo_type ent_type) const;
   Int ent_dim(Topo_type ent_type) const;
@@ -117,6 +161,9 @@ class Mesh {
   bool has_adj(Topo_type from_type, Topo_type to_type) const;
   Adj get_adj(Int from, Int to) const;
   Adj get_adj(Topo_type from_type, Topo_type to_type) const;
+  /* installs an adjacency, e.g. one read from a file,
+     so that it will not be derived */
+  void add_adj(Int from, Int to, Adj adj);
   Adj ask_down(Int from, Int to);
   Adj ask_down(Topo_type from_type, Topo_type to_type);
   LOs ask_verts_of(Int dim);
@@ -124,6 +171,12 @@ class Mesh {
   LOs ask_elem_verts();
   Adj ask_up(Int from, Int to);
   Adj ask_up(Topo_type from_type, Topo_type to_type);
+  /* attaches an adjacency that was patched from the one of a mesh
+     this mesh was modified from, instead of deriving it */
+  void add_patched_adj(Int from, Int to, Adj adj);
+  /* true if the adjacency was patched, false if it was derived
+     or given by set_ents() */
+  bool adj_is_patched(Int from, Int to) const;
   Graph ask_star(Int dim);
   Graph ask_dual();
 
@@ -266,7 +319,6 @@ class Mesh {
   void check_dim2(Int dim) const;
   void check_type(Topo_type ent_type) const;
   void check_type2(Topo_type ent_type) const;
-  void add_adj(Int from, Int to, Adj adj);
   void add_adj(Topo_type from_type, Topo_type to_type, Adj adj);
   Adj derive_adj(Int from, Int to);
   Adj derive_adj(Topo_type from_type, Topo_type to_type);
@@ -276,6 +328,7 @@ class Mesh {
   void react_to_set_tag(Topo_type ent_type, std::string const& name);
   Omega_h_Family family_;
   I8 matched_ = -1;
+  Omega_h_Matching matching_;
   Int dim_;
   CommPtr comm_;
   Int parting_;
@@ -287,9 +340,18 @@ class Mesh {
   // rc field tags stored in "rc" format
   TagVector rc_field_tags_[DIMS];
   AdjPtr adjs_[DIMS][DIMS];
+  bool adjs_patched_[DIMS][DIMS];
   AdjPtr adjs_type_[TOPO_TYPES][TOPO_TYPES];
   Remotes owners_[DIMS];
   DistPtr dists_[DIMS];
+  std::shared_ptr<HaloSplit> halo_splits_[DIMS];
+  /* the single ghost layer last dropped by set_parting(), kept so that
+     ghosting the unchanged mesh again needs no migration. it holds the
+     downward adjacencies and owners of the ghosted mesh, but no tags.
+     the next set_parting() that changes anything, changing the
+     entities or their owners, and drop_ghost_cache() all free it */
+  std::shared_ptr<GhostCache> ghost_cache_;
+  PartingStats parting_stats_;
   RibPtr rib_hints_;
   ParentPtr parents_[DIMS];
   ChildrenPtr children_[DIMS][DIMS];
@@ -321,11 +383,16 @@ class Mesh {
   Remotes ask_owners(Int dim);
   Read<I8> owned(Int dim);
   Dist ask_dist(Int dim);
+  HaloSplit ask_halo_split(Int dim);
   Int nghost_layers() const;
   void set_parting(Omega_h_Parting parting_in, Int nlayers, bool verbose);
   void set_parting(Omega_h_Parting parting_in, bool verbose = false);
+  PartingStats parting_stats() const;
+  /* frees the ghost layer kept for reuse by the next set_parting() */
+  void drop_ghost_cache();
   void balance(bool predictive = false);
   void balance(Reals weights);
+  BalanceStats balance(BalanceOpts const& opts);
   /**
    * migrate mesh elements by constructing a distributed graph
    * where each rank defines which elements it will own via
@@ -352,6 +419,13 @@ class Mesh {
       Int ent_dim, Read<T> a_data, LOs a2e, T default_val, Int width);
   void sync_tag(Int dim, std::string const& name);
   void reduce_tag(Int dim, std::string const& name, Omega_h_Op op);
+  /* like the above, but with all arrays or tags sent together
+     in a single round of messages */
+  DistBatch sync_arrays(Int ent_dim, DistBatch const& arrays);
+  DistBatch reduce_arrays(Int ent_dim, DistBatch const& arrays);
+  void sync_tags(Int dim, std::vector<std::string> const& names);
+  void reduce_tags(
+      Int dim, std::vector<std::string> const& names, Omega_h_Op op);
   bool operator==(Mesh& other);
   Real min_quality();
   Real max_length();
@@ -423,8 +497,23 @@ TagSet get_all_mesh_tags(Mesh* mesh);
 void ask_for_mesh_tags(Mesh* mesh, TagSet const& tags);
 
 void reorder_by_hilbert(Mesh* mesh);
+/* reverse Cuthill-McKee on the vertex-to-vertex graph */
+void reorder_by_rcm(Mesh* mesh);
+/* recursive coordinate bisection of the vertices */
+void reorder_by_bisection(Mesh* mesh);
 void reorder_by_globals(Mesh* mesh);
 
+/* how far apart in memory the vertices gathered together are:
+   |i - j| over the vertices (i, j) of each edge, and the range
+   of vertex indices within each element */
+struct OrderLocality {
+  Real mean_edge_span;
+  LO max_edge_span;  // the bandwidth of the vertex graph
+  Real mean_elem_span;
+};
+
+OrderLocality measure_order_locality(Mesh* mesh);
+
 LOs ents_on_closure(
     Mesh* mesh, std::set<std::string> const& class_names, Int ent_dim);
 
@@ -5,14 +5,17 @@
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_confined.hpp"
 #include "Omega_h_for.hpp"
+#include "Omega_h_halo.hpp"
 #include "Omega_h_host_few.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mark.hpp"
 #include "Omega_h_metric_intersect.hpp"
+#include "Omega_h_random.hpp"
 #include "Omega_h_recover.hpp"
 #include "Omega_h_shape.hpp"
 #include "Omega_h_simplex.hpp"
 #include "Omega_h_surface.hpp"
+#include "Omega_h_timer.hpp"
 
 namespace Omega_h {
 
@@ -110,6 +113,22 @@ Reals interpolate_between_metrics(LO nmetrics, Reals a, Reals b, Real t) {
   return delinearize_metrics(nmetrics, log_c);
 }
 
+Reals interpolate_between_metrics(LO nmetrics, Reals a, Reals b, Reals t) {
+  OMEGA_H_CHECK(t.size() == nmetrics);
+  auto log_a = linearize_metrics(nmetrics, a);
+  auto log_b = linearize_metrics(nmetrics, b);
+  auto const ncomps = divide_no_remainder(log_a.size(), nmetrics);
+  auto log_c = Write<Real>(log_a.size());
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    for (Int j = 0; j < ncomps; ++j) {
+      auto const k = i * ncomps + j;
+      log_c[k] = log_a[k] + t[i] * (log_b[k] - log_a[k]);
+    }
+  };
+  parallel_for(nmetrics, f, "interpolate_between_metrics");
+  return delinearize_metrics(nmetrics, log_c);
+}
+
 template <Int dim>
 Reals linearize_metrics_dim(Reals metrics) {
   auto n = divide_no_remainder(metrics.size(), symm_ncomps(dim));
@@ -152,6 +171,27 @@ Reals delinearize_metrics(LO nmetrics, Reals linear_metrics) {
 
 /* gradation limiting code: */
 
+/* the metric at v, limited by how fast the metrics of its
+   neighbors allow it to grow over the distance to them */
+template <Int mesh_dim, Int metric_dim, typename Arr>
+OMEGA_H_DEVICE Tensor<metric_dim> limit_gradation_at(Graph const& v2v,
+    Reals const& coords, Arr const& values, Real max_rate, LO v) {
+  auto m = get_symm<metric_dim>(values, v);
+  auto x = get_vector<mesh_dim>(coords, v);
+  for (auto vv = v2v.a2ab[v]; vv < v2v.a2ab[v + 1]; ++vv) {
+    auto av = v2v.ab2b[vv];
+    auto am = get_symm<metric_dim>(values, av);
+    auto ax = get_vector<mesh_dim>(coords, av);
+    auto vec = ax - x;
+    auto metric_dist = metric_length(am, vec);
+    auto factor = metric_eigenvalue_from_length(1.0 + metric_dist * max_rate);
+    auto limiter = am * factor;
+    auto limited = intersect_metrics(m, limiter);
+    m = limited;
+  }
+  return m;
+}
+
 template <Int mesh_dim, Int metric_dim>
 Reals limit_gradation_once_tmpl(
     Mesh* mesh, Reals values, Real max_rate) {
@@ -159,25 +199,12 @@ Reals limit_gradation_once_tmpl(
   auto coords = mesh->coords();
   auto out = Write<Real>(mesh->nverts() * symm_ncomps(metric_dim));
   auto f = OMEGA_H_LAMBDA(LO v) {
-    auto m = get_symm<metric_dim>(values, v);
-    auto x = get_vector<mesh_dim>(coords, v);
-    for (auto vv = v2v.a2ab[v]; vv < v2v.a2ab[v + 1]; ++vv) {
-      auto av = v2v.ab2b[vv];
-      auto am = get_symm<metric_dim>(values, av);
-      auto ax = get_vector<mesh_dim>(coords, av);
-      auto vec = ax - x;
-      auto metric_dist = metric_length(am, vec);
-      auto factor = metric_eigenvalue_from_length(1.0 + metric_dist * max_rate);
-      auto limiter = am * factor;
-      auto limited = intersect_metrics(m, limiter);
-      m = limited;
-    }
+    auto m = limit_gradation_at<mesh_dim, metric_dim>(
+        v2v, coords, values, max_rate, v);
     set_symm(out, v, m);
   };
-  parallel_for(mesh->nverts(), f, "limit_metric_gradation");
-  values = Reals(out);
-  values = mesh->sync_array(VERT, values, symm_ncomps(metric_dim));
-  return values;
+  return compute_and_sync(
+      mesh, VERT, out, symm_ncomps(metric_dim), f, "limit_metric_gradation");
 }
 
 static Reals limit_gradation_once(Mesh* mesh, Reals values, Real max_rate) {
@@ -196,28 +223,215 @@ static Reals limit_gradation_once(Mesh* mesh, Reals values, Real max_rate) {
   OMEGA_H_NORETURN(Reals());
 }
 
-Reals limit_metric_gradation(
-    Mesh* mesh, Reals values, Real max_rate, Real tol, bool verbose) {
+static void print_gradation_stats(Mesh* mesh, char const* how,
+    GradationStats const& stats, Now t0) {
+  auto const comm = mesh->comm();
+  auto const sweeps = comm->allreduce(stats.sweeps, OMEGA_H_MAX);
+  auto const exchanges = comm->allreduce(stats.exchanges, OMEGA_H_MAX);
+  auto const updates = comm->allreduce(stats.updates, OMEGA_H_SUM);
+  auto const max_active = comm->allreduce(stats.max_active, OMEGA_H_MAX);
+  auto const nverts = mesh->nglobal_ents(VERT);
+  auto const t1 = now();
+  if (can_print(mesh)) {
+    std::cout << "limited gradation " << how << " in " << sweeps
+              << " sweeps and " << exchanges << " exchanges, updating "
+              << updates << " vertices (" << Real(updates) / Real(nverts)
+              << " per vertex, at most " << max_active
+              << " on a rank in a sweep), " << (t1 - t0) << " seconds\n";
+  }
+}
+
+Reals limit_metric_gradation_synced(Mesh* mesh, Reals values, Real max_rate,
+    Real tol, bool verbose, GradationStats* stats) {
   OMEGA_H_TIME_FUNCTION;
   OMEGA_H_CHECK(mesh->owners_have_all_upward(VERT));
   OMEGA_H_CHECK(max_rate > 0.0);
+  auto const t0 = now();
   auto comm = mesh->comm();
+  GradationStats my_stats;
   Reals values2 = values;
   Int i = 0;
   do {
     values = values2;
     values2 = limit_gradation_once(mesh, values, max_rate);
     ++i;
+    my_stats.updates += mesh->nverts();
+    my_stats.max_active = mesh->nverts();
+    if (mesh->could_be_shared(VERT)) ++my_stats.exchanges;
     if (verbose && can_print(mesh) && i > 0 && i % 50 == 0) {
       std::cout << "warning: gradation limiting is up to step " << i << '\n';
     }
   } while (!comm->reduce_and(are_close(values, values2, tol)));
-  if (verbose && can_print(mesh)) {
-    std::cout << "limited gradation in " << i << " steps\n";
-  }
+  my_stats.sweeps = i;
+  if (verbose) print_gradation_stats(mesh, "by full sweeps", my_stats, t0);
+  if (stats) *stats = my_stats;
   return values2;
 }
 
+/* a greedy coloring of the vertices in the order of random
+   priorities, so that the vertices of one color can be updated
+   in place at the same time: each round colors the uncolored
+   vertices that outrank their uncolored neighbors with the
+   smallest color their neighbors do not have yet */
+static LOs color_vertices(Graph v2v, GOs globals, LO* ncolors) {
+  auto const n = v2v.nnodes();
+  auto const priority = unit_uniform_random_reals_from_globals(globals, 0, 0);
+  auto outranks = OMEGA_H_LAMBDA(LO u, LO v)->bool {
+    if (priority[u] != priority[v]) return priority[u] > priority[v];
+    return globals[u] > globals[v];
+  };
+  Read<LO> colors(n, -1);
+  while (n && get_min(colors) < 0) {
+    Write<LO> next = deep_copy(colors);
+    auto f = OMEGA_H_LAMBDA(LO v) {
+      if (colors[v] >= 0) return;
+      for (auto vu = v2v.a2ab[v]; vu < v2v.a2ab[v + 1]; ++vu) {
+        auto const u = v2v.ab2b[vu];
+        if (colors[u] < 0 && outranks(u, v)) return;
+      }
+      LO c = 0;
+      for (bool taken = true; taken; c += taken) {
+        taken = false;
+        for (auto vu = v2v.a2ab[v]; vu < v2v.a2ab[v + 1]; ++vu) {
+          if (colors[v2v.ab2b[vu]] == c) taken = true;
+        }
+      }
+      next[v] = c;
+    };
+    parallel_for(n, f, "color_vertices");
+    colors = next;
+  }
+  *ncolors = n ? get_max(colors) + 1 : 0;
+  return colors;
+}
+
+template <Int mesh_dim, Int metric_dim>
+Reals limit_gradation_frontier_tmpl(Mesh* mesh, Reals values, Real max_rate,
+    Real tol, GradationStats* stats) {
+  constexpr Int ncomps = symm_ncomps(metric_dim);
+  auto const comm = mesh->comm();
+  auto const nverts = mesh->nverts();
+  auto const v2v = mesh->ask_star(VERT);
+  auto const coords = mesh->coords();
+  auto const split = mesh->ask_halo_split(VERT);
+  auto const owned = mesh->owned(VERT);
+  auto const is_boundary = map_onto(
+      Read<I8>(split.boundary.size(), 1), split.boundary, nverts, I8(0), 1);
+  LO ncolors;
+  auto const colors = color_vertices(v2v, mesh->globals(VERT), &ncolors);
+  Write<Real> out = deep_copy(values);
+  /* the owned vertices to update next, which are all of them at
+     first and then the neighbors of those that changed beyond the
+     tolerance, marked in changed during a sweep */
+  auto active = collect_marked(owned);
+  Write<I8> changed(nverts, 0);
+  auto activate_neighbors = [&](LOs changed_verts) {
+    Write<I8> marks(nverts, 0);
+    /* every neighbor of a changed vertex is marked with the same
+       value, so it does not matter which write lands */
+    auto f = OMEGA_H_LAMBDA(LO i) {
+      auto const v = changed_verts[i];
+      for (auto vu = v2v.a2ab[v]; vu < v2v.a2ab[v + 1]; ++vu) {
+        auto const u = v2v.ab2b[vu];
+        if (owned[u]) marks[u] = 1;
+      }
+    };
+    parallel_for(changed_verts.size(), f, "activate_neighbors");
+    active = collect_marked(read(marks));
+  };
+  while (true) {
+    I8 boundary_changed = 0;
+    while (active.size()) {
+      ++stats->sweeps;
+      stats->updates += active.size();
+      stats->max_active = max2(stats->max_active, GO(active.size()));
+      auto const active_colors = read(unmap(active, colors, 1));
+      for (LO c = 0; c < ncolors; ++c) {
+        auto const verts =
+            unmap(collect_marked(each_eq_to(active_colors, c)), active, 1);
+        auto f = OMEGA_H_LAMBDA(LO i) {
+          auto const v = verts[i];
+          auto const m = limit_gradation_at<mesh_dim, metric_dim>(
+              v2v, coords, out, max_rate, v);
+          auto const old_m = get_symm<metric_dim>(out, v);
+          bool is_close = true;
+          for (Int j = 0; j < metric_dim; ++j) {
+            for (Int k = 0; k < metric_dim; ++k) {
+              is_close = is_close && are_close(m[j][k], old_m[j][k], tol);
+            }
+          }
+          if (is_close) return;
+          set_symm(out, v, m);
+          changed[v] = 1;
+        };
+        parallel_for(verts.size(), f, "limit_gradation_frontier");
+      }
+      auto const changed_verts = collect_marked(read(changed));
+      map_value_into(I8(0), changed_verts, changed);
+      if (changed_verts.size() &&
+          get_max(read(unmap(changed_verts, is_boundary, 1)))) {
+        boundary_changed = 1;
+      }
+      activate_neighbors(changed_verts);
+    }
+    if (!mesh->could_be_shared(VERT)) break;
+    if (!comm->reduce_or(boundary_changed)) break;
+    ++stats->exchanges;
+    auto const received = split.owners2unowned.exch(read(out), ncomps);
+    Write<I8> unowned_changed(split.unowned.size(), 0);
+    auto const unowned = split.unowned;
+    auto g = OMEGA_H_LAMBDA(LO i) {
+      auto const v = unowned[i];
+      for (Int j = 0; j < ncomps; ++j) {
+        if (out[v * ncomps + j] != received[i * ncomps + j]) {
+          out[v * ncomps + j] = received[i * ncomps + j];
+          unowned_changed[i] = 1;
+        }
+      }
+    };
+    parallel_for(unowned.size(), g, "limit_gradation_frontier");
+    activate_neighbors(
+        unmap(collect_marked(read(unowned_changed)), unowned, 1));
+  }
+  return out;
+}
+
+static Reals limit_gradation_frontier(Mesh* mesh, Reals values, Real max_rate,
+    Real tol, GradationStats* stats) {
+  auto metric_dim = get_metrics_dim(mesh->nverts(), values);
+  if (mesh->dim() == 3 && metric_dim == 3) {
+    return limit_gradation_frontier_tmpl<3, 3>(
+        mesh, values, max_rate, tol, stats);
+  } else if (mesh->dim() == 2 && metric_dim == 2) {
+    return limit_gradation_frontier_tmpl<2, 2>(
+        mesh, values, max_rate, tol, stats);
+  } else if (mesh->dim() == 3 && metric_dim == 1) {
+    return limit_gradation_frontier_tmpl<3, 1>(
+        mesh, values, max_rate, tol, stats);
+  } else if (mesh->dim() == 2 && metric_dim == 1) {
+    return limit_gradation_frontier_tmpl<2, 1>(
+        mesh, values, max_rate, tol, stats);
+  } else if (mesh->dim() == 1) {
+    return limit_gradation_frontier_tmpl<1, 1>(
+        mesh, values, max_rate, tol, stats);
+  }
+  OMEGA_H_NORETURN(Reals());
+}
+
+Reals limit_metric_gradation(Mesh* mesh, Reals values, Real max_rate,
+    Real tol, bool verbose, GradationStats* stats) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(mesh->owners_have_all_upward(VERT));
+  OMEGA_H_CHECK(max_rate > 0.0);
+  auto const t0 = now();
+  GradationStats my_stats;
+  auto const out =
+      limit_gradation_frontier(mesh, values, max_rate, tol, &my_stats);
+  if (verbose) print_gradation_stats(mesh, "by worklist", my_stats, t0);
+  if (stats) *stats = my_stats;
+  return out;
+}
+
 template <Int metric_dim>
 Reals project_metrics_dim(Mesh* mesh, Reals e2m) {
   auto e_linear = linearize_metrics(mesh->nelems(), e2m);
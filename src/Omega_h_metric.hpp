@@ -192,6 +192,8 @@ Reals get_mident_metrics(
 Reals get_mident_metrics(
     Mesh* mesh, Int ent_dim, Reals v2m, bool has_degen = false);
 Reals interpolate_between_metrics(LO nmetrics, Reals a, Reals b, Real t);
+/* the same with one t per metric */
+Reals interpolate_between_metrics(LO nmetrics, Reals a, Reals b, Reals t);
 Reals linearize_metrics(LO nmetrics, Reals metrics);
 Reals delinearize_metrics(LO nmetrics, Reals linear_metrics);
 
@@ -203,8 +205,29 @@ Reals get_implied_isos(Mesh* mesh);
 Reals get_element_implied_length_metrics(Mesh* mesh);
 Reals get_pure_implied_metrics(Mesh* mesh);
 Reals get_implied_metrics(Mesh* mesh);
+
+/* the work limiting gradation took on this rank: sweeps over the
+   vertices it updated, exchanges of the vertices on the partition
+   boundary, each also taking a global reduction, and the vertex
+   updates in all sweeps and in the largest one */
+struct GradationStats {
+  Int sweeps = 0;
+  Int exchanges = 0;
+  GO updates = 0;
+  GO max_active = 0;
+};
+
+/* limits how fast the metric may grow along edges. vertices are
+   updated in place, one color of a vertex coloring at a time, and
+   only those next to a vertex that changed beyond tol are updated
+   again. each rank works until its own vertices settle before
+   sending the boundary vertices to their copies. */
 Reals limit_metric_gradation(Mesh* mesh, Reals values, Real max_rate,
-    Real tol = 1e-2, bool verbose = true);
+    Real tol = 1e-2, bool verbose = true, GradationStats* stats = nullptr);
+/* the same by sweeps over all vertices, synchronizing after each */
+Reals limit_metric_gradation_synced(Mesh* mesh, Reals values, Real max_rate,
+    Real tol = 1e-2, bool verbose = true, GradationStats* stats = nullptr);
+
 Reals get_complexity_per_elem(Mesh* mesh, Reals v2m);
 Reals get_nelems_per_elem(Mesh* mesh, Reals v2m);
 Real get_complexity(Mesh* mesh, Reals v2m);
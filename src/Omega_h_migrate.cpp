@@ -127,6 +127,16 @@ void push_tags(Mesh *old_mesh, Mesh* new_mesh, Int ent_dim,
   OMEGA_H_TIME_FUNCTION;
   OMEGA_H_CHECK(old_owners2new_ents.nroots() == old_mesh->nents(ent_dim));
   ScopedChangeRCFieldsToMesh rc_to_mesh(*old_mesh);
+  DistBatch old_arrays;
+  for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
+    auto tag = old_mesh->get_tag(ent_dim, i);
+    apply_to_omega_h_types(tag->type(), [&](auto t){
+      using T = decltype(t);
+      old_arrays.add(
+          old_mesh->get_array<T>(ent_dim, tag->name()), tag->ncomps());
+    });
+  }
+  auto const new_arrays = old_owners2new_ents.exch(old_arrays);
   for (Int i = 0; i < old_mesh->ntags(ent_dim); ++i) {
     auto tag = old_mesh->get_tag(ent_dim, i);
     auto const& name = tag->name();
@@ -134,8 +144,7 @@ void push_tags(Mesh *old_mesh, Mesh* new_mesh, Int ent_dim,
     const auto class_ids = tag->class_ids();
     apply_to_omega_h_types(tag->type(), [&](auto t){
       using T = decltype(t);
-      auto array = old_mesh->get_array<T>(ent_dim,name);
-      array = old_owners2new_ents.exch(array, ncomps);
+      auto array = new_arrays.get<T>(i);
 
       if(is_rc_tag(name) && rc_to_mesh.did_conversion() ) {
         new_mesh->set_rc_from_mesh_array(ent_dim,ncomps,class_ids,name,array);
@@ -1,5 +1,6 @@
 #include "Omega_h_modify.hpp"
 
+#include "Omega_h_adj.hpp"
 #include "Omega_h_align.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_atomics.hpp"
@@ -32,9 +33,14 @@ static void modify_conn(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
   auto prods2new_lows = Adj();
   if (low_dim > VERT) {
     auto new_low_verts2new_verts = new_mesh->ask_verts_of(low_dim);
-    auto new_verts2new_lows = new_mesh->ask_up(VERT, low_dim);
-    prods2new_lows = reflect_down(prod_verts2verts, new_low_verts2new_verts,
-        new_verts2new_lows, old_mesh->family(), ent_dim, low_dim);
+    if (new_mesh->matching() == OMEGA_H_MATCH_BY_HASH) {
+      prods2new_lows = reflect_down_by_hash(prod_verts2verts,
+          new_low_verts2new_verts, old_mesh->family(), ent_dim, low_dim);
+    } else {
+      auto new_verts2new_lows = new_mesh->ask_up(VERT, low_dim);
+      prods2new_lows = reflect_down(prod_verts2verts, new_low_verts2new_verts,
+          new_verts2new_lows, old_mesh->family(), ent_dim, low_dim);
+    }
   } else {
     prods2new_lows = Adj(prod_verts2verts);
   }
@@ -516,6 +522,112 @@ void modify_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
       mods2reps, global_rep_counts);
 }
 
+/* inverts an old_ents2new_ents map, in which entities that went
+   away map to -1, giving -1 for the new entities that are products */
+static LOs invert_old2new(LOs old_ents2new_ents, LO nnew_ents) {
+  Write<LO> new_ents2old_ents(nnew_ents, -1);
+  auto f = OMEGA_H_LAMBDA(LO old_ent) {
+    auto const new_ent = old_ents2new_ents[old_ent];
+    if (new_ent >= 0) new_ents2old_ents[new_ent] = old_ent;
+  };
+  parallel_for(old_ents2new_ents.size(), std::move(f), "invert_old2new");
+  return new_ents2old_ents;
+}
+
+/* the downward adjacency of just a subset of entities, which unlike
+   Mesh::ask_down() doesn't derive it for the whole mesh */
+static Adj ask_subset_down(
+    Mesh* mesh, LOs subset2ents, Int high_dim, Int low_dim) {
+  Adj h2l;
+  if (low_dim + 1 == high_dim || mesh->has_adj(high_dim, low_dim)) {
+    auto const down = mesh->ask_down(high_dim, low_dim);
+    auto const deg = element_degree(mesh->family(), high_dim, low_dim);
+    h2l.ab2b = unmap(subset2ents, down.ab2b, deg);
+    if (down.codes.exists()) h2l.codes = unmap(subset2ents, down.codes, deg);
+  } else {
+    auto const h2m = ask_subset_down(mesh, subset2ents, high_dim, low_dim + 1);
+    auto const m2l = mesh->ask_down(low_dim + 1, low_dim);
+    h2l = transit(h2m, m2l, mesh->family(), high_dim, low_dim);
+  }
+  return h2l;
+}
+
+/* Builds the upward adjacency from (low_dim) to (high_dim) entities
+   of the new mesh out of the one already derived on the old mesh.
+   A high entity that stays the same only uses low entities that
+   also stay the same, so the list of each low entity is its old list
+   minus the high entities that went away, plus the products using it,
+   which are found by inverting just the products' downward adjacency. */
+static Adj patch_up(Mesh* old_mesh, Mesh* new_mesh, Int low_dim, Int high_dim,
+    LOs old_lows2new_lows, LOs old_highs2new_highs) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const nnew_lows = new_mesh->nents(low_dim);
+  auto const nnew_highs = new_mesh->nents(high_dim);
+  auto const new_lows2old_lows = invert_old2new(old_lows2new_lows, nnew_lows);
+  auto const new_highs2old_highs =
+      invert_old2new(old_highs2new_highs, nnew_highs);
+  auto const prods2new_highs =
+      collect_marked(each_lt(new_highs2old_highs, LO(0)));
+  auto const deg = element_degree(new_mesh->family(), high_dim, low_dim);
+  auto const prods2new_lows =
+      ask_subset_down(new_mesh, prods2new_highs, high_dim, low_dim);
+  auto const new_lows2prods =
+      invert_adj(prods2new_lows, deg, nnew_lows, high_dim, low_dim);
+  auto const old_up = old_mesh->ask_up(low_dim, high_dim);
+  Write<LO> degrees(nnew_lows);
+  auto count = OMEGA_H_LAMBDA(LO new_low) {
+    LO n = new_lows2prods.a2ab[new_low + 1] - new_lows2prods.a2ab[new_low];
+    auto const old_low = new_lows2old_lows[new_low];
+    if (old_low >= 0) {
+      for (auto lh = old_up.a2ab[old_low]; lh < old_up.a2ab[old_low + 1];
+           ++lh) {
+        if (old_highs2new_highs[old_up.ab2b[lh]] >= 0) ++n;
+      }
+    }
+    degrees[new_low] = n;
+  };
+  parallel_for(nnew_lows, std::move(count), "patch_up(count)");
+  auto const a2ab = offset_scan(LOs(degrees));
+  auto const nlh = a2ab.last();
+  Write<LO> ab2b(nlh);
+  Write<I8> codes(nlh);
+  auto fill = OMEGA_H_LAMBDA(LO new_low) {
+    auto lh = a2ab[new_low];
+    auto const old_low = new_lows2old_lows[new_low];
+    if (old_low >= 0) {
+      for (auto old_lh = old_up.a2ab[old_low];
+           old_lh < old_up.a2ab[old_low + 1]; ++old_lh) {
+        auto const new_high = old_highs2new_highs[old_up.ab2b[old_lh]];
+        if (new_high < 0) continue;
+        ab2b[lh] = new_high;
+        codes[lh] = old_up.codes[old_lh];
+        ++lh;
+      }
+    }
+    for (auto lp = new_lows2prods.a2ab[new_low];
+         lp < new_lows2prods.a2ab[new_low + 1]; ++lp) {
+      ab2b[lh] = prods2new_highs[new_lows2prods.ab2b[lp]];
+      codes[lh] = new_lows2prods.codes[lp];
+      ++lh;
+    }
+  };
+  parallel_for(nnew_lows, std::move(fill), "patch_up(fill)");
+  sort_by_high_index(a2ab, ab2b, codes);
+  return Adj(a2ab, ab2b, codes);
+}
+
+void patch_up_adjs(Mesh* old_mesh, Mesh* new_mesh, Int high_dim,
+    Few<LOs, 4> old_ents2new_ents) {
+  OMEGA_H_TIME_FUNCTION;
+  for (Int low_dim = 0; low_dim < high_dim; ++low_dim) {
+    if (!old_mesh->has_adj(low_dim, high_dim)) continue;
+    if (new_mesh->has_adj(low_dim, high_dim)) continue;
+    auto const up = patch_up(old_mesh, new_mesh, low_dim, high_dim,
+        old_ents2new_ents[low_dim], old_ents2new_ents[high_dim]);
+    new_mesh->add_patched_adj(low_dim, high_dim, up);
+  }
+}
+
 void set_owners_by_indset(
     Mesh* mesh, Int key_dim, LOs keys2kds, Graph kds2elems) {
   if (mesh->comm()->size() == 1) return;
@@ -26,6 +26,13 @@ void modify_ents(Mesh* old_mesh, Mesh* new_mesh, Int ent_dim,
     bool mods_can_be_shared, LOs* p_prods2new_ents, LOs* p_same_ents2old_ents,
     LOs* p_same_ents2new_ents, LOs* p_old_ents2new_ents);
 
+/* once the entities of dimension (high_dim) of new_mesh exist,
+   carries over the upward adjacencies into them which old_mesh
+   has already derived, given the old_ents2new_ents maps from
+   modify_ents() for dimensions up to (high_dim) */
+void patch_up_adjs(Mesh* old_mesh, Mesh* new_mesh, Int high_dim,
+    Few<LOs, 4> old_ents2new_ents);
+
 void set_owners_by_indset(
     Mesh* mesh, Int key_dim, LOs keys2kds, Graph kds2elems);
 
@@ -333,5 +333,59 @@ void print_top_sorted(History const& h_in, double total_runtime) {
   }
 }
 
+void record_imbalance(
+    char const* name, double const* thread_times, int nthreads) {
+  if (!global_singleton_history) return;
+  double max_time = 0.0;
+  double sum_time = 0.0;
+  int nactive = 0;
+  for (int i = 0; i < nthreads; ++i) {
+    if (thread_times[i] < 0.0) continue;
+    max_time = std::max(max_time, thread_times[i]);
+    sum_time += thread_times[i];
+    ++nactive;
+  }
+  if (nactive == 0) return;
+  auto& imbalance = global_singleton_history->imbalances[name];
+  imbalance.number_of_calls += 1;
+  imbalance.max_thread_time += max_time;
+  imbalance.mean_thread_time += sum_time / nactive;
+}
+
+void print_imbalance(History const& h) {
+  if (h.imbalances.empty()) return;
+  typedef std::pair<std::string, Imbalance> my_pair;
+  std::vector<my_pair> sorted(h.imbalances.begin(), h.imbalances.end());
+  /* the time lost waiting on the slowest thread comes first */
+  std::stable_sort(sorted.begin(), sorted.end(),
+      [](my_pair const& a, my_pair const& b) -> bool {
+        return (a.second.max_thread_time - a.second.mean_thread_time) >
+               (b.second.max_thread_time - b.second.mean_thread_time);
+      });
+  auto coutflags(std::cout.flags());
+  int const width = 14;
+  std::cout << "\n";
+  std::cout << "THREAD IMBALANCE (named kernels, summed over calls):\n";
+  std::cout << "================\n";
+  std::cout << std::right << std::setw(width) << "Calls"
+            << std::setw(width) << "Max [s]" << std::setw(width) << "Mean [s]"
+            << std::setw(width) << "Lost [s]" << std::setw(width)
+            << "Max/Mean" << "   Name\n";
+  for (auto& entry : sorted) {
+    auto& imbalance = entry.second;
+    auto const ratio = (imbalance.mean_thread_time > 0.0)
+                           ? (imbalance.max_thread_time /
+                                 imbalance.mean_thread_time)
+                           : 1.0;
+    std::cout << std::setw(width) << imbalance.number_of_calls
+              << std::setw(width) << imbalance.max_thread_time
+              << std::setw(width) << imbalance.mean_thread_time
+              << std::setw(width)
+              << (imbalance.max_thread_time - imbalance.mean_thread_time)
+              << std::setw(width) << ratio << "   " << entry.first << '\n';
+  }
+  std::cout.flags(coutflags);
+}
+
 }  // namespace profile
 }  // namespace Omega_h
@@ -3,7 +3,10 @@
 
 #include <Omega_h_timer.hpp>
 #include <Omega_h_filesystem.hpp>
+#include <Omega_h_trace.hpp>
 #include <cstring>
+#include <map>
+#include <string>
 #include <vector>
 #include <memory>
 #ifdef OMEGA_H_USE_KOKKOS
@@ -44,6 +47,14 @@ struct Frame {
   std::size_t number_of_calls;
 };
 
+/* accumulated over all calls of one named parallel kernel:
+   the busy time of its slowest thread and of an average thread */
+struct Imbalance {
+  std::size_t number_of_calls;
+  double max_thread_time;
+  double mean_thread_time;
+};
+
 struct History {
   std::vector<Frame> frames;
   std::size_t current_frame;
@@ -54,6 +65,7 @@ struct History {
   double chop;
   bool add_filename;
   CommPtr comm;
+  std::map<std::string, Imbalance> imbalances;
   History(CommPtr comm = nullptr, bool dopercent=false, double chop=0.0, bool add_filename=false);
   History(const History& h);
   inline const char* get_name(std::size_t frame) const {
@@ -177,6 +189,12 @@ void print_time_sorted(History const& h);
 void print_top_down_and_bottom_up(History const& h, double total_runtime);
 void print_top_sorted(History const& h, double total_runtime);
 
+/* thread_times holds the busy time of each thread of one kernel call,
+   negative entries belong to threads that were not part of the team */
+void record_imbalance(
+    char const* name, double const* thread_times, int nthreads);
+void print_imbalance(History const& h);
+
 }  // namespace profile
 }  // namespace Omega_h
 
@@ -186,6 +204,7 @@ inline void begin_code(char const* name, char const* file=0) {
 #ifdef OMEGA_H_USE_KOKKOS
   Kokkos::Profiling::pushRegion(name);
 #endif
+  if (profile::global_trace) profile::global_trace->begin(name);
   if (profile::global_singleton_history) {
     if (file == 0) {
       file = "Omega_h";
@@ -211,6 +230,7 @@ inline void end_code() {
 #ifdef OMEGA_H_USE_KOKKOS
   Kokkos::Profiling::popRegion();
 #endif
+  if (profile::global_trace) profile::global_trace->end();
   if (profile::global_singleton_history) {
     profile::global_singleton_history->stop();
   }
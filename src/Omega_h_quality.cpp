@@ -6,16 +6,28 @@ namespace Omega_h {
 
 template <Int mesh_dim, Int metric_dim>
 Reals measure_qualities_tmpl(Mesh* mesh, LOs a2e, Reals metrics) {
-  MetricElementQualities<mesh_dim, metric_dim> measurer(mesh, metrics);
+  constexpr Int W = pack_width;
+  auto coords = mesh->coords();
   auto ev2v = mesh->ask_verts_of(mesh_dim);
   auto na = a2e.size();
+  auto nblocks = (na + W - 1) / W;
   Write<Real> qualities(na);
-  auto f = OMEGA_H_LAMBDA(LO a) {
-    auto e = a2e[a];
-    auto v = gather_verts<mesh_dim + 1>(ev2v, e);
-    qualities[a] = measurer.measure(v);
+  auto f = OMEGA_H_LAMBDA(LO block) {
+    MetricQualityBlock<mesh_dim, metric_dim, W> elems;
+    auto first = block * W;
+    auto nlanes = min2(LO(W), na - first);
+    for (Int lane = 0; lane < nlanes; ++lane) {
+      auto v = gather_verts<mesh_dim + 1>(ev2v, a2e[first + lane]);
+      elems.set(lane, gather_vectors<mesh_dim + 1, mesh_dim>(coords, v),
+          gather_symms<mesh_dim + 1, metric_dim>(metrics, v));
+    }
+    for (Int lane = nlanes; lane < W; ++lane) elems.copy_lane(lane, 0);
+    auto q = elems.measure();
+    for (Int lane = 0; lane < nlanes; ++lane) {
+      qualities[first + lane] = q[lane];
+    }
   };
-  parallel_for(na, f, "measure_qualities");
+  parallel_for(nblocks, f, "measure_qualities");
   return qualities;
 }
 
@@ -2,6 +2,7 @@
 #define OMEGA_H_QUALITY_HPP
 
 #include <Omega_h_shape.hpp>
+#include <Omega_h_simd.hpp>
 
 namespace Omega_h {
 
@@ -51,6 +52,190 @@ struct MetricElementQualities {
   }
 };
 
+/* metric_element_quality() of the maxdet_metric() of W elements at once.
+ * measure() moves the coordinates and metrics given to set() into one
+ * Pack per component, so that it can work on all the elements together.
+ * every lane does the same operations in the same order as the scalar
+ * functions, so the results do not change.
+ */
+
+template <Int W>
+OMEGA_H_INLINE Pack<W> pack_determinant(Pack<W> const (&m)[1][1]) {
+  return m[0][0];
+}
+
+template <Int W>
+OMEGA_H_INLINE Pack<W> pack_determinant(Pack<W> const (&m)[2][2]) {
+  return m[0][0] * m[1][1] - m[1][0] * m[0][1];
+}
+
+template <Int W>
+OMEGA_H_INLINE Pack<W> pack_determinant(Pack<W> const (&m)[3][3]) {
+  auto a = m[0][0];
+  auto b = m[1][0];
+  auto c = m[2][0];
+  auto d = m[0][1];
+  auto e = m[1][1];
+  auto f = m[2][1];
+  auto g = m[0][2];
+  auto h = m[1][2];
+  auto i = m[2][2];
+  return (a * e * i) + (b * f * g) + (c * d * h) - (c * e * g) -
+         (b * d * i) - (a * f * h);
+}
+
+template <Int W>
+OMEGA_H_INLINE Pack<W> pack_simplex_size(Pack<W> const (&b)[2][2]) {
+  return (b[0][0] * b[1][1] - b[0][1] * b[1][0]) / 2.0;
+}
+
+template <Int W>
+OMEGA_H_INLINE Pack<W> pack_simplex_size(Pack<W> const (&b)[3][3]) {
+  auto c0 = b[0][1] * b[1][2] - b[0][2] * b[1][1];
+  auto c1 = b[0][2] * b[1][0] - b[0][0] * b[1][2];
+  auto c2 = b[0][0] * b[1][1] - b[0][1] * b[1][0];
+  return (c0 * b[2][0] + c1 * b[2][1] + c2 * b[2][2]) / 6.0;
+}
+
+template <Int W>
+OMEGA_H_INLINE void pack_edge_vectors(Pack<W> const (&p)[3][2],
+    Pack<W> const (&b)[2][2], Pack<W> (&ev)[3][2]) {
+  for (Int j = 0; j < 2; ++j) {
+    ev[0][j] = b[0][j];
+    ev[1][j] = p[2][j] - p[1][j];
+    ev[2][j] = -b[1][j];
+  }
+}
+
+template <Int W>
+OMEGA_H_INLINE void pack_edge_vectors(Pack<W> const (&p)[4][3],
+    Pack<W> const (&b)[3][3], Pack<W> (&ev)[6][3]) {
+  for (Int j = 0; j < 3; ++j) {
+    ev[0][j] = b[0][j];
+    ev[1][j] = p[2][j] - p[1][j];
+    ev[2][j] = -b[1][j];
+    ev[3][j] = b[2][j];
+    ev[4][j] = p[3][j] - p[1][j];
+    ev[5][j] = p[3][j] - p[2][j];
+  }
+}
+
+template <Int dim, Int W>
+OMEGA_H_INLINE Pack<W> pack_metric_product(
+    Pack<W> const (&m)[dim][dim], Pack<W> const (&v)[dim]) {
+  Pack<W> mv[dim];
+  for (Int i = 0; i < dim; ++i) {
+    mv[i] = m[0][i] * v[0];
+    for (Int j = 1; j < dim; ++j) mv[i] = mv[i] + m[j][i] * v[j];
+  }
+  auto out = v[0] * mv[0];
+  for (Int i = 1; i < dim; ++i) out = out + v[i] * mv[i];
+  return out;
+}
+
+template <Int dim, Int W>
+OMEGA_H_INLINE Pack<W> pack_metric_product(
+    Pack<W> const (&m)[1][1], Pack<W> const (&v)[dim]) {
+  auto out = v[0] * (v[0] * m[0][0]);
+  for (Int i = 1; i < dim; ++i) out = out + v[i] * (v[i] * m[0][0]);
+  return out;
+}
+
+template <Int dim, Int metric_dim, Int W = pack_width>
+struct MetricQualityBlock {
+  Few<Vector<dim>, dim + 1> lane_ps[W];
+  Few<Tensor<metric_dim>, dim + 1> lane_ms[W];
+  OMEGA_H_INLINE void set(Int lane, Few<Vector<dim>, dim + 1> const& lp,
+      Few<Tensor<metric_dim>, dim + 1> const& lms) {
+    lane_ps[lane] = lp;
+    lane_ms[lane] = lms;
+  }
+  OMEGA_H_INLINE void copy_lane(Int to, Int from) {
+    lane_ps[to] = lane_ps[from];
+    lane_ms[to] = lane_ms[from];
+  }
+  OMEGA_H_INLINE Pack<W> measure() const {
+    /* transposing here, from values already loaded, is much faster than
+       storing each lane into a Pack as it is gathered */
+    Pack<W> p[dim + 1][dim];
+    Pack<W> ms[dim + 1][metric_dim][metric_dim];
+    for (Int lane = 0; lane < W; ++lane) {
+      for (Int i = 0; i < dim + 1; ++i) {
+        for (Int j = 0; j < dim; ++j) p[i][j].set(lane, lane_ps[lane][i][j]);
+        for (Int j = 0; j < metric_dim; ++j) {
+          for (Int k = j; k < metric_dim; ++k) {
+            ms[i][j][k].set(lane, lane_ms[lane][i][j][k]);
+          }
+        }
+      }
+    }
+    /* metrics are symmetric, so only half of each needs moving around */
+    for (Int i = 0; i < dim + 1; ++i) {
+      for (Int j = 0; j < metric_dim; ++j) {
+        for (Int k = 0; k < j; ++k) ms[i][j][k] = ms[i][k][j];
+      }
+    }
+    Pack<W> b[dim][dim];
+    for (Int i = 0; i < dim; ++i) {
+      for (Int j = 0; j < dim; ++j) b[i][j] = p[i + 1][j] - p[0][j];
+    }
+    auto rs = pack_simplex_size(b);
+    Pack<W> m[metric_dim][metric_dim];
+    for (Int j = 0; j < metric_dim; ++j) {
+      for (Int k = 0; k < metric_dim; ++k) m[j][k] = ms[0][j][k];
+    }
+    auto maxdet = pack_determinant(ms[0]);
+    for (Int i = 1; i < dim + 1; ++i) {
+      auto det = pack_determinant(ms[i]);
+      for (Int j = 0; j < metric_dim; ++j) {
+        for (Int k = j; k < metric_dim; ++k) {
+          m[j][k] = select_greater(det, maxdet, ms[i][j][k], m[j][k]);
+        }
+      }
+      maxdet = select_greater(det, maxdet, det, maxdet);
+    }
+    for (Int j = 0; j < metric_dim; ++j) {
+      for (Int k = 0; k < j; ++k) m[j][k] = m[k][j];
+    }
+    auto s = rs * power<dim, 2 * metric_dim>(maxdet);
+    constexpr Int nedges = (dim * (dim + 1)) / 2;
+    Pack<W> ev[nedges][dim];
+    pack_edge_vectors(p, b, ev);
+    auto msl = fill_pack<W>(0.0);
+    for (Int i = 0; i < nedges; ++i) {
+      msl = msl + pack_metric_product<dim>(m, ev[i]);
+    }
+    msl = msl / Real(nedges);
+    auto q = power<2, dim>(s / equilateral_simplex_size(dim)) / msl;
+    return select_greater(fill_pack<W>(0.0), s, s, q);
+  }
+};
+
+/* the minimum quality of the elements added to it, measured W at a time.
+   the lanes of a partial block repeat its first element */
+template <Int dim, Int metric_dim, Int W = pack_width>
+struct MinMetricQuality {
+  MetricQualityBlock<dim, metric_dim, W> block;
+  Int nlanes = 0;
+  Real minqual = 1.0;
+  OMEGA_H_INLINE void add(Few<Vector<dim>, dim + 1> const& p,
+      Few<Tensor<metric_dim>, dim + 1> const& ms) {
+    block.set(nlanes++, p, ms);
+    if (nlanes == W) flush();
+  }
+  OMEGA_H_INLINE void flush() {
+    if (!nlanes) return;
+    for (Int lane = nlanes; lane < W; ++lane) block.copy_lane(lane, 0);
+    auto q = block.measure();
+    for (Int lane = 0; lane < W; ++lane) minqual = min2(minqual, q[lane]);
+    nlanes = 0;
+  }
+  OMEGA_H_INLINE Real result() {
+    flush();
+    return minqual;
+  }
+};
+
 Reals measure_qualities(Mesh* mesh, LOs a2e, Reals metrics);
 Reals measure_qualities(Mesh* mesh, LOs a2e);
 Reals measure_qualities(Mesh* mesh);
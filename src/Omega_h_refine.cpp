@@ -4,6 +4,7 @@
 
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_indset.hpp"
+#include "Omega_h_malloc.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_modify.hpp"
@@ -53,6 +54,7 @@ static void refine_element_based(Mesh* mesh, AdaptOpts const& opts) {
   auto keys2midverts = LOs();
   auto old_verts2new_verts = LOs();
   auto old_lows2new_lows = LOs();
+  Few<LOs, 4> old_dim_ents2new_ents;
   for (Int ent_dim = 0; ent_dim <= mesh->dim(); ++ent_dim) {
     auto keys2prods = LOs();
     auto prod_verts2verts = LOs();
@@ -69,6 +71,8 @@ static void refine_element_based(Mesh* mesh, AdaptOpts const& opts) {
     modify_ents_adapt(mesh, &new_mesh, ent_dim, EDGE, keys2edges, keys2prods,
         prod_verts2verts, old_lows2new_lows, &prods2new_ents,
         &same_ents2old_ents, &same_ents2new_ents, &old_ents2new_ents);
+    old_dim_ents2new_ents[ent_dim] = old_ents2new_ents;
+    patch_up_adjs(mesh, &new_mesh, ent_dim, old_dim_ents2new_ents);
     if (ent_dim == VERT) {
       keys2midverts = prods2new_ents;
       old_verts2new_verts = old_ents2new_ents;
@@ -93,6 +97,7 @@ static bool refine(Mesh* mesh, AdaptOpts const& opts) {
 
 bool refine_by_size(Mesh* mesh, AdaptOpts const& opts) {
   OMEGA_H_TIME_FUNCTION;
+  ScopedArenaPhase arena_phase("refine_by_size");
   auto comm = mesh->comm();
   auto lengths = mesh->ask_lengths();
   auto edge_is_cand = each_gt(lengths, opts.max_length_desired);
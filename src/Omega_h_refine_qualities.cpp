@@ -20,14 +20,13 @@ struct MetricRefineQualities {
          */
         midpt_metrics(get_mident_metrics(
             mesh, EDGE, candidates, mesh->get_array<Real>(VERT, "metric"))) {}
-  OMEGA_H_DEVICE Real measure(Int cand, Few<Vector<mesh_dim>, mesh_dim + 1> p,
-      Few<LO, mesh_dim> csv2v) const {
+  OMEGA_H_DEVICE Few<Matrix<metric_dim, metric_dim>, mesh_dim + 1> gather(
+      Int cand, Few<LO, mesh_dim> csv2v) const {
     Few<Matrix<metric_dim, metric_dim>, mesh_dim + 1> ms;
     for (Int csv = 0; csv < mesh_dim; ++csv)
       ms[csv] = get_symm<metric_dim>(vert_metrics, csv2v[csv]);
     ms[mesh_dim] = get_symm<metric_dim>(midpt_metrics, cand);
-    auto m = maxdet_metric(ms);
-    return metric_element_quality(p, m);
+    return ms;
   }
 };
 
@@ -48,7 +47,7 @@ Reals refine_qualities_tmpl(Mesh* mesh, LOs candidates) {
     auto eev2v = gather_verts<2>(ev2v, e);
     auto ep = gather_vectors<2, mesh_dim>(coords, eev2v);
     auto midp = (ep[0] + ep[1]) / 2.;
-    auto minqual = 1.0;
+    MinMetricQuality<mesh_dim, metric_dim> minqual;
     for (auto ec = e2ec[e]; ec < e2ec[e + 1]; ++ec) {
       auto c = ec2c[ec];
       auto code = ec_codes[ec];
@@ -74,11 +73,10 @@ Reals refine_qualities_tmpl(Mesh* mesh, LOs candidates) {
         ncp[mesh_dim] = midp;
         flip_new_elem<mesh_dim>(&csv2v[0]);
         flip_new_elem<mesh_dim>(&ncp[0]);
-        auto cqual = measure.measure(cand, ncp, csv2v);
-        minqual = min2(minqual, cqual);
+        minqual.add(ncp, measure.gather(cand, csv2v));
       }
     }
-    quals_w[cand] = minqual;
+    quals_w[cand] = minqual.result();
   };
   parallel_for(ncands, f, "refine_qualities");
   auto cand_quals = Reals(quals_w);
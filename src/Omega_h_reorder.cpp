@@ -1,5 +1,6 @@
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_element.hpp"
+#include "Omega_h_for.hpp"
 #include "Omega_h_hilbert.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
@@ -7,6 +8,9 @@
 #include "Omega_h_sort.hpp"
 #include "Omega_h_unmap_mesh.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace Omega_h {
 
 /* Construct a graph from each vertex
@@ -54,16 +58,203 @@ static void reorder_mesh_by_verts(Mesh* mesh, LOs new_verts2old_verts) {
   unmap_mesh(mesh, new_ents2old_ents);
 }
 
+static void renumber_serial_mesh(Mesh* mesh, LOs new_verts2old_verts) {
+  reorder_mesh_by_verts(mesh, new_verts2old_verts);
+  for (Int ent_dim = 0; ent_dim <= mesh->dim(); ++ent_dim) {
+    mesh->remove_tag(ent_dim, "global");
+    mesh->add_tag(ent_dim, "global", 1, GOs(mesh->nents(ent_dim), 0, 1));
+  }
+}
+
 void reorder_by_hilbert(Mesh* mesh) {
   OMEGA_H_TIME_FUNCTION;
   OMEGA_H_CHECK(mesh->comm()->size() == 1);
   auto coords = mesh->coords();
   LOs new_verts2old_verts = hilbert::sort_coords(coords, mesh->dim());
-  reorder_mesh_by_verts(mesh, new_verts2old_verts);
-  for (Int ent_dim = 0; ent_dim <= mesh->dim(); ++ent_dim) {
-    mesh->remove_tag(ent_dim, "global");
-    mesh->add_tag(ent_dim, "global", 1, GOs(mesh->nents(ent_dim), 0, 1));
+  renumber_serial_mesh(mesh, new_verts2old_verts);
+}
+
+namespace {
+
+struct VertGraph {
+  HostRead<LO> a2ab;
+  HostRead<LO> ab2b;
+  LO degree(LO v) const { return a2ab[v + 1] - a2ab[v]; }
+};
+
+/* breadth-first level structure of the component containing (root),
+   returning the vertices in visiting order and their depths.
+   (stamp) marks vertices seen by this search */
+LO level_structure(VertGraph const& g, LO root, std::vector<LO>& stamps,
+    LO stamp, std::vector<LO>& queue, std::vector<LO>& depths) {
+  queue.clear();
+  queue.push_back(root);
+  depths[std::size_t(root)] = 0;
+  stamps[std::size_t(root)] = stamp;
+  LO max_depth = 0;
+  for (std::size_t i = 0; i < queue.size(); ++i) {
+    auto const v = queue[i];
+    auto const depth = depths[std::size_t(v)];
+    max_depth = std::max(max_depth, depth);
+    for (auto vv = g.a2ab[v]; vv < g.a2ab[v + 1]; ++vv) {
+      auto const w = g.ab2b[vv];
+      if (stamps[std::size_t(w)] == stamp) continue;
+      stamps[std::size_t(w)] = stamp;
+      depths[std::size_t(w)] = depth + 1;
+      queue.push_back(w);
+    }
   }
+  return max_depth;
+}
+
+}  // end anonymous namespace
+
+/* reverse Cuthill-McKee: each connected component is traversed
+   breadth-first from a pseudo-peripheral vertex (George and Liu),
+   visiting the neighbors of a vertex by increasing degree,
+   and the whole order is reversed at the end */
+static LOs rcm_order(Mesh* mesh) {
+  auto const v2v = mesh->ask_star(VERT);
+  VertGraph g{HostRead<LO>(v2v.a2ab), HostRead<LO>(v2v.ab2b)};
+  auto const nverts = std::size_t(mesh->nverts());
+  std::vector<LO> order;
+  order.reserve(nverts);
+  std::vector<LO> stamps(nverts, -1);
+  std::vector<LO> depths(nverts, 0);
+  std::vector<LO> queue;
+  std::vector<bool> visited(nverts, false);
+  std::vector<LO> neighbors;
+  LO stamp = 0;
+  for (std::size_t seed = 0; seed < nverts; ++seed) {
+    if (visited[seed]) continue;
+    auto root = LO(seed);
+    auto eccentricity =
+        level_structure(g, root, stamps, stamp++, queue, depths);
+    while (true) {
+      LO candidate = -1;
+      for (auto v : queue) {
+        if (depths[std::size_t(v)] != eccentricity) continue;
+        if (candidate == -1 || g.degree(v) < g.degree(candidate)) {
+          candidate = v;
+        }
+      }
+      auto const candidate_eccentricity =
+          level_structure(g, candidate, stamps, stamp++, queue, depths);
+      if (candidate_eccentricity <= eccentricity) break;
+      root = candidate;
+      eccentricity = candidate_eccentricity;
+    }
+    auto const begin = order.size();
+    order.push_back(root);
+    visited[std::size_t(root)] = true;
+    for (auto i = begin; i < order.size(); ++i) {
+      auto const v = order[i];
+      neighbors.clear();
+      for (auto vv = g.a2ab[v]; vv < g.a2ab[v + 1]; ++vv) {
+        auto const w = g.ab2b[vv];
+        if (visited[std::size_t(w)]) continue;
+        visited[std::size_t(w)] = true;
+        neighbors.push_back(w);
+      }
+      std::stable_sort(neighbors.begin(), neighbors.end(),
+          [&](LO a, LO b) { return g.degree(a) < g.degree(b); });
+      order.insert(order.end(), neighbors.begin(), neighbors.end());
+    }
+  }
+  OMEGA_H_CHECK(order.size() == nverts);
+  HostWrite<LO> new_verts2old_verts(LO(nverts), "rcm order");
+  for (std::size_t i = 0; i < nverts; ++i) {
+    new_verts2old_verts[LO(i)] = order[nverts - 1 - i];
+  }
+  return new_verts2old_verts.write();
+}
+
+/* recursive coordinate bisection: the vertices are split at the
+   median of the longest side of their bounding box, each half is
+   ordered the same way, and the first half is numbered first.
+   every subtree of the recursion is then a contiguous, compact
+   index range, whatever the cache size */
+static void bisect(
+    HostRead<Real> const& coords, Int dim, LO* begin, LO* end) {
+  while (end - begin > 2) {
+    Real lo[3] = {0, 0, 0};
+    Real hi[3] = {0, 0, 0};
+    for (Int d = 0; d < dim; ++d) lo[d] = hi[d] = coords[*begin * dim + d];
+    for (auto it = begin; it != end; ++it) {
+      for (Int d = 0; d < dim; ++d) {
+        lo[d] = std::min(lo[d], coords[*it * dim + d]);
+        hi[d] = std::max(hi[d], coords[*it * dim + d]);
+      }
+    }
+    Int axis = 0;
+    for (Int d = 1; d < dim; ++d) {
+      if (hi[d] - lo[d] > hi[axis] - lo[axis]) axis = d;
+    }
+    auto const mid = begin + (end - begin) / 2;
+    std::nth_element(begin, mid, end, [&](LO a, LO b) {
+      return coords[a * dim + axis] < coords[b * dim + axis];
+    });
+    bisect(coords, dim, begin, mid);
+    begin = mid;
+  }
+}
+
+static LOs bisection_order(Mesh* mesh) {
+  auto const coords = HostRead<Real>(mesh->coords());
+  auto const nverts = mesh->nverts();
+  std::vector<LO> order(static_cast<std::size_t>(nverts));
+  for (LO i = 0; i < nverts; ++i) order[std::size_t(i)] = i;
+  bisect(coords, mesh->dim(), order.data(), order.data() + nverts);
+  HostWrite<LO> new_verts2old_verts(nverts, "bisection order");
+  for (LO i = 0; i < nverts; ++i) {
+    new_verts2old_verts[i] = order[std::size_t(i)];
+  }
+  return new_verts2old_verts.write();
+}
+
+void reorder_by_rcm(Mesh* mesh) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(mesh->comm()->size() == 1);
+  renumber_serial_mesh(mesh, rcm_order(mesh));
+}
+
+void reorder_by_bisection(Mesh* mesh) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(mesh->comm()->size() == 1);
+  renumber_serial_mesh(mesh, bisection_order(mesh));
+}
+
+OrderLocality measure_order_locality(Mesh* mesh) {
+  OrderLocality out;
+  auto const ev2v = mesh->ask_verts_of(EDGE);
+  auto const nedges = mesh->nedges();
+  Write<Real> edge_spans(nedges);
+  auto edge_f = OMEGA_H_LAMBDA(LO e) {
+    auto const a = ev2v[e * 2 + 0];
+    auto const b = ev2v[e * 2 + 1];
+    edge_spans[e] = Real((a < b) ? (b - a) : (a - b));
+  };
+  parallel_for(nedges, edge_f, "edge_spans");
+  out.mean_edge_span = nedges ? get_sum(Reals(edge_spans)) / nedges : 0.0;
+  out.max_edge_span = nedges ? LO(get_max(Reals(edge_spans))) : 0;
+  auto const dim = mesh->dim();
+  auto const deg = element_degree(mesh->family(), dim, VERT);
+  auto const elems2verts = mesh->ask_elem_verts();
+  auto const nelems = mesh->nelems();
+  Write<Real> elem_spans(nelems);
+  auto elem_f = OMEGA_H_LAMBDA(LO e) {
+    auto lo = elems2verts[e * deg];
+    auto hi = lo;
+    for (Int i = 1; i < deg; ++i) {
+      auto const v = elems2verts[e * deg + i];
+      lo = (v < lo) ? v : lo;
+      hi = (v > hi) ? v : hi;
+    }
+    elem_spans[e] = Real(hi - lo);
+  };
+  parallel_for(nelems, elem_f, "elem_spans");
+  out.mean_elem_span = nelems ? get_sum(Reals(elem_spans)) / nelems : 0.0;
+  return out;
 }
 
 void reorder_by_globals(Mesh* mesh) {
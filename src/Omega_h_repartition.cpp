@@ -0,0 +1,519 @@
+#include "Omega_h_repartition.hpp"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_element.hpp"
+#include "Omega_h_for.hpp"
+#include "Omega_h_int_scan.hpp"
+#include "Omega_h_map.hpp"
+#include "Omega_h_profile.hpp"
+#include "Omega_h_vector.hpp"
+
+namespace Omega_h {
+
+Dist DistGraph::neighbors() const {
+  return Dist(comm, ab2b, nnodes()).invert();
+}
+
+DistGraph build_dual_graph(Mesh* mesh, Reals weights) {
+  OMEGA_H_TIME_FUNCTION;
+  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_ELEM_BASED);
+  auto const dim = mesh->dim();
+  auto const nelems = mesh->nelems();
+  auto const comm = mesh->comm();
+  auto const rank = comm->rank();
+  OMEGA_H_CHECK(weights.size() == nelems);
+  auto const sides2elems = mesh->ask_up(dim - 1, dim);
+  auto const side_offsets = sides2elems.a2ab;
+  auto const side_elems = sides2elems.ab2b;
+  auto const nsides = mesh->nents(dim - 1);
+  /* a side between two ranks has one element on each, so summing
+     (1, rank, element) over its copies tells each about the other */
+  Write<LO> mine_w(nsides * 3);
+  auto f = OMEGA_H_LAMBDA(LO s) {
+    auto const one = (side_offsets[s + 1] - side_offsets[s]) == 1;
+    mine_w[s * 3 + 0] = one;
+    mine_w[s * 3 + 1] = one ? rank : 0;
+    mine_w[s * 3 + 2] = one ? side_elems[side_offsets[s]] : 0;
+  };
+  parallel_for(nsides, f, "build_dual_graph(sides)");
+  LOs const mine = mine_w;
+  auto const sums = mesh->sync_array(
+      dim - 1, mesh->reduce_array(dim - 1, mine, 3, OMEGA_H_SUM), 3);
+  auto const dual = mesh->ask_dual();
+  auto const dual_offsets = dual.a2ab;
+  auto const dual_elems = dual.ab2b;
+  auto const elems2sides = mesh->ask_down(dim, dim - 1).ab2b;
+  auto const sides_per_elem = element_degree(mesh->family(), dim, dim - 1);
+  Write<LO> degrees_w(nelems);
+  auto count = OMEGA_H_LAMBDA(LO e) {
+    auto n = dual_offsets[e + 1] - dual_offsets[e];
+    for (Int i = 0; i < sides_per_elem; ++i) {
+      auto const s = elems2sides[e * sides_per_elem + i];
+      if (sums[s * 3] == 2 && mine[s * 3] == 1) ++n;
+    }
+    degrees_w[e] = n;
+  };
+  parallel_for(nelems, count, "build_dual_graph(count)");
+  auto const offsets = offset_scan(LOs(degrees_w));
+  Write<I32> ranks_w(offsets.last());
+  Write<LO> idxs_w(offsets.last());
+  auto fill = OMEGA_H_LAMBDA(LO e) {
+    auto k = offsets[e];
+    for (auto j = dual_offsets[e]; j < dual_offsets[e + 1]; ++j) {
+      ranks_w[k] = rank;
+      idxs_w[k] = dual_elems[j];
+      ++k;
+    }
+    for (Int i = 0; i < sides_per_elem; ++i) {
+      auto const s = elems2sides[e * sides_per_elem + i];
+      if (!(sums[s * 3] == 2 && mine[s * 3] == 1)) continue;
+      ranks_w[k] = sums[s * 3 + 1] - rank;
+      idxs_w[k] = sums[s * 3 + 2] - e;
+      ++k;
+    }
+  };
+  parallel_for(nelems, fill, "build_dual_graph(fill)");
+  auto coords =
+      average_field(mesh, dim, LOs(nelems, 0, 1), dim, mesh->coords());
+  if (dim < 3) coords = resize_vectors(coords, dim, 3);
+  DistGraph g;
+  g.comm = comm;
+  g.a2ab = offsets;
+  g.ab2b = Remotes(ranks_w, idxs_w);
+  g.edge_weights = Reals(offsets.last(), 1.0);
+  g.weights = weights;
+  g.coords = coords;
+  g.sizes = Reals(nelems, 1.0);
+  return g;
+}
+
+Read<I32> partition_rib(DistGraph const& g, inertia::Rib* hints) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const comm = g.comm;
+  auto const n = g.nnodes();
+  if (comm->size() == 1) return Read<I32>(n, 0);
+  auto coords = g.coords;
+  auto masses = g.weights;
+  auto owners = identity_remotes(comm, n);
+  auto const tolerance = 2.0 * max2(0.0, get_max(comm, masses));
+  inertia::recursively_bisect(
+      comm, tolerance, &coords, &masses, &owners, hints);
+  /* whatever ended up here belongs to this rank */
+  auto const back = Dist(comm, owners, n);
+  return back.exch_reduce(
+      Read<I32>(owners.ranks.size(), comm->rank()), 1, OMEGA_H_MAX);
+}
+
+/* sends each node to the one root of the rank its part is numbered by */
+static Dist dist_to_parts(CommPtr comm, Read<I32> parts) {
+  return Dist(comm, Remotes(parts, LOs(parts.size(), 0)), 1);
+}
+
+/* RIB numbers its parts by where they are in space, so renumber them
+   to keep as many elements as possible where they are: every rank
+   reports its largest overlaps with parts and rank 0 hands out part
+   numbers greedily, largest overlap first */
+static Read<I32> renumber_parts(DistGraph const& g, Read<I32> parts) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const comm = g.comm;
+  auto const rank = comm->rank();
+  auto const nparts = comm->size();
+  Int const ntop = 4;
+  std::map<I32, Real> overlaps;
+  HostRead<I32> h_parts(parts);
+  HostRead<Real> h_sizes(g.sizes);
+  for (LO i = 0; i < h_parts.size(); ++i) overlaps[h_parts[i]] += h_sizes[i];
+  std::vector<std::pair<Real, I32>> sorted;
+  for (auto const& overlap : overlaps) {
+    sorted.emplace_back(overlap.second, overlap.first);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+      [](std::pair<Real, I32> const& a, std::pair<Real, I32> const& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+      });
+  HostWrite<Real> h_top(2 * ntop);
+  for (Int i = 0; i < ntop; ++i) {
+    auto const have = std::size_t(i) < sorted.size();
+    h_top[2 * i + 0] = have ? Real(sorted[std::size_t(i)].second) : -1.0;
+    h_top[2 * i + 1] = have ? sorted[std::size_t(i)].first : 0.0;
+  }
+  auto const to_root =
+      Dist(comm, Remotes(Read<I32>(ntop, 0), LOs(ntop, rank * ntop, 1)),
+          rank == 0 ? nparts * ntop : 0);
+  auto const top = to_root.exch_reduce(Reals(h_top.write()), 2, OMEGA_H_MAX);
+  HostWrite<I32> h_numbers(rank == 0 ? nparts : 0);
+  if (rank == 0) {
+    HostRead<Real> h_all(top);
+    std::vector<std::tuple<Real, I32, I32>> pairs;
+    for (I32 r = 0; r < nparts; ++r) {
+      for (Int i = 0; i < ntop; ++i) {
+        auto const part = I32(h_all[(r * ntop + i) * 2]);
+        if (part < 0) continue;
+        pairs.emplace_back(h_all[(r * ntop + i) * 2 + 1], r, part);
+      }
+    }
+    std::sort(pairs.begin(), pairs.end(),
+        [](std::tuple<Real, I32, I32> const& a,
+            std::tuple<Real, I32, I32> const& b) {
+          if (std::get<0>(a) != std::get<0>(b)) {
+            return std::get<0>(a) > std::get<0>(b);
+          }
+          return std::make_pair(std::get<1>(a), std::get<2>(a)) <
+                 std::make_pair(std::get<1>(b), std::get<2>(b));
+        });
+    std::vector<I32> numbers(std::size_t(nparts), -1);
+    std::vector<bool> taken(std::size_t(nparts), false);
+    for (auto const& pair : pairs) {
+      auto const r = std::size_t(std::get<1>(pair));
+      auto const part = std::size_t(std::get<2>(pair));
+      if (numbers[part] >= 0 || taken[r]) continue;
+      numbers[part] = I32(r);
+      taken[r] = true;
+    }
+    std::size_t next = 0;
+    for (auto& number : numbers) {
+      if (number >= 0) continue;
+      while (taken[next]) ++next;
+      number = I32(next);
+      taken[next] = true;
+    }
+    for (I32 i = 0; i < nparts; ++i) h_numbers[i] = numbers[std::size_t(i)];
+  }
+  /* rank 0 tells rank p the new number of part p,
+     then each node asks the rank of its part */
+  auto const from_root = Dist(comm,
+      Remotes(rank == 0 ? Read<I32>(nparts, 0, 1) : Read<I32>({}),
+          LOs(rank == 0 ? nparts : 0, 0)),
+      1);
+  auto const number =
+      from_root.exch_reduce(Read<I32>(h_numbers.write()), 1, OMEGA_H_MAX);
+  return dist_to_parts(comm, parts).invert().exch(number, 1);
+}
+
+/* given the (weight, gain) of each node asking to join this rank's
+   part, lets in those with the largest gains while there is room */
+static Read<I8> admit(Reals offers, Real room) {
+  HostRead<Real> h_offers(offers);
+  auto const n = h_offers.size() / 2;
+  std::vector<LO> order(static_cast<std::size_t>(n));
+  for (LO i = 0; i < n; ++i) order[std::size_t(i)] = i;
+  std::stable_sort(order.begin(), order.end(), [&](LO a, LO b) {
+    return h_offers[a * 2 + 1] > h_offers[b * 2 + 1];
+  });
+  HostWrite<I8> h_admitted(n);
+  for (auto const i : order) {
+    h_admitted[i] = h_offers[i * 2] <= room;
+    if (h_admitted[i]) room -= h_offers[i * 2];
+  }
+  return h_admitted.write();
+}
+
+/* moves boundary nodes to the neighboring part with the largest gain,
+   counting both the weight of the cut edges and the cost of moving the
+   node's elements away from this rank. passes alternate between moving
+   only to higher and only to lower part numbers so that neighbors do
+   not swap places, and each part admits the nodes asking to come in
+   by gain while it has room for them */
+static Read<I32> refine_parts(DistGraph const& g, Dist const& neighbors,
+    Read<I32> parts, Real max_load, Real migration_cost) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const comm = g.comm;
+  auto const rank = comm->rank();
+  auto const n = g.nnodes();
+  auto const offsets = g.a2ab;
+  auto const edge_weights = g.edge_weights;
+  auto const weights = g.weights;
+  auto const sizes = g.sizes;
+  Int const npasses = 4;
+  for (Int pass = 0; pass < npasses; ++pass) {
+    auto const to_parts = dist_to_parts(comm, parts);
+    auto const load = to_parts.exch_reduce(weights, 1, OMEGA_H_SUM);
+    auto const node_loads = to_parts.invert().exch(load, 1);
+    auto const nbr_parts = neighbors.exch(parts, 1);
+    auto const upward = (pass % 2 == 0);
+    Write<I32> targets_w(n);
+    Write<Real> offers_w(n * 2);
+    auto choose = OMEGA_H_LAMBDA(LO v) {
+      constexpr Int max_candidates = 16;
+      I32 candidates[max_candidates];
+      Real connections[max_candidates];
+      Int ncandidates = 0;
+      auto const p = parts[v];
+      Real internal = 0.0;
+      for (auto e = offsets[v]; e < offsets[v + 1]; ++e) {
+        auto const q = nbr_parts[e];
+        if (q == p) {
+          internal += edge_weights[e];
+          continue;
+        }
+        Int c = 0;
+        while (c < ncandidates && candidates[c] != q) ++c;
+        if (c == ncandidates) {
+          if (ncandidates == max_candidates) continue;
+          candidates[c] = q;
+          connections[c] = 0.0;
+          ++ncandidates;
+        }
+        connections[c] += edge_weights[e];
+      }
+      /* a node of an overloaded part may move anywhere,
+         even if that cuts more */
+      auto const overloaded = node_loads[v] > max_load;
+      auto const stay_cost = (p == rank) ? 0.0 : migration_cost * sizes[v];
+      I32 best = -1;
+      Real best_gain = overloaded ? -ArithTraits<Real>::max() : 0.0;
+      for (Int c = 0; c < ncandidates; ++c) {
+        auto const q = candidates[c];
+        if (!overloaded && ((q > p) != upward)) continue;
+        auto const move_cost = (q == rank) ? 0.0 : migration_cost * sizes[v];
+        auto const gain = connections[c] - internal + stay_cost - move_cost;
+        if (gain > best_gain || (best >= 0 && gain == best_gain && q < best)) {
+          best = q;
+          best_gain = gain;
+        }
+      }
+      targets_w[v] = best;
+      offers_w[v * 2 + 0] = weights[v];
+      offers_w[v * 2 + 1] = best_gain;
+    };
+    parallel_for(n, choose, "refine_parts(choose)");
+    Read<I32> const targets = targets_w;
+    auto const movers = collect_marked(each_geq_to(targets, I32(0)));
+    auto const mover_parts = read(unmap(movers, targets, 1));
+    auto const requests =
+        Dist(comm, Remotes(mover_parts, LOs(movers.size(), 0)), 1);
+    auto const offers = requests.exch(read(unmap(movers, Reals(offers_w), 2)), 2);
+    auto const admitted = admit(offers, max_load - load.get(0));
+    auto replies = requests.invert();
+    replies.set_roots2items(LOs());
+    auto const moved = replies.exch(admitted, 1);
+    auto new_parts_w = deep_copy(parts);
+    auto accept = OMEGA_H_LAMBDA(LO i) {
+      if (moved[i]) new_parts_w[movers[i]] = mover_parts[i];
+    };
+    parallel_for(movers.size(), accept, "refine_parts(accept)");
+    parts = new_parts_w;
+    if (get_sum(comm, moved) == 0) break;
+  }
+  return parts;
+}
+
+/* pairs nodes along their heaviest edges to nodes of the same rank,
+   without letting a pair outweigh max_weight */
+static DistGraph coarsen(DistGraph const& g, Dist const& neighbors,
+    Real max_weight, LOs* p_fine2coarse) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const rank = g.comm->rank();
+  auto const n = g.nnodes();
+  auto const offsets = g.a2ab;
+  auto const nbr_ranks = g.ab2b.ranks;
+  auto const nbr_idxs = g.ab2b.idxs;
+  auto const edge_weights = g.edge_weights;
+  auto const weights = g.weights;
+  auto const sizes = g.sizes;
+  auto const coords = g.coords;
+  Write<LO> match(n, -1);
+  Int const nrounds = 4;
+  for (Int round = 0; round < nrounds; ++round) {
+    Write<LO> proposals(n, -1);
+    auto propose = OMEGA_H_LAMBDA(LO v) {
+      if (match[v] >= 0) return;
+      LO best = -1;
+      Real best_weight = 0.0;
+      for (auto e = offsets[v]; e < offsets[v + 1]; ++e) {
+        if (nbr_ranks[e] != rank) continue;
+        auto const u = nbr_idxs[e];
+        if (u == v || match[u] >= 0) continue;
+        if (weights[v] + weights[u] > max_weight) continue;
+        auto const w = edge_weights[e];
+        if (best < 0 || w > best_weight || (w == best_weight && u < best)) {
+          best = u;
+          best_weight = w;
+        }
+      }
+      proposals[v] = best;
+    };
+    parallel_for(n, propose, "coarsen(propose)");
+    auto accept = OMEGA_H_LAMBDA(LO v) {
+      auto const u = proposals[v];
+      if (u >= 0 && proposals[u] == v) match[v] = u;
+    };
+    parallel_for(n, accept, "coarsen(accept)");
+  }
+  Write<I8> leads_w(n);
+  auto lead = OMEGA_H_LAMBDA(LO v) {
+    leads_w[v] = match[v] < 0 || v < match[v];
+  };
+  parallel_for(n, lead, "coarsen(lead)");
+  auto const leaders = collect_marked(Read<I8>(leads_w));
+  auto const coarse_ids = offset_scan(Read<I8>(leads_w));
+  auto const nc = leaders.size();
+  Write<LO> fine2coarse_w(n);
+  auto number = OMEGA_H_LAMBDA(LO v) {
+    fine2coarse_w[v] = coarse_ids[(match[v] < 0 || v < match[v]) ? v : match[v]];
+  };
+  parallel_for(n, number, "coarsen(number)");
+  LOs const fine2coarse = fine2coarse_w;
+  auto const coarse_idxs = neighbors.exch(fine2coarse, 1);
+  Write<Real> cweights(nc);
+  Write<Real> csizes(nc);
+  Write<Real> ccoords(nc * 3);
+  Write<LO> degrees(nc);
+  /* the edges of a coarse node are those of its fine nodes,
+     less the one between them and counting repeats once */
+  auto count = OMEGA_H_LAMBDA(LO c) {
+    auto const v = leaders[c];
+    auto const u = match[v];
+    auto const dv = offsets[v + 1] - offsets[v];
+    auto const m = dv + ((u >= 0) ? offsets[u + 1] - offsets[u] : 0);
+    LO degree = 0;
+    for (LO k = 0; k < m; ++k) {
+      auto const e = (k < dv) ? offsets[v] + k : offsets[u] + (k - dv);
+      auto const r = nbr_ranks[e];
+      auto const i = coarse_idxs[e];
+      if (r == rank && i == c) continue;
+      bool first = true;
+      for (LO k2 = 0; k2 < k && first; ++k2) {
+        auto const e2 = (k2 < dv) ? offsets[v] + k2 : offsets[u] + (k2 - dv);
+        first = !(nbr_ranks[e2] == r && coarse_idxs[e2] == i);
+      }
+      degree += first;
+    }
+    degrees[c] = degree;
+    auto const wu = (u >= 0) ? weights[u] : 0.0;
+    auto const su = (u >= 0) ? sizes[u] : 0.0;
+    cweights[c] = weights[v] + wu;
+    csizes[c] = sizes[v] + su;
+    for (Int j = 0; j < 3; ++j) {
+      auto const xu = (u >= 0) ? coords[u * 3 + j] : 0.0;
+      ccoords[c * 3 + j] = (sizes[v] * coords[v * 3 + j] + su * xu) / csizes[c];
+    }
+  };
+  parallel_for(nc, count, "coarsen(count)");
+  auto const coffsets = offset_scan(LOs(degrees));
+  Write<I32> cranks(coffsets.last());
+  Write<LO> cidxs(coffsets.last());
+  Write<Real> cedge_weights(coffsets.last());
+  auto fill = OMEGA_H_LAMBDA(LO c) {
+    auto const v = leaders[c];
+    auto const u = match[v];
+    auto const dv = offsets[v + 1] - offsets[v];
+    auto const m = dv + ((u >= 0) ? offsets[u + 1] - offsets[u] : 0);
+    auto ce = coffsets[c];
+    for (LO k = 0; k < m; ++k) {
+      auto const e = (k < dv) ? offsets[v] + k : offsets[u] + (k - dv);
+      auto const r = nbr_ranks[e];
+      auto const i = coarse_idxs[e];
+      if (r == rank && i == c) continue;
+      bool first = true;
+      for (LO k2 = 0; k2 < k && first; ++k2) {
+        auto const e2 = (k2 < dv) ? offsets[v] + k2 : offsets[u] + (k2 - dv);
+        first = !(nbr_ranks[e2] == r && coarse_idxs[e2] == i);
+      }
+      if (!first) continue;
+      Real w = 0.0;
+      for (LO k2 = k; k2 < m; ++k2) {
+        auto const e2 = (k2 < dv) ? offsets[v] + k2 : offsets[u] + (k2 - dv);
+        if (nbr_ranks[e2] == r && coarse_idxs[e2] == i) w += edge_weights[e2];
+      }
+      cranks[ce] = r;
+      cidxs[ce] = i;
+      cedge_weights[ce] = w;
+      ++ce;
+    }
+  };
+  parallel_for(nc, fill, "coarsen(fill)");
+  DistGraph coarse;
+  coarse.comm = g.comm;
+  coarse.a2ab = coffsets;
+  coarse.ab2b = Remotes(cranks, cidxs);
+  coarse.edge_weights = cedge_weights;
+  coarse.weights = cweights;
+  coarse.coords = ccoords;
+  coarse.sizes = csizes;
+  *p_fine2coarse = fine2coarse;
+  return coarse;
+}
+
+Read<I32> partition_multilevel(DistGraph const& g, Real max_imbalance,
+    Real migration_cost, inertia::Rib* hints) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const comm = g.comm;
+  auto const nparts = comm->size();
+  if (nparts == 1) return Read<I32>(g.nnodes(), 0);
+  auto const average = get_sum(comm, g.weights) / nparts;
+  auto const max_load = max_imbalance * average;
+  /* coarse nodes stay light enough to balance the parts with */
+  auto const max_weight = max2(max_imbalance - 1.0, 0.01) * average;
+  GO const coarse_nodes_per_part = 64;
+  std::vector<DistGraph> graphs({g});
+  std::vector<Dist> neighbors({g.neighbors()});
+  std::vector<LOs> fine2coarse;
+  auto nnodes = comm->allreduce(GO(g.nnodes()), OMEGA_H_SUM);
+  while (nnodes > coarse_nodes_per_part * nparts) {
+    LOs level_fine2coarse;
+    auto coarse = coarsen(
+        graphs.back(), neighbors.back(), max_weight, &level_fine2coarse);
+    auto const ncoarse = comm->allreduce(GO(coarse.nnodes()), OMEGA_H_SUM);
+    if (ncoarse > GO(0.9 * Real(nnodes))) break;
+    fine2coarse.push_back(level_fine2coarse);
+    graphs.push_back(coarse);
+    neighbors.push_back(coarse.neighbors());
+    nnodes = ncoarse;
+  }
+  /* a partition that is balanced already is only refined,
+     otherwise it starts over from RIB */
+  auto const& coarsest = graphs.back();
+  auto parts = Read<I32>(coarsest.nnodes(), comm->rank());
+  if (comm->allreduce(get_sum(coarsest.weights), OMEGA_H_MAX) > max_load) {
+    parts = renumber_parts(coarsest, partition_rib(coarsest, hints));
+  }
+  parts = refine_parts(
+      coarsest, neighbors.back(), parts, max_load, migration_cost);
+  for (auto level = graphs.size() - 1; level-- > 0;) {
+    parts = read(unmap(fine2coarse[level], parts, 1));
+    parts = refine_parts(
+        graphs[level], neighbors[level], parts, max_load, migration_cost);
+  }
+  return parts;
+}
+
+BalanceStats assess_partition(
+    DistGraph const& g, Read<I32> parts, Real bytes_per_size) {
+  OMEGA_H_TIME_FUNCTION;
+  auto const comm = g.comm;
+  auto const rank = comm->rank();
+  auto const nbr_parts = g.neighbors().exch(parts, 1);
+  auto const offsets = g.a2ab;
+  auto const edge_weights = g.edge_weights;
+  auto const sizes = g.sizes;
+  Write<Real> cut_w(g.nnodes());
+  Write<Real> migrated_w(g.nnodes());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    Real cut = 0.0;
+    for (auto e = offsets[v]; e < offsets[v + 1]; ++e) {
+      if (nbr_parts[e] != parts[v]) cut += edge_weights[e];
+    }
+    cut_w[v] = cut;
+    migrated_w[v] = (parts[v] == rank) ? 0.0 : sizes[v];
+  };
+  parallel_for(g.nnodes(), f, "assess_partition");
+  BalanceStats stats;
+  /* every cut edge was counted from both of its ends */
+  stats.edge_cut = GO(get_sum(comm, Reals(cut_w)) / 2.0 + 0.5);
+  auto const migrated = get_sum(comm, Reals(migrated_w));
+  stats.migrated = GO(migrated + 0.5);
+  stats.migrated_bytes = GO(migrated * bytes_per_size + 0.5);
+  auto const load = dist_to_parts(comm, parts).exch_reduce(
+      g.weights, 1, OMEGA_H_SUM);
+  auto const average = get_sum(comm, g.weights) / comm->size();
+  stats.imbalance = (average > 0.0) ? get_max(comm, load) / average : 1.0;
+  return stats;
+}
+
+}  // end namespace Omega_h
@@ -0,0 +1,44 @@
+#ifndef OMEGA_H_REPARTITION_HPP
+#define OMEGA_H_REPARTITION_HPP
+
+#include <Omega_h_dist.hpp>
+#include <Omega_h_inertia.hpp>
+#include <Omega_h_mesh.hpp>
+
+namespace Omega_h {
+
+/* a symmetric graph whose nodes are spread over the ranks of a Comm.
+   each node lists its neighbors by rank and index there, and stands
+   for (sizes) elements of the mesh, all currently on this rank */
+struct DistGraph {
+  CommPtr comm;
+  LOs a2ab;
+  Remotes ab2b;
+  Reals edge_weights;
+  Reals weights;
+  Reals coords;  // 3 per node
+  Reals sizes;
+  LO nnodes() const { return weights.size(); }
+  /* carries node data to the edges pointing at the node */
+  Dist neighbors() const;
+};
+
+/* the elements of an element-based mesh, connected across their sides
+   including those shared with other ranks */
+DistGraph build_dual_graph(Mesh* mesh, Reals weights);
+
+/* the rank each node goes to */
+Read<I32> partition_rib(DistGraph const& g, inertia::Rib* hints);
+/* coarsens by matching nodes along heavy edges, partitions the
+   coarsest graph by RIB with its parts renumbered to overlap the
+   ranks they are on, then refines the boundary on the way back
+   with gains that count cut edges and migrated elements */
+Read<I32> partition_multilevel(DistGraph const& g, Real max_imbalance,
+    Real migration_cost, inertia::Rib* hints);
+
+BalanceStats assess_partition(
+    DistGraph const& g, Read<I32> parts, Real bytes_per_size);
+
+}  // end namespace Omega_h
+
+#endif
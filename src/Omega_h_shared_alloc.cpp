@@ -3,6 +3,8 @@
 #include <Omega_h_malloc.hpp>
 #include <Omega_h_profile.hpp>
 #include <Omega_h_shared_alloc.hpp>
+#include <Omega_h_trace.hpp>
+#include <map>
 #include <sstream>
 
 namespace Omega_h {
@@ -41,6 +43,33 @@ void stop_tracking_allocations(Library* lib) {
     auto s = ss.str();
     std::printf("%s\n", s.c_str());
   }
+  if (!global_allocs->phase_records.empty() && comm->rank() == 0) {
+    std::map<std::string, PhaseRecord> totals;
+    std::map<std::string, std::size_t> ncalls;
+    for (auto& rec : global_allocs->phase_records) {
+      auto it = totals.find(rec.name);
+      if (it == totals.end()) {
+        totals[rec.name] = rec;
+      } else {
+        it->second.allocations += rec.allocations;
+        it->second.reused_allocations += rec.reused_allocations;
+        it->second.reused_bytes += rec.reused_bytes;
+        it->second.released_bytes += rec.released_bytes;
+      }
+      ++ncalls[rec.name];
+    }
+    std::stringstream ss;
+    ss << "Arena phases on MPI rank 0:\n";
+    for (auto& pair : totals) {
+      auto& rec = pair.second;
+      ss << rec.name << " (" << ncalls[rec.name] << " calls): "
+         << rec.allocations << " allocations, " << rec.reused_allocations
+         << " reused (" << rec.reused_bytes << " bytes), "
+         << rec.released_bytes << " bytes released.\n";
+    }
+    auto s = ss.str();
+    std::printf("%s\n", s.c_str());
+  }
   delete global_allocs;
   global_allocs = nullptr;
 }
@@ -55,10 +84,25 @@ Alloc::Alloc(std::size_t size_in, std::string&& name_in)
   init();
 }
 
+Alloc::Alloc(std::size_t size_in, std::string const& name_in, void* ptr_in,
+    std::shared_ptr<void> owner_in)
+    : size(size_in),
+      name(name_in),
+      ptr(ptr_in),
+      use_count(1),
+      prev(nullptr),
+      next(nullptr),
+      owner(std::move(owner_in)) {
+  OMEGA_H_CHECK(owner != nullptr);
+}
+
 OMEGA_H_DLL Alloc::~Alloc() {
+  if (owner) return;
   ::Omega_h::maybe_pooled_device_free(ptr, size);
+  if (profile::global_trace) profile::global_trace->freed(size);
   auto ga = global_allocs;
-  if (ga) {
+  // allocations made before tracking started are not in the list
+  if (ga && (prev != nullptr || ga->first == this)) {
     if (next == nullptr) {
       ga->last = prev;
     } else {
@@ -76,6 +120,8 @@ OMEGA_H_DLL Alloc::~Alloc() {
 void Alloc::init() {
   ptr = ::Omega_h::maybe_pooled_device_malloc(size);
   use_count = 1;
+  prev = nullptr;
+  next = nullptr;
   auto ga = global_allocs;
   if (size && (ptr == nullptr)) {
     std::stringstream ss;
@@ -90,16 +136,16 @@ void Alloc::init() {
     auto s = ss.str();
     Omega_h_fail("%s\n", s.c_str());
   }
+  if (profile::global_trace) profile::global_trace->allocated(size);
   if (ga) {
     auto old_last = ga->last;
     this->prev = old_last;
-    this->next = nullptr;
     if (old_last) {
       old_last->next = this;
     } else {
       ga->first = this;
-      ga->last = this;
     }
+    ga->last = this;
     ga->total_bytes += size;
     if (ga->total_bytes > ga->high_water_bytes) {
       Omega_h::ScopedTimer high_water_timer("high water update");
@@ -108,6 +154,8 @@ void Alloc::init() {
       for (auto a = ga->first; a; a = a->next) {
         ga->high_water_records.push_back({a->name, a->size});
       }
+      auto const cached = arena_cached_bytes();
+      if (cached) ga->high_water_records.push_back({"(arena free lists)", cached});
     }
   }
 }
@@ -124,6 +172,12 @@ SharedAlloc::SharedAlloc(std::size_t size_in, std::string&& name_in) {
 
 SharedAlloc::SharedAlloc(std::size_t size_in) : SharedAlloc(size_in, "") {}
 
+SharedAlloc::SharedAlloc(std::size_t size_in, std::string const& name_in,
+    void* ptr_in, std::shared_ptr<void> owner_in) {
+  alloc = new Alloc(size_in, name_in, ptr_in, std::move(owner_in));
+  direct_ptr = alloc->ptr;
+}
+
 SharedAlloc SharedAlloc::identity(std::size_t size_in) {
   SharedAlloc out;
   out.direct_ptr = nullptr;
@@ -3,6 +3,7 @@
 
 #include <Omega_h_macros.h>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -25,8 +26,13 @@ struct Alloc {
   int use_count;
   Alloc* prev;
   Alloc* next;
+  /* when set, ptr points into memory kept alive by this owner
+     (e.g. a mapped file) and is not freed or tracked here */
+  std::shared_ptr<void> owner;
   Alloc(std::size_t size_in, std::string const& name_in);
   Alloc(std::size_t size_in, std::string&& name_in);
+  Alloc(std::size_t size_in, std::string const& name_in, void* ptr_in,
+      std::shared_ptr<void> owner_in);
   OMEGA_H_DLL ~Alloc();
   Alloc(Alloc const&) = delete;
   Alloc(Alloc&&) = delete;
@@ -40,12 +46,23 @@ struct HighWaterRecord {
   std::size_t bytes;
 };
 
+/* allocator activity during one arena phase,
+   see begin_arena_phase() in Omega_h_malloc.hpp */
+struct PhaseRecord {
+  std::string name;
+  std::size_t allocations;
+  std::size_t reused_allocations;
+  std::size_t reused_bytes;
+  std::size_t released_bytes;
+};
+
 struct Allocs {
   Alloc* first;
   Alloc* last;
   std::size_t total_bytes;
   std::size_t high_water_bytes;
   std::vector<HighWaterRecord> high_water_records;
+  std::vector<PhaseRecord> phase_records;
 };
 
 struct SharedAlloc {
@@ -55,6 +72,8 @@ struct SharedAlloc {
   SharedAlloc(std::size_t size_in, std::string const& name_in);
   SharedAlloc(std::size_t size_in, std::string&& name_in);
   SharedAlloc(std::size_t size_in);
+  SharedAlloc(std::size_t size_in, std::string const& name_in, void* ptr_in,
+      std::shared_ptr<void> owner_in);
   enum : std::uintptr_t {
     FREE_BIT1 = 0x1,
     FREE_BIT2 = 0x2,
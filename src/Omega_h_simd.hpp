@@ -0,0 +1,132 @@
+#ifndef OMEGA_H_SIMD_HPP
+#define OMEGA_H_SIMD_HPP
+
+#include <Omega_h_scalar.hpp>
+
+/* Pack<W> holds W lanes of Real and does arithmetic on all of them at
+   once. with GCC or Clang on a host with vector registers, it is made
+   of chunks as wide as those registers, using the compilers' vector
+   extensions, so every operation is a few SIMD instructions (vectors
+   wider than the registers would be split up lane by lane instead).
+   elsewhere (device builds, other compilers) each chunk is one Real.
+   either way each lane rounds exactly like the same scalar expression
+   would, so callers can promise identical results */
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(OMEGA_H_USE_CUDA) && !defined(OMEGA_H_USE_KOKKOS)
+#if defined(__AVX512F__)
+#define OMEGA_H_VECTOR_WIDTH 8
+#elif defined(__AVX__)
+#define OMEGA_H_VECTOR_WIDTH 4
+#elif defined(__SSE2__) || defined(__ARM_NEON) || defined(__VSX__)
+#define OMEGA_H_VECTOR_WIDTH 2
+#endif
+#endif
+
+#ifdef OMEGA_H_VECTOR_WIDTH
+#define OMEGA_H_USE_VECTOR_EXTENSIONS
+#endif
+
+namespace Omega_h {
+
+/* how many lanes to batch work into. a device thread takes one */
+#ifdef OMEGA_H_USE_VECTOR_EXTENSIONS
+constexpr Int pack_width = 4;
+#else
+constexpr Int pack_width = 1;
+#endif
+
+template <Int W>
+struct Pack {
+#ifdef OMEGA_H_USE_VECTOR_EXTENSIONS
+  static constexpr Int chunk_width =
+      (W < OMEGA_H_VECTOR_WIDTH) ? W : OMEGA_H_VECTOR_WIDTH;
+  struct Chunk {
+    Real v __attribute__((vector_size(chunk_width * sizeof(Real))));
+  };
+  OMEGA_H_INLINE Real operator[](Int lane) const {
+    return c[lane / chunk_width].v[lane % chunk_width];
+  }
+  OMEGA_H_INLINE void set(Int lane, Real x) {
+    c[lane / chunk_width].v[lane % chunk_width] = x;
+  }
+#else
+  static constexpr Int chunk_width = 1;
+  struct Chunk {
+    Real v;
+  };
+  OMEGA_H_INLINE Real operator[](Int lane) const { return c[lane].v; }
+  OMEGA_H_INLINE void set(Int lane, Real x) { c[lane].v = x; }
+#endif
+  static constexpr Int nchunks = W / chunk_width;
+  static_assert(nchunks * chunk_width == W,
+      "Pack width must be a multiple of the vector width");
+  Chunk c[nchunks];
+};
+
+template <Int W>
+OMEGA_H_INLINE Pack<W> fill_pack(Real x) {
+  Pack<W> out;
+  for (Int i = 0; i < W; ++i) out.set(i, x);
+  return out;
+}
+
+#define OMEGA_H_PACK_OP(op)                                                    \
+  template <Int W>                                                             \
+  OMEGA_H_INLINE Pack<W> operator op(Pack<W> const& a, Pack<W> const& b) {     \
+    Pack<W> out;                                                               \
+    for (Int i = 0; i < Pack<W>::nchunks; ++i) {                               \
+      out.c[i].v = a.c[i].v op b.c[i].v;                                       \
+    }                                                                          \
+    return out;                                                                \
+  }
+
+OMEGA_H_PACK_OP(+)
+OMEGA_H_PACK_OP(-)
+OMEGA_H_PACK_OP(*)
+OMEGA_H_PACK_OP(/)
+
+#undef OMEGA_H_PACK_OP
+
+template <Int W>
+OMEGA_H_INLINE Pack<W> operator/(Pack<W> const& a, Real b) {
+  return a / fill_pack<W>(b);
+}
+
+template <Int W>
+OMEGA_H_INLINE Pack<W> operator-(Pack<W> const& a) {
+  Pack<W> out;
+  for (Int i = 0; i < Pack<W>::nchunks; ++i) out.c[i].v = -a.c[i].v;
+  return out;
+}
+
+/* (a > b) ? x : y, lane by lane */
+template <Int W>
+OMEGA_H_INLINE Pack<W> select_greater(Pack<W> const& a, Pack<W> const& b,
+    Pack<W> const& x, Pack<W> const& y) {
+  Pack<W> out;
+  for (Int i = 0; i < Pack<W>::nchunks; ++i) {
+#ifdef OMEGA_H_USE_VECTOR_EXTENSIONS
+    /* blending bits works with every compiler that has the extensions */
+    auto mask = a.c[i].v > b.c[i].v;
+    typedef decltype(mask) Bits;
+    typedef decltype(out.c[i].v) Native;
+    out.c[i].v = (Native)(((Bits)x.c[i].v & mask) | ((Bits)y.c[i].v & ~mask));
+#else
+    out.c[i].v = (a.c[i].v > b.c[i].v) ? x.c[i].v : y.c[i].v;
+#endif
+  }
+  return out;
+}
+
+/* the roots have no vector instructions on most targets anyway */
+template <Int np, Int dp, Int W>
+OMEGA_H_INLINE Pack<W> power(Pack<W> const& x) {
+  Pack<W> out;
+  for (Int i = 0; i < W; ++i) out.set(i, power<np, dp>(x[i]));
+  return out;
+}
+
+}  // end namespace Omega_h
+
+#endif
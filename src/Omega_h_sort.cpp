@@ -9,6 +9,7 @@
 #include <Omega_h_sort.hpp>
 
 #include <algorithm>
+#include <type_traits>
 #include <vector>
 
 #if defined(OMEGA_H_USE_CUDA) || defined(OMEGA_H_USE_HIP)
@@ -79,8 +80,134 @@ struct CompareKeySets {
   }
 };
 
+#if !(defined(OMEGA_H_USE_CUDA) || defined(OMEGA_H_USE_HIP) || \
+      defined(OMEGA_H_USE_SYCL))
+#define OMEGA_H_USE_RADIX_SORT
+#endif
+
+#ifdef OMEGA_H_USE_RADIX_SORT
+
+/* Least-significant-digit radix sort for host backends.
+   Each key column is sorted separately, last column first,
+   as (unsigned key, index) pairs in 8-bit digits.
+   Every pass is stable, so the final order is the lexical,
+   stable order that CompareKeySets would produce. */
+
+enum { RADIX_BITS = 8, RADIX_BUCKETS = 1 << RADIX_BITS };
+
+/* sorting small arrays is cheaper with the comparator */
+constexpr LO radix_sort_min_size = 1 << 11;
+
+static int radix_num_threads(LO n) {
+#ifdef OMEGA_H_USE_OPENMP
+  auto const max_threads = omp_get_max_threads();
+  auto const useful_threads = int(n / (RADIX_BUCKETS * 16)) + 1;
+  return std::min(max_threads, useful_threads);
+#else
+  (void)n;
+  return 1;
+#endif
+}
+
+/* on return keys and vals point to whichever buffers hold the result */
+template <typename U>
+static void radix_sort_pairs(U*& keys, U*& keys_tmp, LO*& vals,
+    LO*& vals_tmp, LO n, int nbits, int nthreads) {
+  std::vector<LO> offsets(std::size_t(nthreads) * RADIX_BUCKETS);
+  auto const chunk = (n + nthreads - 1) / nthreads;
+  for (int shift = 0; shift < nbits; shift += RADIX_BITS) {
+    std::fill(offsets.begin(), offsets.end(), 0);
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(static, 1)
+#endif
+    for (int t = 0; t < nthreads; ++t) {
+      auto const begin = std::min(n, t * chunk);
+      auto const end = std::min(n, begin + chunk);
+      auto counts = offsets.data() + t * RADIX_BUCKETS;
+      for (LO i = begin; i < end; ++i) {
+        ++counts[(keys[i] >> shift) & (RADIX_BUCKETS - 1)];
+      }
+    }
+    /* bucket-major, then thread-major, keeps each pass stable */
+    LO total = 0;
+    bool is_trivial = false;
+    for (int b = 0; b < RADIX_BUCKETS; ++b) {
+      LO bucket_count = 0;
+      for (int t = 0; t < nthreads; ++t) {
+        auto& count = offsets[std::size_t(t * RADIX_BUCKETS + b)];
+        auto const old_count = count;
+        count = total;
+        total += old_count;
+        bucket_count += old_count;
+      }
+      if (bucket_count == n) is_trivial = true;
+    }
+    if (is_trivial) continue;
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(static, 1)
+#endif
+    for (int t = 0; t < nthreads; ++t) {
+      auto const begin = std::min(n, t * chunk);
+      auto const end = std::min(n, begin + chunk);
+      auto positions = offsets.data() + t * RADIX_BUCKETS;
+      for (LO i = begin; i < end; ++i) {
+        auto const pos = positions[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+        keys_tmp[pos] = keys[i];
+        vals_tmp[pos] = vals[i];
+      }
+    }
+    std::swap(keys, keys_tmp);
+    std::swap(vals, vals_tmp);
+  }
+}
+
 template <Int N, typename T>
-static LOs sort_by_keys_tmpl(Read<T> keys) {
+static void radix_sort_by_keys(T const* keys, LO* perm, LO n) {
+  begin_code("radix_sort_by_keys");
+  using U = typename std::make_unsigned<T>::type;
+  auto const nthreads = radix_num_threads(n);
+  std::vector<U> ukeys(static_cast<std::size_t>(n));
+  std::vector<U> ukeys_tmp(static_cast<std::size_t>(n));
+  std::vector<LO> perm_tmp(static_cast<std::size_t>(n));
+  auto keys_out = ukeys.data();
+  auto keys_alt = ukeys_tmp.data();
+  auto vals_out = perm;
+  auto vals_alt = perm_tmp.data();
+  for (Int c = N - 1; c >= 0; --c) {
+    T min_key = ArithTraits<T>::max();
+    T max_key = ArithTraits<T>::min();
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for num_threads(nthreads) reduction(min : min_key) \
+    reduction(max : max_key)
+#endif
+    for (LO i = 0; i < n; ++i) {
+      min_key = std::min(min_key, keys[i * N + c]);
+      max_key = std::max(max_key, keys[i * N + c]);
+    }
+    if (min_key == max_key) continue;
+    /* subtracting the minimum in unsigned arithmetic gives
+       order-preserving keys for negative values too, and lets
+       passes over always-zero high digits be skipped */
+    auto const range = U(U(max_key) - U(min_key));
+    int nbits = 0;
+    while (nbits < int(sizeof(U) * 8) && (range >> nbits) != 0) ++nbits;
+#ifdef OMEGA_H_USE_OPENMP
+#pragma omp parallel for num_threads(nthreads)
+#endif
+    for (LO i = 0; i < n; ++i) {
+      keys_out[i] = U(U(keys[vals_out[i] * N + c]) - U(min_key));
+    }
+    radix_sort_pairs(keys_out, keys_alt, vals_out, vals_alt, n, nbits,
+        nthreads);
+  }
+  if (vals_out != perm) std::copy(vals_out, vals_out + n, perm);
+  end_code();
+}
+
+#endif
+
+template <Int N, typename T>
+static LOs sort_by_keys_comparison_tmpl(Read<T> keys) {
   begin_code("sort_by_keys");
   auto n = divide_no_remainder(keys.size(), N);
   Write<LO> perm(n, 0, 1);
@@ -93,6 +220,21 @@ static LOs sort_by_keys_tmpl(Read<T> keys) {
   return perm;
 }
 
+template <Int N, typename T>
+static LOs sort_by_keys_tmpl(Read<T> keys) {
+#ifdef OMEGA_H_USE_RADIX_SORT
+  auto n = divide_no_remainder(keys.size(), N);
+  if (n >= radix_sort_min_size) {
+    begin_code("sort_by_keys");
+    Write<LO> perm(n, 0, 1);
+    radix_sort_by_keys<N>(keys.data(), perm.data(), n);
+    end_code();
+    return perm;
+  }
+#endif
+  return sort_by_keys_comparison_tmpl<N>(keys);
+}
+
 template <typename T>
 LOs sort_by_keys(Read<T> keys, Int width) {
   if (width == 1) return sort_by_keys_tmpl<1>(keys);
@@ -102,7 +244,18 @@ LOs sort_by_keys(Read<T> keys, Int width) {
   OMEGA_H_NORETURN(LOs());
 }
 
-#define INST(T) template LOs sort_by_keys(Read<T> keys, Int width);
+template <typename T>
+LOs sort_by_keys_comparison(Read<T> keys, Int width) {
+  if (width == 1) return sort_by_keys_comparison_tmpl<1>(keys);
+  if (width == 2) return sort_by_keys_comparison_tmpl<2>(keys);
+  if (width == 3) return sort_by_keys_comparison_tmpl<3>(keys);
+  if (width == 4) return sort_by_keys_comparison_tmpl<4>(keys);
+  OMEGA_H_NORETURN(LOs());
+}
+
+#define INST(T)                                                                \
+  template LOs sort_by_keys(Read<T> keys, Int width);                          \
+  template LOs sort_by_keys_comparison(Read<T> keys, Int width);
 INST(LO)
 INST(GO)
 #undef INST
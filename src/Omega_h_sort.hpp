@@ -21,8 +21,15 @@ namespace Omega_h {
 template <typename T>
 LOs sort_by_keys(Read<T> keys, Int width = 1);
 
+/* Same result as sort_by_keys, but always uses the comparison sort.
+   On host backends sort_by_keys switches to a parallel radix sort
+   for large arrays; this is kept for testing and benchmarking it. */
+template <typename T>
+LOs sort_by_keys_comparison(Read<T> keys, Int width = 1);
+
 #define OMEGA_H_INST_DECL(T)                                                   \
-  extern template LOs sort_by_keys(Read<T> keys, Int width);
+  extern template LOs sort_by_keys(Read<T> keys, Int width);                  \
+  extern template LOs sort_by_keys_comparison(Read<T> keys, Int width);
 OMEGA_H_INST_DECL(LO)
 OMEGA_H_INST_DECL(GO)
 #undef OMEGA_H_INST_DECL
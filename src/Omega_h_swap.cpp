@@ -1,6 +1,7 @@
 #include "Omega_h_swap.hpp"
 
 #include "Omega_h_array_ops.hpp"
+#include "Omega_h_malloc.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
 #include "Omega_h_profile.hpp"
@@ -44,6 +45,7 @@ Read<I8> filter_swap_improve(Mesh* mesh, LOs cands2edges, Reals cand_quals) {
 
 bool swap_edges(Mesh* mesh, AdaptOpts const& opts) {
   OMEGA_H_TIME_FUNCTION;
+  ScopedArenaPhase arena_phase("swap_edges");
   bool ret = false;
   if (mesh->dim() == 3)
     ret = swap_edges_3d(mesh, opts);
@@ -18,7 +18,13 @@ static bool swap3d_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   auto cands2edges = collect_marked(edges_are_cands);
   auto cand_quals = Reals();
   auto cand_configs = Read<I8>();
-  swap3d_qualities(mesh, opts, cands2edges, &cand_quals, &cand_configs);
+  CavityCacheStats cache_stats;
+  swap3d_qualities(
+      mesh, opts, cands2edges, &cand_quals, &cand_configs, &cache_stats);
+  if (opts.verbosity >= EACH_REBUILD &&
+      mesh->has_tag(EDGE, swap_quality_cache)) {
+    print_cavity_cache_stats(mesh, "swap", cache_stats);
+  }
   auto edge_configs =
       map_onto(cand_configs, cands2edges, mesh->nedges(), I8(-1), 1);
   auto keep_cands = filter_swap_improve(mesh, cands2edges, cand_quals);
@@ -29,9 +35,10 @@ static bool swap3d_ghosted(Mesh* mesh, AdaptOpts const& opts) {
   auto edges_are_keys = find_indset(mesh, EDGE, edge_quals, edges_are_cands);
   Graph edges2cav_elems;
   edges2cav_elems = mesh->ask_up(EDGE, mesh->dim());
+  auto keys2edges = collect_marked(edges_are_keys);
+  edge_configs = swap3d_choose_configs(mesh, opts, keys2edges, edge_configs);
   mesh->add_tag(EDGE, "key", 1, edges_are_keys);
   mesh->add_tag(EDGE, "config", 1, edge_configs);
-  auto keys2edges = collect_marked(edges_are_keys);
   set_owners_by_indset(mesh, EDGE, keys2edges, edges2cav_elems);
   return true;
 }
@@ -58,6 +65,8 @@ static void swap3d_element_based(Mesh* mesh, AdaptOpts const& opts) {
   auto prod_verts2verts =
       swap3d_topology(mesh, keys2edges, edges_configs, keys2prods);
   auto old_lows2new_lows = LOs(mesh->nverts(), 0, 1);
+  Few<LOs, 4> old_dim_ents2new_ents;
+  old_dim_ents2new_ents[VERT] = old_lows2new_lows;
   for (Int ent_dim = EDGE; ent_dim <= mesh->dim(); ++ent_dim) {
     auto prods2new_ents = LOs();
     auto same_ents2old_ents = LOs();
@@ -67,6 +76,8 @@ static void swap3d_element_based(Mesh* mesh, AdaptOpts const& opts) {
         keys2prods[ent_dim], prod_verts2verts[ent_dim], old_lows2new_lows,
         &prods2new_ents, &same_ents2old_ents, &same_ents2new_ents,
         &old_ents2new_ents);
+    old_dim_ents2new_ents[ent_dim] = old_ents2new_ents;
+    patch_up_adjs(mesh, &new_mesh, ent_dim, old_dim_ents2new_ents);
     transfer_swap(mesh, opts.xfer_opts, &new_mesh, ent_dim, keys2edges,
         keys2prods[ent_dim], prods2new_ents, same_ents2old_ents,
         same_ents2new_ents);
@@ -3,11 +3,23 @@
 
 #include <Omega_h_adapt.hpp>
 #include <Omega_h_host_few.hpp>
+#include "Omega_h_cavity_cache.hpp"
 
 namespace Omega_h {
 
+/* with a swap_quality_cache on the mesh, only the candidates whose
+   cavities changed are measured again, and the others are given
+   SWAP3D_UNKNOWN_CONFIG until swap3d_choose_configs() */
+enum { SWAP3D_UNKNOWN_CONFIG = -2 };
+
 void swap3d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges,
-    Reals* cand_quals, Read<I8>* cand_configs);
+    Reals* cand_quals, Read<I8>* cand_configs,
+    CavityCacheStats* stats = nullptr);
+
+/* measures again the configurations of the keys that only have
+   a cached quality */
+Read<I8> swap3d_choose_configs(
+    Mesh* mesh, AdaptOpts const& opts, LOs keys2edges, Read<I8> edge_configs);
 
 HostFew<LOs, 4> swap3d_keys_to_prods(Mesh* mesh, LOs keys2edges);
 
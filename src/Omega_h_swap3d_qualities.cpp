@@ -1,9 +1,13 @@
 #include "Omega_h_swap3d.hpp"
 
+#include "Omega_h_array_ops.hpp"
+#include "Omega_h_cavity_cache.hpp"
 #include "Omega_h_for.hpp"
+#include "Omega_h_map.hpp"
 #include "Omega_h_quality.hpp"
 #include "Omega_h_swap3d_choice.hpp"
 #include "Omega_h_swap3d_loop.hpp"
+#include "Omega_h_timer.hpp"
 
 namespace Omega_h {
 
@@ -57,10 +61,8 @@ void swap3d_qualities_tmpl(Mesh* mesh, AdaptOpts const& opts,
       mesh->sync_subset_array(EDGE, *cand_configs, cands2edges, I8(-1), 1);
 }
 
-void swap3d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges,
-    Reals* cand_quals, Read<I8>* cand_configs) {
-  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_GHOSTED);
-  OMEGA_H_CHECK(mesh->dim() == 3);
+static void measure_swap3d_qualities(Mesh* mesh, AdaptOpts const& opts,
+    LOs cands2edges, Reals* cand_quals, Read<I8>* cand_configs) {
   auto metrics = mesh->get_array<Real>(VERT, "metric");
   auto metric_dim = get_metrics_dim(mesh->nverts(), metrics);
   if (metric_dim == 3) {
@@ -74,4 +76,54 @@ void swap3d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges,
   OMEGA_H_NORETURN();
 }
 
+void swap3d_qualities(Mesh* mesh, AdaptOpts const& opts, LOs cands2edges,
+    Reals* cand_quals, Read<I8>* cand_configs, CavityCacheStats* stats) {
+  OMEGA_H_CHECK(mesh->parting() == OMEGA_H_GHOSTED);
+  OMEGA_H_CHECK(mesh->dim() == 3);
+  if (!mesh->has_tag(EDGE, swap_quality_cache)) {
+    measure_swap3d_qualities(mesh, opts, cands2edges, cand_quals, cand_configs);
+    return;
+  }
+  auto const ncands = cands2edges.size();
+  auto const cand_wanted = Read<I8>(ncands, I8(1));
+  auto miss_bits = find_cavity_cache_misses(
+      mesh, swap_quality_cache, cands2edges, cand_wanted);
+  auto misses2cands = collect_marked(miss_bits);
+  miss_bits = read(unmap(misses2cands, miss_bits, 1));
+  Reals miss_quals;
+  Read<I8> miss_configs;
+  auto t0 = now();
+  measure_swap3d_qualities(mesh, opts, unmap(misses2cands, cands2edges, 1),
+      &miss_quals, &miss_configs);
+  auto t1 = now();
+  *cand_quals = update_cavity_cache(mesh, swap_quality_cache, cands2edges,
+      cand_wanted, misses2cands, miss_bits, miss_quals);
+  /* configurations number the loop from wherever find_loop() starts
+     it, which can change when the mesh is rebuilt, so only the
+     qualities are cached. see swap3d_choose_configs() */
+  *cand_configs = map_onto(
+      miss_configs, misses2cands, ncands, I8(SWAP3D_UNKNOWN_CONFIG), 1);
+  if (stats) {
+    stats->misses += misses2cands.size();
+    stats->hits += ncands - misses2cands.size();
+    stats->seconds += t1 - t0;
+  }
+}
+
+Read<I8> swap3d_choose_configs(Mesh* mesh, AdaptOpts const& opts,
+    LOs keys2edges, Read<I8> edge_configs) {
+  auto const key_configs = read(unmap(keys2edges, edge_configs, 1));
+  auto const unknown =
+      each_eq_to(key_configs, I8(SWAP3D_UNKNOWN_CONFIG));
+  auto const comm = mesh->comm();
+  if (!comm->reduce_or(get_max(unknown) == 1)) return edge_configs;
+  auto const unknown2edges = unmap(collect_marked(unknown), keys2edges, 1);
+  Reals quals;
+  Read<I8> configs;
+  measure_swap3d_qualities(mesh, opts, unknown2edges, &quals, &configs);
+  Write<I8> out = deep_copy(edge_configs);
+  map_into(configs, unknown2edges, out, 1);
+  return out;
+}
+
 }  // end namespace Omega_h
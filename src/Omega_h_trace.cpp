@@ -0,0 +1,353 @@
+#include <Omega_h_trace.hpp>
+
+#include <Omega_h_comm.hpp>
+#include <Omega_h_fail.hpp>
+#include <Omega_h_file.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace Omega_h {
+namespace profile {
+
+OMEGA_H_DLL Trace* global_trace = nullptr;
+
+namespace {
+
+constexpr char magic[4] = {'O', 'H', 'T', 'R'};
+constexpr I32 format_version = 1;
+
+/* open addressing by the address of the name string,
+   probing past this many slots gives up on the name */
+constexpr std::size_t name_slots = std::size_t(1) << 14;
+constexpr std::size_t max_probes = 64;
+constexpr I32 overflow_name = 0;
+
+std::atomic<std::uint64_t> next_trace_id(1);
+
+struct ThreadCache {
+  std::uint64_t trace_id = 0;
+  void* buffer = nullptr;
+};
+
+thread_local ThreadCache thread_cache;
+
+}  // end anonymous namespace
+
+struct Trace::Buffer {
+  I32 thread;
+  std::vector<Event> events;
+  std::size_t count;  // events ever recorded, may exceed events.size()
+};
+
+Trace::Trace(CommPtr comm, std::string const& prefix, bool write_json,
+    std::size_t events_per_thread)
+    : comm_(comm),
+      prefix_(prefix),
+      write_json_(write_json),
+      capacity_(events_per_thread),
+      id_(next_trace_id++),
+      begin_offset_(0.0),
+      end_offset_(0.0),
+      duration_(0.0),
+      slots_(new NameSlot[name_slots]),
+      live_bytes_(0) {
+  OMEGA_H_CHECK(capacity_ > 0);
+  for (std::size_t i = 0; i < name_slots; ++i) {
+    slots_[i].key.store(nullptr, std::memory_order_relaxed);
+    slots_[i].id.store(overflow_name, std::memory_order_relaxed);
+  }
+  names_.push_back("(unnamed)");
+  start_time_ = now();
+  begin_offset_ = clock_offset();
+  thread_buffer();
+}
+
+Trace::~Trace() = default;
+
+Real Trace::elapsed() const { return now() - start_time_; }
+
+/* Cristian's method against rank 0 over a few rounds,
+   keeping the round with the shortest wait */
+Real Trace::clock_offset() const {
+  if (!comm_ || comm_->size() == 1) return 0.0;
+  Real best_offset = 0.0;
+  Real best_wait = -1.0;
+  for (int round = 0; round < 8; ++round) {
+    comm_->barrier();
+    auto const sent = elapsed();
+    Real root_time = sent;
+    comm_->bcast(root_time);
+    auto const received = elapsed();
+    auto const wait = received - sent;
+    if (best_wait < 0.0 || wait < best_wait) {
+      best_wait = wait;
+      best_offset = root_time - (sent + received) / 2.0;
+    }
+  }
+  if (comm_->rank() == 0) return 0.0;
+  return best_offset;
+}
+
+I32 Trace::name_id(char const* name) {
+  auto const address = reinterpret_cast<std::uintptr_t>(name);
+  auto const hash = std::uint64_t(address >> 3) * 0x9E3779B97F4A7C15ull;
+  for (std::size_t probe = 0; probe < max_probes; ++probe) {
+    auto& slot = slots_[(hash + probe) & (name_slots - 1)];
+    auto const key = slot.key.load(std::memory_order_acquire);
+    if (key == name) return slot.id.load(std::memory_order_relaxed);
+    if (key == nullptr) return insert_name(name);
+  }
+  return overflow_name;
+}
+
+I32 Trace::insert_name(char const* name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto const address = reinterpret_cast<std::uintptr_t>(name);
+  auto const hash = std::uint64_t(address >> 3) * 0x9E3779B97F4A7C15ull;
+  for (std::size_t probe = 0; probe < max_probes; ++probe) {
+    auto& slot = slots_[(hash + probe) & (name_slots - 1)];
+    auto const key = slot.key.load(std::memory_order_relaxed);
+    if (key == name) return slot.id.load(std::memory_order_relaxed);
+    if (key == nullptr) {
+      auto const id = I32(names_.size());
+      names_.push_back(name);
+      slot.id.store(id, std::memory_order_relaxed);
+      slot.key.store(name, std::memory_order_release);
+      return id;
+    }
+  }
+  return overflow_name;
+}
+
+Trace::Buffer* Trace::thread_buffer() {
+  auto& cache = thread_cache;
+  if (cache.trace_id == id_) return static_cast<Buffer*>(cache.buffer);
+  std::unique_ptr<Buffer> buffer(new Buffer());
+  buffer->events.resize(capacity_);
+  buffer->count = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer->thread = I32(buffers_.size());
+  buffers_.push_back(std::move(buffer));
+  cache.trace_id = id_;
+  cache.buffer = buffers_.back().get();
+  return buffers_.back().get();
+}
+
+void Trace::record(EventKind kind, I64 value) {
+  auto const buffer = thread_buffer();
+  auto& event = buffer->events[buffer->count % capacity_];
+  event.time = elapsed();
+  event.value = value;
+  event.kind = kind;
+  ++buffer->count;
+}
+
+void Trace::begin(char const* name) { record(BEGIN, name_id(name)); }
+
+void Trace::end() { record(END, 0); }
+
+void Trace::allocated(std::size_t bytes) {
+  record(ALLOC, live_bytes_ += I64(bytes));
+}
+
+void Trace::freed(std::size_t bytes) {
+  record(FREE, live_bytes_ -= I64(bytes));
+}
+
+TraceFile Trace::snapshot() const {
+  TraceFile file;
+  file.rank = comm_ ? comm_->rank() : 0;
+  file.nranks = comm_ ? comm_->size() : 1;
+  file.duration = duration_ > 0.0 ? duration_ : elapsed();
+  file.begin_offset = begin_offset_;
+  file.end_offset = end_offset_;
+  file.dropped = 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  file.names = names_;
+  for (auto& buffer : buffers_) {
+    ThreadEvents thread;
+    thread.thread = buffer->thread;
+    auto const n = std::min(buffer->count, capacity_);
+    auto const first = buffer->count - n;
+    file.dropped += I64(first);
+    thread.events.reserve(n);
+    for (auto i = first; i < buffer->count; ++i) {
+      thread.events.push_back(buffer->events[i % capacity_]);
+    }
+    file.threads.push_back(std::move(thread));
+  }
+  return file;
+}
+
+void Trace::finish() {
+  duration_ = elapsed();
+  end_offset_ = clock_offset();
+  auto const file = snapshot();
+  std::stringstream base;
+  base << prefix_ << '.' << file.rank;
+  write_trace(base.str() + ".ohtrace", file);
+  if (write_json_) {
+    auto const path = base.str() + ".json";
+    std::ofstream stream(path.c_str());
+    if (!stream.is_open()) {
+      Omega_h_fail("could not open file \"%s\"\n", path.c_str());
+    }
+    write_chrome_json(stream, {file});
+  }
+  if (file.dropped && file.rank == 0) {
+    std::cout << "trace: ring buffers overflowed, " << file.dropped
+              << " oldest events on rank 0 were dropped\n";
+  }
+}
+
+void write_trace(std::string const& path, TraceFile const& file) {
+  std::ofstream stream(path.c_str(), std::ios::binary);
+  if (!stream.is_open()) {
+    Omega_h_fail("could not open file \"%s\"\n", path.c_str());
+  }
+  bool const needs_swapping = !is_little_endian_cpu();
+  stream.write(magic, sizeof(magic));
+  binary::write_value(stream, format_version, needs_swapping);
+  binary::write_value(stream, file.rank, needs_swapping);
+  binary::write_value(stream, file.nranks, needs_swapping);
+  binary::write_value(stream, file.duration, needs_swapping);
+  binary::write_value(stream, file.begin_offset, needs_swapping);
+  binary::write_value(stream, file.end_offset, needs_swapping);
+  binary::write_value(stream, file.dropped, needs_swapping);
+  binary::write_value(stream, I32(file.names.size()), needs_swapping);
+  for (auto& name : file.names) binary::write(stream, name, needs_swapping);
+  binary::write_value(stream, I32(file.threads.size()), needs_swapping);
+  for (auto& thread : file.threads) {
+    binary::write_value(stream, thread.thread, needs_swapping);
+    binary::write_value(stream, I64(thread.events.size()), needs_swapping);
+    for (auto& event : thread.events) {
+      binary::write_value(stream, event.time, needs_swapping);
+      binary::write_value(stream, event.value, needs_swapping);
+      binary::write_value(stream, event.kind, needs_swapping);
+    }
+  }
+}
+
+TraceFile read_trace(std::string const& path) {
+  std::ifstream stream(path.c_str(), std::ios::binary);
+  if (!stream.is_open()) {
+    Omega_h_fail("could not open file \"%s\"\n", path.c_str());
+  }
+  bool const needs_swapping = !is_little_endian_cpu();
+  char file_magic[sizeof(magic)];
+  stream.read(file_magic, sizeof(file_magic));
+  if (!stream || !std::equal(magic, magic + sizeof(magic), file_magic)) {
+    Omega_h_fail("\"%s\" is not an Omega_h trace\n", path.c_str());
+  }
+  I32 version;
+  binary::read_value(stream, version, needs_swapping);
+  if (version != format_version) {
+    Omega_h_fail("\"%s\" has unsupported trace version %d\n", path.c_str(),
+        int(version));
+  }
+  TraceFile file;
+  binary::read_value(stream, file.rank, needs_swapping);
+  binary::read_value(stream, file.nranks, needs_swapping);
+  binary::read_value(stream, file.duration, needs_swapping);
+  binary::read_value(stream, file.begin_offset, needs_swapping);
+  binary::read_value(stream, file.end_offset, needs_swapping);
+  binary::read_value(stream, file.dropped, needs_swapping);
+  I32 nnames;
+  binary::read_value(stream, nnames, needs_swapping);
+  file.names.resize(std::size_t(nnames));
+  for (auto& name : file.names) binary::read(stream, name, needs_swapping);
+  I32 nthreads;
+  binary::read_value(stream, nthreads, needs_swapping);
+  file.threads.resize(std::size_t(nthreads));
+  for (auto& thread : file.threads) {
+    binary::read_value(stream, thread.thread, needs_swapping);
+    I64 nevents;
+    binary::read_value(stream, nevents, needs_swapping);
+    thread.events.resize(std::size_t(nevents));
+    for (auto& event : thread.events) {
+      binary::read_value(stream, event.time, needs_swapping);
+      binary::read_value(stream, event.value, needs_swapping);
+      binary::read_value(stream, event.kind, needs_swapping);
+    }
+  }
+  if (!stream) Omega_h_fail("could not read file \"%s\"\n", path.c_str());
+  return file;
+}
+
+static void write_json_string(std::ostream& stream, std::string const& s) {
+  stream << '"';
+  for (auto c : s) {
+    if (c == '"' || c == '\\') {
+      stream << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      stream << ' ';
+    } else {
+      stream << c;
+    }
+  }
+  stream << '"';
+}
+
+void write_chrome_json(
+    std::ostream& stream, std::vector<TraceFile> const& files) {
+  stream << std::fixed << std::setprecision(3);
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  bool first = true;
+  auto separate = [&]() {
+    if (!first) stream << ",\n";
+    first = false;
+  };
+  for (auto& file : files) {
+    auto const drift = file.duration > 0.0
+                           ? (file.end_offset - file.begin_offset) / file.duration
+                           : 0.0;
+    auto microseconds = [&](Real time) {
+      return (time + file.begin_offset + drift * time) * 1e6;
+    };
+    separate();
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << file.rank
+           << ",\"args\":{\"name\":\"rank " << file.rank << "\"}}";
+    for (auto& thread : file.threads) {
+      // events that ended before the ring buffer wrapped have no begin
+      int depth = 0;
+      for (auto& event : thread.events) {
+        switch (event.kind) {
+          case BEGIN: {
+            separate();
+            stream << "{\"name\":";
+            auto const id = std::size_t(event.value);
+            write_json_string(
+                stream, id < file.names.size() ? file.names[id] : "?");
+            stream << ",\"ph\":\"B\",\"ts\":" << microseconds(event.time)
+                   << ",\"pid\":" << file.rank << ",\"tid\":" << thread.thread
+                   << '}';
+            ++depth;
+            break;
+          }
+          case END:
+            if (depth == 0) break;
+            separate();
+            stream << "{\"ph\":\"E\",\"ts\":" << microseconds(event.time)
+                   << ",\"pid\":" << file.rank << ",\"tid\":" << thread.thread
+                   << '}';
+            --depth;
+            break;
+          case ALLOC:
+          case FREE:
+            separate();
+            stream << "{\"name\":\"memory\",\"ph\":\"C\",\"ts\":"
+                   << microseconds(event.time) << ",\"pid\":" << file.rank
+                   << ",\"args\":{\"bytes\":" << event.value << "}}";
+            break;
+        }
+      }
+    }
+  }
+  stream << "\n]}\n";
+}
+
+}  // namespace profile
+}  // namespace Omega_h
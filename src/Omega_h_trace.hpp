@@ -0,0 +1,118 @@
+#ifndef OMEGA_H_TRACE_HPP
+#define OMEGA_H_TRACE_HPP
+
+#include <Omega_h_defines.hpp>
+#include <Omega_h_timer.hpp>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Omega_h {
+
+class Comm;
+typedef std::shared_ptr<Comm> CommPtr;
+
+namespace profile {
+
+enum EventKind : I8 {
+  BEGIN,  // value is the name id
+  END,    // value is unused
+  ALLOC,  // value is the net number of bytes allocated since the
+          // trace started, including this allocation
+  FREE    // same, after this deallocation
+};
+
+struct Event {
+  Real time;  // seconds since the trace started on this rank
+  I64 value;
+  I8 kind;
+};
+
+/* one thread's events, oldest first */
+struct ThreadEvents {
+  I32 thread;
+  std::vector<Event> events;
+};
+
+/* everything one rank recorded, as stored in its .ohtrace file.
+   begin_offset and end_offset are what must be added to this
+   rank's clock to read rank 0's clock at either end of the trace;
+   times in between are corrected by interpolating the two. */
+struct TraceFile {
+  I32 rank;
+  I32 nranks;
+  Real duration;
+  Real begin_offset;
+  Real end_offset;
+  I64 dropped;
+  std::vector<std::string> names;
+  std::vector<ThreadEvents> threads;
+};
+
+/* records begin/end events of timed code regions and array
+   (de)allocations into a ring buffer of fixed capacity per thread.
+   once a buffer is full the oldest events are overwritten.
+   names are identified by their address, so they must outlive the
+   trace, which string literals and __FUNCTION__ do. */
+class Trace {
+ public:
+  Trace(CommPtr comm, std::string const& prefix, bool write_json,
+      std::size_t events_per_thread = std::size_t(1) << 20);
+  ~Trace();
+  Trace(Trace const&) = delete;
+  Trace& operator=(Trace const&) = delete;
+  void begin(char const* name);
+  void end();
+  void allocated(std::size_t bytes);
+  void freed(std::size_t bytes);
+  TraceFile snapshot() const;
+  /* collective over the communicator given at construction:
+     measures the final clock offset and writes
+     (prefix).(rank).ohtrace and optionally (prefix).(rank).json */
+  void finish();
+
+ private:
+  struct Buffer;
+  struct NameSlot {
+    std::atomic<char const*> key;
+    std::atomic<I32> id;
+  };
+  I32 name_id(char const* name);
+  I32 insert_name(char const* name);
+  Buffer* thread_buffer();
+  void record(EventKind kind, I64 value);
+  Real elapsed() const;
+  Real clock_offset() const;
+  CommPtr comm_;
+  std::string prefix_;
+  bool write_json_;
+  std::size_t capacity_;
+  std::uint64_t id_;
+  Now start_time_;
+  Real begin_offset_;
+  Real end_offset_;
+  Real duration_;
+  std::unique_ptr<NameSlot[]> slots_;
+  std::vector<std::string> names_;
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+  std::atomic<I64> live_bytes_;
+  mutable std::mutex mutex_;
+};
+
+OMEGA_H_DLL extern Trace* global_trace;
+
+void write_trace(std::string const& path, TraceFile const& file);
+TraceFile read_trace(std::string const& path);
+
+/* writes Chrome trace-event JSON (chrome://tracing, Perfetto)
+   with one process per rank, times aligned to rank 0's clock */
+void write_chrome_json(std::ostream& stream, std::vector<TraceFile> const& files);
+
+}  // namespace profile
+}  // namespace Omega_h
+
+#endif
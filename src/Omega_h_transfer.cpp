@@ -1,6 +1,7 @@
 #include "Omega_h_transfer.hpp"
 
 #include "Omega_h_affine.hpp"
+#include "Omega_h_cavity_cache.hpp"
 #include "Omega_h_conserve.hpp"
 #include "Omega_h_fit.hpp"
 #include "Omega_h_for.hpp"
@@ -404,6 +405,8 @@ void transfer_refine(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
   if (prod_dim == EDGE) {
     transfer_length(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
         prods2new_ents);
+    transfer_cavity_caches(old_mesh, new_mesh, EDGE, keys2edges,
+        same_ents2old_ents, same_ents2new_ents);
   } else if (prod_dim == FACE) {
     transfer_face_flux(old_mesh, new_mesh, same_ents2old_ents,
         same_ents2new_ents, prods2new_ents);
@@ -597,6 +600,8 @@ void transfer_coarsen(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
   if (prod_dim == EDGE) {
     transfer_length(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
         prods2new_ents);
+    transfer_cavity_caches(old_mesh, new_mesh, VERT, keys2verts,
+        same_ents2old_ents, same_ents2new_ents);
   } else if (prod_dim == FACE) {
     transfer_face_flux(old_mesh, new_mesh, same_ents2old_ents,
         same_ents2new_ents, prods2new_ents);
@@ -709,6 +714,8 @@ void transfer_swap(Mesh* old_mesh, TransferOpts const& opts, Mesh* new_mesh,
   if (prod_dim == EDGE) {
     transfer_length(old_mesh, new_mesh, same_ents2old_ents, same_ents2new_ents,
         prods2new_ents);
+    transfer_cavity_caches(old_mesh, new_mesh, EDGE, keys2edges,
+        same_ents2old_ents, same_ents2new_ents);
   } else if (prod_dim == FACE) {
     transfer_face_flux(old_mesh, new_mesh, same_ents2old_ents,
         same_ents2new_ents, prods2new_ents);
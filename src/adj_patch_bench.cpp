@@ -0,0 +1,66 @@
+#include <Omega_h_adj.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_element.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_metric.hpp>
+#include <Omega_h_refine.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+/* refines a box and, after each iteration, compares the time it
+   would take to derive the upward adjacencies the next iteration
+   asks for against what patching them during modification left */
+
+static Omega_h::Real derive_time(Omega_h::Mesh* mesh) {
+  auto const t0 = Omega_h::now();
+  for (Omega_h::Int high = Omega_h::EDGE; high <= mesh->dim(); ++high) {
+    for (Omega_h::Int low = Omega_h::VERT; low < high; ++low) {
+      if (!mesh->adj_is_patched(low, high)) continue;
+      auto const deg = Omega_h::element_degree(mesh->family(), high, low);
+      Omega_h::invert_adj(
+          mesh->ask_down(high, low), deg, mesh->nents(low), high, low);
+    }
+  }
+  auto const t1 = Omega_h::now();
+  return t1 - t0;
+}
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  auto world = lib.world();
+  Omega_h::CmdLine cmdline;
+  cmdline.add_arg<int>("nelems-per-side");
+  cmdline.add_arg<double>("target-length");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("nelems-per-side");
+  auto const h = cmdline.get<double>("target-length");
+  auto mesh =
+      Omega_h::build_box(world, OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n);
+  mesh.add_tag<Omega_h::Real>(Omega_h::VERT, "metric", 1);
+  auto opts = Omega_h::AdaptOpts(&mesh);
+  Omega_h::Real total_derive = 0;
+  for (int iter = 0;; ++iter) {
+    mesh.set_tag(Omega_h::VERT, "metric",
+        Omega_h::Reals(
+            mesh.nverts(), Omega_h::metric_eigenvalue_from_length(h)));
+    mesh.ask_up(Omega_h::VERT, Omega_h::EDGE);
+    mesh.ask_up(Omega_h::VERT, mesh.dim());
+    mesh.ask_up(Omega_h::EDGE, mesh.dim());
+    auto const t0 = Omega_h::now();
+    if (!Omega_h::refine_by_size(&mesh, opts)) break;
+    auto const t1 = Omega_h::now();
+    auto const derive = derive_time(&mesh);
+    total_derive += derive;
+    if (!world->rank()) {
+      std::cout << "iteration " << iter << ": " << mesh.nelems()
+                << " elements, refine " << (t1 - t0)
+                << " s, derivation avoided " << derive << " s\n";
+    }
+  }
+  if (!world->rank()) {
+    std::cout << "total derivation avoided " << total_derive << " s\n";
+  }
+  return 0;
+}
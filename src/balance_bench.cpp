@@ -0,0 +1,60 @@
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+/* rebalances a box whose elements weigh more inside a slab that
+   moves along x, the way refinement follows a front, by recursive
+   inertial bisection and by the graph partitioner, and compares
+   the partitions they choose and the time spent balancing */
+
+static Omega_h::Reals slab_weights(
+    Omega_h::Mesh* mesh, double lo, double hi, double heavy) {
+  auto const centroids = Omega_h::average_field(mesh, mesh->dim(),
+      Omega_h::LOs(mesh->nelems(), 0, 1), mesh->dim(), mesh->coords());
+  auto const dim = mesh->dim();
+  Omega_h::Write<Omega_h::Real> weights(mesh->nelems());
+  auto f = OMEGA_H_LAMBDA(Omega_h::LO e) {
+    auto const x = centroids[e * dim];
+    weights[e] = (lo <= x && x < hi) ? heavy : 1.0;
+  };
+  Omega_h::parallel_for(mesh->nelems(), f);
+  return weights;
+}
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  auto world = lib.world();
+  Omega_h::CmdLine cmdline;
+  cmdline.add_arg<int>("nelems-per-side");
+  cmdline.add_arg<double>("heavy-weight");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("nelems-per-side");
+  auto const heavy = cmdline.get<double>("heavy-weight");
+  for (auto method : {OMEGA_H_BALANCE_RIB, OMEGA_H_BALANCE_GRAPH}) {
+    auto mesh =
+        Omega_h::build_box(world, OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n);
+    Omega_h::BalanceOpts opts;
+    opts.method = method;
+    for (int step = 0; step < 4; ++step) {
+      opts.weights =
+          slab_weights(&mesh, 0.2 * step, 0.2 * (step + 1), heavy);
+      world->barrier();
+      auto const t0 = Omega_h::now();
+      auto const stats = mesh.balance(opts);
+      world->barrier();
+      auto const t1 = Omega_h::now();
+      if (!world->rank()) {
+        std::cout << (method == OMEGA_H_BALANCE_RIB ? "rib" : "graph")
+                  << " step " << step << ": edge cut " << stats.edge_cut
+                  << ", imbalance " << stats.imbalance << ", migrated "
+                  << stats.migrated << " elements (" << stats.migrated_bytes
+                  << " bytes), balance " << (t1 - t0) << " s\n";
+      }
+    }
+  }
+  return 0;
+}
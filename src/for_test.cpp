@@ -1,3 +1,4 @@
+#include "Omega_h_array_ops.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_library.hpp"
 
@@ -15,5 +16,28 @@ int main(int argc, char** argv) {
   HostRead<Real> hr(out);
   for(int i=0; i<size; i++)
     assert(hr[i]==i);
+  {
+    LO const n = 1000;
+    for (auto schedule : {OMEGA_H_SCHEDULE_STATIC, OMEGA_H_SCHEDULE_DYNAMIC,
+             OMEGA_H_SCHEDULE_GUIDED}) {
+      for (LO chunk : {0, 1, 7}) {
+        Write<LO> hits(n, 0);
+        auto g = OMEGA_H_LAMBDA(LO i) { hits[i] += i + 1; };
+        parallel_for(n, g, ForPolicy{schedule, chunk}, "policy_test");
+        OMEGA_H_CHECK(read(hits) == Read<LO>(n, 1, 1));
+      }
+    }
+  }
+  set_for_policies("coarsen_qualities=dynamic:64,swap3d_qualities=guided,*=static:16");
+  auto p = get_for_policy("coarsen_qualities");
+  OMEGA_H_CHECK(p.schedule == OMEGA_H_SCHEDULE_DYNAMIC && p.chunk == 64);
+  p = get_for_policy("swap3d_qualities");
+  OMEGA_H_CHECK(p.schedule == OMEGA_H_SCHEDULE_GUIDED && p.chunk == 0);
+  p = get_for_policy("foo");
+  OMEGA_H_CHECK(p.schedule == OMEGA_H_SCHEDULE_STATIC && p.chunk == 16);
+  parallel_for(size, f, "foo");
+  clear_for_policies();
+  p = get_for_policy("coarsen_qualities");
+  OMEGA_H_CHECK(p.schedule == OMEGA_H_SCHEDULE_STATIC && p.chunk == 0);
   return 0;
 }
@@ -0,0 +1,48 @@
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_file.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_timer.hpp>
+#include <fstream>
+#include <iostream>
+
+/* writes a box as a binary Gmsh 4.1 file and reads it back with
+   gmsh::read(), which parses the whole file on rank 0, and with
+   gmsh::read_sliced(), where each rank parses only its own slice,
+   reporting the throughput of each in GB/s of file */
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  auto world = lib.world();
+  Omega_h::CmdLine cmdline;
+  cmdline.add_arg<int>("nelems-per-side");
+  cmdline.add_arg<std::string>("scratch.msh");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("nelems-per-side");
+  auto const path = cmdline.get<std::string>("scratch.msh");
+  double gbytes = 0.0;
+  if (!world->rank()) {
+    auto mesh =
+        Omega_h::build_box(lib.self(), OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n);
+    Omega_h::gmsh::write_binary(path, &mesh);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    gbytes = double(file.tellg()) / 1e9;
+  }
+  world->bcast(gbytes);
+  for (int sliced = 0; sliced < 2; ++sliced) {
+    world->barrier();
+    auto const t0 = Omega_h::now();
+    auto mesh = sliced ? Omega_h::gmsh::read_sliced(path, world)
+                       : Omega_h::gmsh::read(path, world);
+    world->barrier();
+    auto const t1 = Omega_h::now();
+    auto const nelems = mesh.nglobal_ents(mesh.dim());
+    if (!world->rank()) {
+      std::cout << (sliced ? "read_sliced" : "read") << ": " << nelems
+                << " elements, " << (t1 - t0) << " s, "
+                << gbytes / (t1 - t0) << " GB/s\n";
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,72 @@
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_halo.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+/* time per step of a vertex smoothing kernel that computes every
+   vertex and then synchronizes, versus compute_and_sync(), which
+   sends the boundary while it computes the interior.
+   run at several rank counts for strong scaling. */
+
+template <typename F>
+static double time_calls(Omega_h::CommPtr comm, int ncalls, F f) {
+  f();
+  comm->barrier();
+  auto const t0 = Omega_h::now();
+  for (int i = 0; i < ncalls; ++i) f();
+  comm->barrier();
+  auto const t1 = Omega_h::now();
+  return comm->allreduce((t1 - t0) / ncalls, OMEGA_H_MAX);
+}
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  auto world = lib.world();
+  Omega_h::CmdLine cmdline;
+  cmdline.add_arg<int>("nelems-per-side");
+  cmdline.add_arg<int>("ncalls");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("nelems-per-side");
+  auto const ncalls = cmdline.get<int>("ncalls");
+  auto mesh =
+      Omega_h::build_box(world, OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const star = mesh.ask_star(Omega_h::VERT);
+  auto const coords = mesh.coords();
+  auto const width = mesh.dim();
+  auto const nverts = mesh.nverts();
+  auto const split = mesh.ask_halo_split(Omega_h::VERT);
+  Omega_h::Write<Omega_h::Real> out(nverts * width);
+  auto f = OMEGA_H_LAMBDA(Omega_h::LO v) {
+    for (Omega_h::Int j = 0; j < width; ++j) {
+      Omega_h::Real sum = 0.0;
+      for (auto vv = star.a2ab[v]; vv < star.a2ab[v + 1]; ++vv) {
+        sum += coords[star.ab2b[vv] * width + j];
+      }
+      out[v * width + j] = sum / (star.a2ab[v + 1] - star.a2ab[v]);
+    }
+  };
+  auto const separate = time_calls(world, ncalls, [&]() {
+    Omega_h::parallel_for(nverts, f, "halo_bench");
+    mesh.sync_array(Omega_h::VERT, Omega_h::Reals(out), width);
+  });
+  auto const overlapped = time_calls(world, ncalls, [&]() {
+    Omega_h::compute_and_sync(
+        &mesh, Omega_h::VERT, out, width, f, "halo_bench");
+  });
+  auto const nboundary =
+      world->allreduce(Omega_h::GO(split.boundary.size()), OMEGA_H_SUM);
+  auto const nowned = mesh.nglobal_ents(Omega_h::VERT);
+  if (!world->rank()) {
+    std::cout << world->size() << " ranks, " << nowned << " vertices, "
+              << nboundary << " on rank boundaries: compute then sync "
+              << separate * 1e6 << " us/step, overlapped "
+              << overlapped * 1e6 << " us/step, speedup "
+              << separate / overlapped << '\n';
+  }
+  return 0;
+}
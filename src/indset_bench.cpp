@@ -0,0 +1,98 @@
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_indset_inline.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_map.hpp>
+#include <Omega_h_mark.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_metric.hpp>
+#include <Omega_h_refine_qualities.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+/* rounds of synchronization and bytes received by indset::find_synced(),
+   which synchronizes every entity after every round, and indset::find(),
+   which decides the owned entities as far as it can between updates of
+   the unowned ones, on candidates shaped like those of refinement,
+   swapping and coarsening in a box that should refine on one side
+   and coarsen on the other */
+
+using namespace Omega_h;
+
+static void compare(Mesh* mesh, char const* what, Int dim,
+    Read<I8> candidates, Reals quality) {
+  auto const comm = mesh->comm();
+  auto const graph = mesh->ask_star(dim);
+  indset::QualityCompare cmp(quality, mesh->globals(dim));
+  IndsetStats stats[2];
+  double times[2];
+  Read<I8> sets[2];
+  for (int i = 0; i < 2; ++i) {
+    comm->barrier();
+    auto const t0 = now();
+    sets[i] = i ? indset::find(mesh, dim, graph.a2ab, graph.ab2b,
+                      candidates, cmp, &stats[i])
+                : indset::find_synced(mesh, dim, graph.a2ab,
+                      graph.ab2b, candidates, cmp, &stats[i]);
+    comm->barrier();
+    auto const t1 = now();
+    times[i] = comm->allreduce(t1 - t0, OMEGA_H_MAX);
+  }
+  OMEGA_H_CHECK(sets[0] == sets[1]);
+  auto const ncands = get_sum(comm, mesh->owned_array(dim, candidates, 1));
+  if (!comm->rank()) std::cout << what << ", " << ncands << " candidates:\n";
+  for (int i = 0; i < 2; ++i) {
+    auto const rounds = comm->allreduce(stats[i].rounds, OMEGA_H_MAX);
+    auto const bytes = comm->allreduce(stats[i].bytes, OMEGA_H_SUM);
+    if (!comm->rank()) {
+      std::cout << "  " << (i ? "find" : "find_synced") << ": " << rounds
+                << " rounds, " << bytes << " bytes, " << times[i] << " s\n";
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  auto world = lib.world();
+  CmdLine cmdline;
+  cmdline.add_arg<int>("nelems-per-side");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("nelems-per-side");
+  auto mesh = build_box(world, OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const coords = mesh.coords();
+  Write<Real> metrics(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto const h = (coords[v * 3] < 0.5) ? 0.6 / n : 2.5 / n;
+    metrics[v] = metric_eigenvalue_from_length(h);
+  };
+  parallel_for(mesh.nverts(), f);
+  mesh.add_tag(VERT, "metric", 1, Reals(metrics));
+  auto const lengths = mesh.ask_lengths();
+  auto const elem_quals = mesh.ask_qualities();
+  auto const edge_quals = mesh.sync_array(EDGE,
+      graph_reduce(mesh.ask_up(EDGE, mesh.dim()), elem_quals, 1, OMEGA_H_MIN),
+      1);
+  {
+    auto const long_edges = each_gt(lengths, std::sqrt(2.0));
+    auto const cands2edges = collect_marked(long_edges);
+    auto const quals = mesh.sync_array(EDGE,
+        map_onto(refine_qualities(&mesh, cands2edges), cands2edges,
+            mesh.nedges(), 0.0, 1),
+        1);
+    compare(&mesh, "refinement", EDGE, long_edges, quals);
+  }
+  compare(&mesh, "swapping", EDGE, Read<I8>(mesh.nedges(), 1), edge_quals);
+  {
+    auto const short_edges = each_lt(lengths, 1.0 / std::sqrt(2.0));
+    auto const verts = mesh.sync_array(
+        VERT, mark_down(&mesh, EDGE, VERT, short_edges), 1);
+    auto const quals = mesh.sync_array(VERT,
+        graph_reduce(mesh.ask_up(VERT, mesh.dim()), elem_quals, 1, OMEGA_H_MIN),
+        1);
+    compare(&mesh, "coarsening", VERT, verts, quals);
+  }
+  return 0;
+}
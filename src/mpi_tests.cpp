@@ -1,16 +1,105 @@
+#include <Omega_h_adapt.hpp>
 #include <Omega_h_array_ops.hpp>
 #include <Omega_h_bipart.hpp>
 #include <Omega_h_build.hpp>
 #include <Omega_h_compare.hpp>
+#include <Omega_h_file.hpp>
 #include <Omega_h_for.hpp>
+#include <Omega_h_ghost.hpp>
+#include <Omega_h_halo.hpp>
+#include <Omega_h_indset_inline.hpp>
 #include <Omega_h_inertia.hpp>
+#include <Omega_h_int_scan.hpp>
+#include <Omega_h_map.hpp>
+#include <Omega_h_metric.hpp>
 #include <Omega_h_owners.hpp>
+#include <Omega_h_shape.hpp>
 #include <Omega_h_vtk.hpp>
 
 #include <sstream>
 
 using namespace Omega_h;
 
+/* a persistent Dist must exchange like a fresh one, repeatedly,
+   in both directions and for several packet sizes */
+static void test_persistent_dist(CommPtr comm, Dist dist, LO nroots) {
+  auto persistent = dist;
+  persistent.persist();
+  OMEGA_H_CHECK(persistent.is_persistent());
+  OMEGA_H_CHECK(!dist.is_persistent());
+  for (int i = 0; i < 3; ++i) {
+    auto const offset = Real(100 * i + 10 * comm->rank());
+    Write<Real> a_w(nroots * 2);
+    auto f = OMEGA_H_LAMBDA(LO j) { a_w[j] = offset + j; };
+    parallel_for(a_w.size(), f);
+    Reals a(a_w);
+    auto b = persistent.exch(a, 2);
+    OMEGA_H_CHECK(b == dist.exch(a, 2));
+    OMEGA_H_CHECK(persistent.invert().exch(b, 2) == dist.invert().exch(b, 2));
+    auto c = persistent.exch(LOs(nroots, i, 1), 1);
+    OMEGA_H_CHECK(c == dist.exch(LOs(nroots, i, 1), 1));
+  }
+}
+
+/* a batch must exchange each of its arrays as if alone,
+   whatever mix of types and widths it packs together */
+static void test_batch_dist(CommPtr comm, Dist dist, LO nroots) {
+  auto const rank = comm->rank();
+  auto const a = Read<I8>(nroots, I8(rank + 1), 1);
+  auto const b = Reals(nroots * 3, Real(rank), 0.5);
+  auto const c = LOs(nroots * 2, 7 * rank, 3);
+  auto const d = Read<GO>(nroots, GO(1) << 40, GO(rank + 1));
+  DistBatch batch;
+  batch.add(a, 1, OMEGA_H_MAX);
+  batch.add(b, 3, OMEGA_H_SUM);
+  batch.add(c, 2, OMEGA_H_MIN);
+  batch.add(d, 1, OMEGA_H_SUM);
+  OMEGA_H_CHECK(batch.size() == 4);
+  auto persistent = dist;
+  persistent.persist();
+  for (auto const& by : {dist, persistent}) {
+    auto out = by.exch(batch);
+    OMEGA_H_CHECK(out.get<I8>(0) == dist.exch(a, 1));
+    OMEGA_H_CHECK(out.get<Real>(1) == dist.exch(b, 3));
+    OMEGA_H_CHECK(out.get<LO>(2) == dist.exch(c, 2));
+    OMEGA_H_CHECK(out.get<GO>(3) == dist.exch(d, 1));
+    auto reduced = by.exch_reduce(batch);
+    OMEGA_H_CHECK(reduced.get<I8>(0) == dist.exch_reduce(a, 1, OMEGA_H_MAX));
+    OMEGA_H_CHECK(reduced.get<Real>(1) == dist.exch_reduce(b, 3, OMEGA_H_SUM));
+    OMEGA_H_CHECK(reduced.get<LO>(2) == dist.exch_reduce(c, 2, OMEGA_H_MIN));
+    OMEGA_H_CHECK(reduced.get<GO>(3) == dist.exch_reduce(d, 1, OMEGA_H_SUM));
+  }
+}
+
+/* rank 1 receives more than a persistent exchange may hold from rank
+   0 and a single packet from rank 2, which alone would fit. all three
+   must still choose the same way to exchange */
+static void test_mixed_size_dist(CommPtr comm) {
+  if (comm->size() < 3) return;
+  auto const rank = comm->rank();
+  LO const nbig = 2100;
+  Int const width = 1024;
+  LO const nitems = (rank == 0) ? nbig : ((rank == 2) ? 1 : 0);
+  LO const nroots = (rank == 1) ? (nbig + 1) : 0;
+  auto const first_idx = (rank == 2) ? nbig : 0;
+  auto const dests =
+      Remotes(Read<I32>(nitems, 1), LOs(nitems, first_idx, 1));
+  auto const dist = Dist(comm, dests, nroots);
+  auto persistent = dist;
+  persistent.persist();
+  auto const a = Reals(nitems * width, Real(rank), 1.0);
+  auto const b = dist.exch(a, width);
+  OMEGA_H_CHECK(persistent.exch(a, width) == b);
+  DistBatch batch;
+  batch.add(a, width);
+  batch.add(LOs(nitems, rank, 1), 1);
+  auto const out = persistent.exch(batch);
+  OMEGA_H_CHECK(out.get<Real>(0) == b);
+  OMEGA_H_CHECK(out.get<LO>(1) == dist.exch(LOs(nitems, rank, 1), 1));
+  auto const c = LOs(nroots, 7, 1);
+  OMEGA_H_CHECK(persistent.invert().exch(c, 1) == dist.invert().exch(c, 1));
+}
+
 static void test_one_rank(CommPtr comm) {
   OMEGA_H_CHECK(comm->size() == 1);
   {  // make sure we can operate on zero-length data
@@ -30,6 +119,9 @@ static void test_one_rank(CommPtr comm) {
       auto b = dist.exch(a, 1);
       OMEGA_H_CHECK(b == Read<GO>({3, 2, 1, 0}));
     }
+    dist.set_roots2items(LOs({0, 2, 3, 4, 4}));
+    test_persistent_dist(comm, dist, 4);
+    test_batch_dist(comm, dist, 4);
   }
   {
     Dist copies2owners;
@@ -111,6 +203,8 @@ static void test_two_ranks_dist(CommPtr comm) {
    */
   auto c = dist.invert().exch(b, 1);
   OMEGA_H_CHECK(c == a);
+  test_persistent_dist(comm, dist, a.size());
+  test_batch_dist(comm, dist, a.size());
 }
 
 static void test_two_ranks_dist_for_two_variable_sized_actors(CommPtr comm) {
@@ -394,6 +488,80 @@ static void test_binary_io(Library* lib, CommPtr comm) {
       OMEGA_H_SAME == compare_meshes(&mesh0, &mesh2, opts, true, true));
 }
 
+static void test_compute_and_sync(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const rank = comm->rank();
+  for (Int dim = 0; dim <= mesh.dim(); ++dim) {
+    auto const n = mesh.nents(dim);
+    auto const split = mesh.ask_halo_split(dim);
+    OMEGA_H_CHECK(split.interior.size() + split.boundary.size() +
+                      split.unowned.size() ==
+                  n);
+    OMEGA_H_CHECK(split.boundary.size() > 0);
+    OMEGA_H_CHECK(split.unowned.size() > 0);
+    auto const globals = mesh.globals(dim);
+    auto const owner_ranks = mesh.ask_owners(dim).ranks;
+    /* every entity must end up with what its owner computed */
+    Write<GO> out(n * 2);
+    auto f = OMEGA_H_LAMBDA(LO e) {
+      out[e * 2 + 0] = globals[e] * 10 + rank;
+      out[e * 2 + 1] = rank;
+    };
+    auto const synced = compute_and_sync(&mesh, dim, out, 2, f);
+    Write<GO> expected(n * 2);
+    auto g = OMEGA_H_LAMBDA(LO e) {
+      expected[e * 2 + 0] = globals[e] * 10 + owner_ranks[e];
+      expected[e * 2 + 1] = owner_ranks[e];
+    };
+    parallel_for(n, g);
+    OMEGA_H_CHECK(synced == read(expected));
+  }
+}
+
+/* the graph partitioner must leave a balanced partition nearly alone
+   and balance an unbalanced one without losing elements */
+static void test_graph_balance(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  auto const nelems = mesh.nglobal_ents(mesh.dim());
+  auto const area = get_sum(comm, measure_elements_real(&mesh));
+  BalanceOpts opts;
+  opts.method = OMEGA_H_BALANCE_GRAPH;
+  auto const kept = mesh.balance(opts);
+  OMEGA_H_CHECK(kept.migrated <= nelems / 16);
+  OMEGA_H_CHECK(kept.imbalance <= opts.imbalance);
+  OMEGA_H_CHECK(kept.edge_cut > 0);
+  opts.weights = Reals(mesh.nelems(), comm->rank() == 0 ? 3.0 : 1.0);
+  auto const moved = mesh.balance(opts);
+  OMEGA_H_CHECK(moved.migrated > 0);
+  OMEGA_H_CHECK(moved.imbalance <= opts.imbalance);
+  OMEGA_H_CHECK(mesh.nglobal_ents(mesh.dim()) == nelems);
+  OMEGA_H_CHECK(are_close(get_sum(comm, measure_elements_real(&mesh)), area));
+  opts.method = OMEGA_H_BALANCE_RIB;
+  opts.weights = Reals();
+  auto const rib = mesh.balance(opts);
+  OMEGA_H_CHECK(rib.edge_cut > 0);
+  OMEGA_H_CHECK(mesh.nglobal_ents(mesh.dim()) == nelems);
+}
+
+/* refining half the box must leave the ranks balanced */
+static void test_adapt_balance(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  auto const coords = mesh.coords();
+  Write<Real> metrics(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto const h = (coords[v * 2] < 0.5) ? 0.04 : 0.125;
+    metrics[v] = metric_eigenvalue_from_length(h);
+  };
+  parallel_for(mesh.nverts(), f);
+  mesh.add_tag(VERT, "metric", 1, Reals(metrics));
+  AdaptOpts opts(&mesh);
+  opts.verbosity = SILENT;
+  opts.should_balance = true;
+  adapt(&mesh, opts);
+  OMEGA_H_CHECK(mesh.imbalance() <= opts.max_imbalance);
+}
+
 static void test_two_ranks(Library* lib, CommPtr comm) {
   test_two_ranks_dist(comm);
   test_two_ranks_dist_for_two_variable_sized_actors(comm);
@@ -405,6 +573,9 @@ static void test_two_ranks(Library* lib, CommPtr comm) {
   test_construct(lib, comm);
   test_read_vtu(lib, comm);
   test_binary_io(lib, comm);
+  test_compute_and_sync(comm);
+  test_graph_balance(comm);
+  test_adapt_balance(comm);
 }
 
 void test_rib(CommPtr comm) {
@@ -437,6 +608,288 @@ void test_rib(CommPtr comm) {
   OMEGA_H_CHECK(masses == Reals(n, 1));
 }
 
+/* parts written into a few container files must read back the same,
+   also when the mesh changes while they are being compressed,
+   and on more ranks than wrote them */
+static void test_aggregated_io(Library* lib, CommPtr comm) {
+  auto mesh0 = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  mesh0.set_parting(OMEGA_H_GHOSTED);
+  auto opts = MeshCompareOpts::init(&mesh0, VarCompareOpts::zero_tolerance());
+  for (bool compress : {false, true}) {
+    binary::write_aggregated("mpi_test_aggregated.osh", &mesh0, 2, compress);
+    Mesh mesh1(lib);
+    binary::read("mpi_test_aggregated.osh", comm, &mesh1, true);
+    OMEGA_H_CHECK(
+        OMEGA_H_SAME == compare_meshes(&mesh0, &mesh1, opts, true, true));
+  }
+  {
+    binary::AsyncWriter writer("mpi_test_async.osh", &mesh0, 1);
+    mesh0.add_tag(VERT, "later", 1, Reals(mesh0.nverts(), 1.0));
+    writer.wait();
+  }
+  Mesh mesh2(lib);
+  binary::read("mpi_test_async.osh", comm, &mesh2, true);
+  OMEGA_H_CHECK(!mesh2.has_tag(VERT, "later"));
+  mesh0.remove_tag(VERT, "later");
+  OMEGA_H_CHECK(
+      OMEGA_H_SAME == compare_meshes(&mesh0, &mesh2, opts, true, true));
+  auto const nelems = mesh0.nglobal_ents(mesh0.dim());
+  auto const in_half = comm->rank() < (comm->size() + 1) / 2;
+  auto const half = comm->split(I32(in_half), comm->rank());
+  if (in_half) {
+    auto mesh3 = build_box(half, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+    binary::write_aggregated("mpi_test_half.osh", &mesh3, 1);
+  }
+  comm->barrier();
+  Mesh mesh4(lib);
+  binary::read("mpi_test_half.osh", comm, &mesh4);
+  OMEGA_H_CHECK(mesh4.nglobal_ents(mesh4.dim()) == nelems);
+}
+
+/* dropping the ghosts in place must give the same element-based mesh
+   as migrating, and ghosting an unchanged element-based mesh again
+   must reuse the dropped layer with the tags added meanwhile */
+static void test_incremental_ghosting(CommPtr comm) {
+  if (comm->size() == 1) return;
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto migrated = mesh;
+  partition_by_elems(&migrated, false);
+  auto const before = mesh.parting_stats();
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  auto const dropped = mesh.parting_stats();
+  OMEGA_H_CHECK(dropped.migrated == before.migrated);
+  OMEGA_H_CHECK(dropped.kept > before.kept);
+  for (Int d = 0; d <= mesh.dim(); ++d) {
+    OMEGA_H_CHECK(mesh.globals(d) == migrated.globals(d));
+    OMEGA_H_CHECK(mesh.ask_owners(d).ranks == migrated.ask_owners(d).ranks);
+    OMEGA_H_CHECK(mesh.ask_owners(d).idxs == migrated.ask_owners(d).idxs);
+    if (d) OMEGA_H_CHECK(mesh.ask_verts_of(d) == migrated.ask_verts_of(d));
+  }
+  OMEGA_H_CHECK(mesh.coords() == migrated.coords());
+  auto const globals = mesh.globals(VERT);
+  Write<Real> values(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) { values[v] = Real(globals[v]); };
+  parallel_for(mesh.nverts(), f);
+  mesh.add_tag(VERT, "global_as_real", 1, Reals(values));
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const reused = mesh.parting_stats();
+  OMEGA_H_CHECK(reused.migrated == before.migrated);
+  OMEGA_H_CHECK(reused.kept > dropped.kept);
+  auto ghosted = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  ghosted.set_parting(OMEGA_H_GHOSTED);
+  for (Int d = 0; d <= mesh.dim(); ++d) {
+    OMEGA_H_CHECK(mesh.globals(d) == ghosted.globals(d));
+    OMEGA_H_CHECK(mesh.ask_owners(d).ranks == ghosted.ask_owners(d).ranks);
+    OMEGA_H_CHECK(mesh.ask_owners(d).idxs == ghosted.ask_owners(d).idxs);
+  }
+  auto const ghosted_globals = mesh.globals(VERT);
+  Write<Real> expected(mesh.nverts());
+  auto g = OMEGA_H_LAMBDA(LO v) { expected[v] = Real(ghosted_globals[v]); };
+  parallel_for(mesh.nverts(), g);
+  OMEGA_H_CHECK(
+      mesh.get_array<Real>(VERT, "global_as_real") == Reals(expected));
+  /* only a single layer is kept for reuse */
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  auto const dropped_again = mesh.parting_stats();
+  mesh.set_parting(OMEGA_H_GHOSTED, 2, false);
+  OMEGA_H_CHECK(mesh.parting_stats().migrated > dropped_again.migrated);
+  ghosted = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 4, 4, 0);
+  ghosted.set_parting(OMEGA_H_GHOSTED, 2, false);
+  OMEGA_H_CHECK(mesh.globals(VERT) == ghosted.globals(VERT));
+  /* nor after the kept layer was freed */
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  mesh.drop_ghost_cache();
+  auto const freed = mesh.parting_stats();
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  OMEGA_H_CHECK(mesh.parting_stats().migrated > freed.migrated);
+  OMEGA_H_CHECK(mesh.parting_stats().kept == freed.kept);
+  /* nor after the owners were set, which frees it too */
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  mesh.set_owners(VERT, mesh.ask_owners(VERT));
+  auto const owners_set = mesh.parting_stats();
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  OMEGA_H_CHECK(mesh.parting_stats().migrated > owners_set.migrated);
+  OMEGA_H_CHECK(mesh.parting_stats().kept == owners_set.kept);
+}
+
+static Mesh adapt_graded_box(CommPtr comm, bool should_cache_cavities) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  auto const coords = mesh.coords();
+  Write<Real> metrics(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    metrics[v] = metric_eigenvalue_from_length(0.1 + 0.4 * coords[v * 3]);
+  };
+  parallel_for(mesh.nverts(), f);
+  mesh.add_tag(VERT, "metric", 1, Reals(metrics));
+  AdaptOpts opts(&mesh);
+  opts.verbosity = SILENT;
+  /* high enough that the 3D swaps run, several times */
+  opts.min_quality_desired = 0.6;
+  opts.should_cache_cavities = should_cache_cavities;
+  adapt(&mesh, opts);
+  return mesh;
+}
+
+/* the copies of an edge must agree on its cached qualities, so
+   adapting in 3D, where the swaps are cached too, must give the same
+   mesh with the caches as without them */
+static void test_cavity_cache(CommPtr comm) {
+  if (comm->size() == 1) return;
+  auto cached = adapt_graded_box(comm, true);
+  auto measured = adapt_graded_box(comm, false);
+  auto opts =
+      MeshCompareOpts::init(&cached, VarCompareOpts::zero_tolerance());
+  OMEGA_H_CHECK(
+      OMEGA_H_SAME == compare_meshes(&cached, &measured, opts, true, true));
+}
+
+/* deciding owned entities locally between exchanges must choose the
+   same set as synchronizing every round, and it must be independent
+   and the same on all copies, even with runs of equal quality */
+static void check_indset(Mesh* mesh, Int dim, Read<I8> candidates) {
+  auto const comm = mesh->comm();
+  auto const ev2v =
+      dim ? mesh->ask_verts_of(dim) : LOs(mesh->nverts(), 0, 1);
+  auto const coords = mesh->coords();
+  auto const nverts_per_ent = dim + 1;
+  Write<Real> quality_w(mesh->nents(dim));
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    Real y = 0.0;
+    for (Int i = 0; i < nverts_per_ent; ++i) {
+      y += coords[ev2v[e * nverts_per_ent + i] * 3 + 1];
+    }
+    /* four values in all, so most neighbors tie */
+    quality_w[e] = std::floor(4.0 * y / nverts_per_ent) / 4.0;
+  };
+  parallel_for(mesh->nents(dim), f);
+  auto const graph = mesh->ask_star(dim);
+  indset::QualityCompare cmp(Reals(quality_w), mesh->globals(dim));
+  auto const synced = indset::find_synced(
+      mesh, dim, graph.a2ab, graph.ab2b, candidates, cmp);
+  auto const found =
+      indset::find(mesh, dim, graph.a2ab, graph.ab2b, candidates, cmp);
+  OMEGA_H_CHECK(comm->reduce_and(found == synced));
+  OMEGA_H_CHECK(comm->reduce_and(mesh->sync_array(dim, found, 1) == found));
+  auto const xadj = graph.a2ab;
+  auto const adj = graph.ab2b;
+  Write<I8> violations(mesh->nents(dim), I8(0));
+  auto g = OMEGA_H_LAMBDA(LO e) {
+    if (found[e] != indset::IN) return;
+    if (!candidates[e]) violations[e] = 1;
+    for (auto j = xadj[e]; j < xadj[e + 1]; ++j) {
+      if (found[adj[j]] == indset::IN) violations[e] = 1;
+    }
+  };
+  parallel_for(mesh->nents(dim), g);
+  OMEGA_H_CHECK(get_max(comm, Read<I8>(violations)) == 0);
+  OMEGA_H_CHECK(get_sum(comm, mesh->owned_array(dim, found, 1)) > 0);
+}
+
+static void test_indset(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const coords = mesh.coords();
+  Write<I8> vert_cands(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) { vert_cands[v] = (coords[v * 3] < 0.8); };
+  parallel_for(mesh.nverts(), f);
+  check_indset(&mesh, VERT, vert_cands);
+  check_indset(&mesh, EDGE, Read<I8>(mesh.nedges(), I8(1)));
+}
+
+/* limiting gradation rank by rank, exchanging only the partition
+   boundary once each rank settles, must agree with full sweeps and
+   leave every copy with its owner's metric */
+static void test_limit_gradation(CommPtr comm) {
+  auto mesh = build_box(comm, OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const coords = mesh.coords();
+  Write<Real> metrics_w(mesh.nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto const h = (coords[v * 2] < 0.2) ? 0.005 : 0.5;
+    metrics_w[v] = metric_eigenvalue_from_length(h);
+  };
+  parallel_for(mesh.nverts(), f);
+  auto const metrics = Reals(metrics_w);
+  GradationStats synced_stats, stats;
+  auto const synced = limit_metric_gradation_synced(
+      &mesh, metrics, 1.0, 1e-6, false, &synced_stats);
+  auto const limited =
+      limit_metric_gradation(&mesh, metrics, 1.0, 1e-6, false, &stats);
+  OMEGA_H_CHECK(comm->reduce_and(are_close(limited, synced, 1e-4)));
+  OMEGA_H_CHECK(mesh.sync_array(VERT, limited, 1) == limited);
+  OMEGA_H_CHECK(stats.exchanges <= synced_stats.exchanges);
+}
+
+/* pretending every two ranks share a node, a node-aware Comm must
+   exchange and reduce exactly like a plain one */
+static void test_node_aware(CommPtr comm) {
+  auto const rank = comm->rank();
+  auto const size = comm->size();
+  auto node_aware = comm->dup();
+  node_aware->enable_node_aware(2);
+#ifdef OMEGA_H_USE_MPI
+  OMEGA_H_CHECK(node_aware->is_node_aware());
+#endif
+  OMEGA_H_CHECK(node_aware->allreduce(rank + 1, OMEGA_H_SUM) ==
+                comm->allreduce(rank + 1, OMEGA_H_SUM));
+  OMEGA_H_CHECK(node_aware->allreduce(Real(rank), OMEGA_H_MAX) ==
+                comm->allreduce(Real(rank), OMEGA_H_MAX));
+  OMEGA_H_CHECK(node_aware->allreduce(GO(rank) - 3, OMEGA_H_MIN) ==
+                comm->allreduce(GO(rank) - 3, OMEGA_H_MIN));
+  /* rank i sends (i + j) % 3 items to rank j, with no message where
+     that is zero, and grows the sends to make the window grow */
+  for (Int round = 0; round < 3; ++round) {
+    std::vector<I32> dests;
+    std::vector<LO> counts;
+    for (I32 j = 0; j < size; ++j) {
+      auto const n = ((rank + j) % 3) * (1 + 10 * round);
+      if (n == 0) continue;
+      dests.push_back(j);
+      counts.push_back(n);
+    }
+    auto const ndests = LO(dests.size());
+    HostWrite<I32> h_dests(ndests);
+    HostWrite<LO> h_counts(ndests);
+    for (LO i = 0; i < ndests; ++i) {
+      h_dests[i] = dests[std::size_t(i)];
+      h_counts[i] = counts[std::size_t(i)];
+    }
+    auto const plain_graph = comm->graph(h_dests.write());
+    auto const graph = node_aware->graph(h_dests.write());
+    OMEGA_H_CHECK(graph->is_node_aware() == node_aware->is_node_aware());
+    auto const sdispls = offset_scan(LOs(h_counts.write()));
+    auto const rdispls = offset_scan(plain_graph->alltoall(get_degrees(sdispls)));
+    auto const width = 2;
+    Write<Real> data_w(sdispls.last() * width);
+    auto f = OMEGA_H_LAMBDA(LO i) { data_w[i] = 1000 * rank + 10 * round + i; };
+    parallel_for(data_w.size(), f);
+    Reals data(data_w);
+    OMEGA_H_CHECK(graph->alltoallv(data, sdispls, rdispls, width) ==
+                  plain_graph->alltoallv(data, sdispls, rdispls, width));
+  }
+  /* and so must a Dist over it, persistent or not */
+  Dist dist;
+  dist.set_parent_comm(node_aware);
+  dist.set_dest_ranks(Read<I32>({(rank + 1) % size, rank, (rank + size - 1) % size}));
+  dist.set_dest_idxs(LOs({0, 1, 2}), 3);
+  Dist plain;
+  plain.set_parent_comm(comm);
+  plain.set_dest_ranks(Read<I32>({(rank + 1) % size, rank, (rank + size - 1) % size}));
+  plain.set_dest_idxs(LOs({0, 1, 2}), 3);
+  auto const a = Reals(3, Real(10 * rank), 1);
+  OMEGA_H_CHECK(dist.exch(a, 1) == plain.exch(a, 1));
+  dist.persist();
+  OMEGA_H_CHECK(dist.exch(a, 1) == plain.exch(a, 1));
+  DistBatch batch;
+  batch.add(a, 1);
+  batch.add(LOs(3, rank, 1), 1);
+  auto const out = dist.exch(batch);
+  OMEGA_H_CHECK(out.get<Real>(0) == plain.exch(a, 1));
+  OMEGA_H_CHECK(out.get<LO>(1) == plain.exch(LOs(3, rank, 1), 1));
+}
+
 int main(int argc, char** argv) {
   auto lib = Library(&argc, &argv);
   auto world = lib.world();
@@ -455,5 +908,12 @@ int main(int argc, char** argv) {
     }
   }
   world->barrier();
+  test_mixed_size_dist(world);
+  test_aggregated_io(&lib, world);
+  test_incremental_ghosting(world);
+  test_indset(world);
+  test_cavity_cache(world);
+  test_limit_gradation(world);
+  test_node_aware(world);
   test_rib(world);
 }
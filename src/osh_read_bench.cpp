@@ -0,0 +1,70 @@
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_file.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_timer.hpp>
+#include <fstream>
+#include <iostream>
+
+/* compares reading an uncompressed .osh part through the mapped
+   file against streaming and copying it, which is what happens
+   for compressed or byte-swapped parts */
+
+static Omega_h::Real touch(Omega_h::Mesh* mesh) {
+  Omega_h::Real total = 0;
+  for (Omega_h::Int d = 0; d <= mesh->dim(); ++d) {
+    for (Omega_h::Int i = 0; i < mesh->ntags(d); ++i) {
+      auto tag = mesh->get_tag(d, i);
+      if (tag->type() == OMEGA_H_REAL) {
+        total +=
+            Omega_h::get_sum(mesh->get_array<Omega_h::Real>(d, tag->name()));
+      }
+    }
+  }
+  return total;
+}
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  auto world = lib.world();
+  Omega_h::CmdLine cmdline;
+  cmdline.add_arg<std::string>("input.osh");
+  cmdline.add_arg<std::string>("scratch.osh");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const inpath = cmdline.get<std::string>("input.osh");
+  auto const outpath = cmdline.get<std::string>("scratch.osh");
+  {
+    auto mesh = Omega_h::binary::read(inpath, world);
+    Omega_h::binary::write(outpath, &mesh, false);
+  }
+  auto const version = Omega_h::binary::read_version(outpath, world);
+  auto t0 = Omega_h::now();
+  Omega_h::Mesh mapped(&lib);
+  Omega_h::binary::read_in_comm(outpath, world, &mapped, version);
+  auto t1 = Omega_h::now();
+  auto const mapped_sum = touch(&mapped);
+  auto t2 = Omega_h::now();
+  Omega_h::Mesh copied(&lib);
+  copied.set_comm(world);
+  {
+    Omega_h::filesystem::path filepath = outpath;
+    filepath /= std::to_string(world->rank());
+    filepath += ".osh";
+    std::ifstream file(filepath.c_str(), std::ios::binary);
+    OMEGA_H_CHECK(file.is_open());
+    Omega_h::binary::read(file, &copied, version);
+  }
+  auto t3 = Omega_h::now();
+  auto const copied_sum = touch(&copied);
+  auto t4 = Omega_h::now();
+  OMEGA_H_CHECK(mapped_sum == copied_sum);
+  if (!world->rank()) {
+    std::cout << "mapped: read " << (t1 - t0) << " s, first access "
+              << (t2 - t1) << " s\n";
+    std::cout << "copied: read " << (t3 - t2) << " s, first access "
+              << (t4 - t3) << " s\n";
+  }
+  Omega_h::filesystem::remove_all(outpath);
+  return 0;
+}
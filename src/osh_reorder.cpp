@@ -2,17 +2,48 @@
 #include <Omega_h_file.hpp>
 #include <Omega_h_mesh.hpp>
 
+#include <iostream>
+
+static void print_locality(char const* when, Omega_h::Mesh* mesh) {
+  auto const locality = Omega_h::measure_order_locality(mesh);
+  std::cout << when << ": mean edge span " << locality.mean_edge_span
+            << ", bandwidth " << locality.max_edge_span
+            << ", mean element span " << locality.mean_elem_span << '\n';
+}
+
 int main(int argc, char** argv) {
   auto lib = Omega_h::Library(&argc, &argv);
   auto world = lib.world();
   Omega_h::CmdLine cmdline;
   cmdline.add_arg<std::string>("input.osh");
   cmdline.add_arg<std::string>("output.osh");
+  auto& order_flag =
+      cmdline.add_flag("--order", "hilbert (default), rcm or bisection");
+  order_flag.add_arg<std::string>("type");
+  cmdline.add_flag("--locality", "print index locality before and after");
   if (!cmdline.parse_final(world, &argc, argv)) return -1;
   auto inpath = cmdline.get<std::string>("input.osh");
   auto outpath = cmdline.get<std::string>("output.osh");
+  std::string order = "hilbert";
+  if (cmdline.parsed("--order")) {
+    order = cmdline.get<std::string>("--order", "type");
+  }
+  if (order != "hilbert" && order != "rcm" && order != "bisection") {
+    std::cout << "unknown order: " << order << std::endl;
+    cmdline.show_help(world, argv);
+    return -1;
+  }
+  auto const show_locality = cmdline.parsed("--locality");
   Omega_h::Mesh mesh(&lib);
   Omega_h::binary::read(inpath, world, &mesh);
-  Omega_h::reorder_by_hilbert(&mesh);
+  if (show_locality) print_locality("before", &mesh);
+  if (order == "rcm") {
+    Omega_h::reorder_by_rcm(&mesh);
+  } else if (order == "bisection") {
+    Omega_h::reorder_by_bisection(&mesh);
+  } else {
+    Omega_h::reorder_by_hilbert(&mesh);
+  }
+  if (show_locality) print_locality("after", &mesh);
   Omega_h::binary::write(outpath, &mesh);
 }
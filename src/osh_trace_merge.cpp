@@ -0,0 +1,43 @@
+#include <Omega_h_fail.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_trace.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+/* combines the per-rank .ohtrace files written by --osh-trace into
+   one Chrome trace-event JSON file, with every rank's times shifted
+   onto rank 0's clock by the offsets measured at either end */
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  if (argc < 3) {
+    if (!lib.world()->rank()) {
+      std::cout << "usage: " << argv[0]
+                << " output.json input.0.ohtrace [input.1.ohtrace ...]\n";
+    }
+    return -1;
+  }
+  std::vector<Omega_h::profile::TraceFile> files;
+  for (int i = 2; i < argc; ++i) files.push_back(Omega_h::profile::read_trace(argv[i]));
+  std::sort(files.begin(), files.end(),
+      [](Omega_h::profile::TraceFile const& a,
+          Omega_h::profile::TraceFile const& b) { return a.rank < b.rank; });
+  Omega_h::I64 dropped = 0;
+  for (auto& file : files) dropped += file.dropped;
+  if (int(files.size()) != files.front().nranks) {
+    std::cout << "warning: merging " << files.size() << " of "
+              << files.front().nranks << " ranks\n";
+  }
+  if (dropped) {
+    std::cout << "warning: " << dropped
+              << " events were dropped when ring buffers overflowed\n";
+  }
+  std::ofstream stream(argv[1]);
+  if (!stream.is_open()) {
+    Omega_h_fail("could not open file \"%s\"\n", argv[1]);
+  }
+  Omega_h::profile::write_chrome_json(stream, files);
+  return 0;
+}
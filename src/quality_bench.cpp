@@ -0,0 +1,111 @@
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_for.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_quality.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+/* nanoseconds per element taken to measure the metric qualities of
+   tetrahedra and triangles one at a time and in blocks of 4 and 8,
+   on boxes with a rotated anisotropic metric */
+
+using namespace Omega_h;
+
+template <Int dim>
+static Reals measure_one_at_a_time(Mesh* mesh, Reals metrics) {
+  MetricElementQualities<dim, dim> measurer(mesh, metrics);
+  auto ev2v = mesh->ask_elem_verts();
+  Write<Real> qualities(mesh->nelems());
+  auto f = OMEGA_H_LAMBDA(LO e) {
+    qualities[e] = measurer.measure(gather_verts<dim + 1>(ev2v, e));
+  };
+  parallel_for(mesh->nelems(), f);
+  return qualities;
+}
+
+template <Int dim, Int W>
+static Reals measure_in_blocks(Mesh* mesh, Reals metrics) {
+  auto coords = mesh->coords();
+  auto ev2v = mesh->ask_elem_verts();
+  auto nelems = mesh->nelems();
+  Write<Real> qualities(nelems);
+  auto f = OMEGA_H_LAMBDA(LO block) {
+    MetricQualityBlock<dim, dim, W> elems;
+    auto first = block * W;
+    auto nlanes = min2(LO(W), nelems - first);
+    for (Int lane = 0; lane < nlanes; ++lane) {
+      auto v = gather_verts<dim + 1>(ev2v, first + lane);
+      elems.set(lane, gather_vectors<dim + 1, dim>(coords, v),
+          gather_symms<dim + 1, dim>(metrics, v));
+    }
+    for (Int lane = nlanes; lane < W; ++lane) elems.copy_lane(lane, 0);
+    auto q = elems.measure();
+    for (Int lane = 0; lane < nlanes; ++lane) {
+      qualities[first + lane] = q[lane];
+    }
+  };
+  parallel_for((nelems + W - 1) / W, f);
+  return qualities;
+}
+
+template <Int dim>
+static Reals rotated_metrics(Mesh* mesh) {
+  auto coords = mesh->coords();
+  Write<Real> metrics_w(mesh->nverts() * symm_ncomps(dim));
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto x = get_vector<dim>(coords, v);
+    auto r3 = rotate(x[0] + x[1], vector_3(0, 0, 1));
+    Tensor<dim> r;
+    Vector<dim> h;
+    for (Int i = 0; i < dim; ++i) {
+      for (Int j = 0; j < dim; ++j) r[i][j] = r3[i][j];
+      h[i] = 0.01 * Real(i + 1) + 0.1 * x[0];
+    }
+    set_symm(metrics_w, v, compose_metric(r, h));
+  };
+  parallel_for(mesh->nverts(), f);
+  return metrics_w;
+}
+
+template <Int dim>
+static void bench(Library* lib, LO n, Int nreps) {
+  auto world = lib->world();
+  auto mesh = (dim == 3)
+                  ? build_box(world, OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n)
+                  : build_box(world, OMEGA_H_SIMPLEX, 1., 1., 0., n * 8,
+                        n * 8, 0);
+  auto metrics = rotated_metrics<dim>(&mesh);
+  char const* names[3] = {"one at a time", "blocks of 4", "blocks of 8"};
+  Reals qualities[3];
+  for (Int i = 0; i < 3; ++i) {
+    auto t0 = now();
+    for (Int rep = 0; rep < nreps; ++rep) {
+      if (i == 0) qualities[i] = measure_one_at_a_time<dim>(&mesh, metrics);
+      if (i == 1) qualities[i] = measure_in_blocks<dim, 4>(&mesh, metrics);
+      if (i == 2) qualities[i] = measure_in_blocks<dim, 8>(&mesh, metrics);
+    }
+    auto t1 = now();
+    auto ns = (t1 - t0) * 1e9 / (Real(mesh.nelems()) * Real(nreps));
+    std::cout << (dim == 3 ? "tets" : "tris") << ", " << names[i] << ": "
+              << ns << " ns/element\n";
+  }
+  bool const same =
+      (qualities[0] == qualities[1]) && (qualities[0] == qualities[2]);
+  std::cout << "qualities " << (same ? "agree" : "differ") << '\n';
+}
+
+int main(int argc, char** argv) {
+  auto lib = Library(&argc, &argv);
+  CmdLine cmdline;
+  cmdline.add_arg<int>("nelems-per-side");
+  cmdline.add_arg<int>("nreps");
+  if (!cmdline.parse_final(lib.world(), &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("nelems-per-side");
+  auto const nreps = cmdline.get<int>("nreps");
+  bench<3>(&lib, n, nreps);
+  bench<2>(&lib, n, nreps);
+  return 0;
+}
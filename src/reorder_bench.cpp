@@ -0,0 +1,81 @@
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_metric.hpp>
+#include <Omega_h_quality.hpp>
+#include <Omega_h_shape.hpp>
+#include <Omega_h_timer.hpp>
+#include <Omega_h_unmap_mesh.hpp>
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+/* compares vertex orderings of a box graded towards one side like a
+   boundary layer: their index locality and the throughput of kernels
+   which gather the vertices of edges and elements */
+
+static Omega_h::Mesh build_graded_box(Omega_h::CommPtr world, int n) {
+  auto mesh = Omega_h::build_box(
+      world, OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n);
+  auto const coords = Omega_h::HostRead<Omega_h::Real>(mesh.coords());
+  Omega_h::HostWrite<Omega_h::Real> graded(coords.size());
+  for (Omega_h::LO i = 0; i < coords.size(); ++i) graded[i] = coords[i];
+  for (Omega_h::LO v = 0; v < mesh.nverts(); ++v) {
+    auto const z = coords[v * 3 + 2];
+    graded[v * 3 + 2] = 1e-3 * z * z * z;
+  }
+  mesh.set_coords(graded.write());
+  mesh.add_tag(Omega_h::VERT, "metric", Omega_h::symm_ncomps(3),
+      Omega_h::get_implied_metrics(&mesh));
+  return mesh;
+}
+
+static void scramble(Omega_h::Mesh* mesh) {
+  std::mt19937 rng(42);
+  Omega_h::LOs new_ents2old_ents[4];
+  for (Omega_h::Int d = 0; d <= mesh->dim(); ++d) {
+    Omega_h::HostWrite<Omega_h::LO> perm(mesh->nents(d));
+    for (Omega_h::LO i = 0; i < perm.size(); ++i) perm[i] = i;
+    std::shuffle(perm.data(), perm.data() + perm.size(), rng);
+    new_ents2old_ents[d] = perm.write();
+  }
+  Omega_h::unmap_mesh(mesh, new_ents2old_ents);
+}
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  auto world = lib.world();
+  Omega_h::CmdLine cmdline;
+  cmdline.add_arg<int>("nelems-per-side");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("nelems-per-side");
+  int const nreps = 10;
+  char const* const orders[] = {"random", "hilbert", "rcm", "bisection"};
+  for (auto order : orders) {
+    auto mesh = build_graded_box(world, n);
+    scramble(&mesh);
+    std::string const name = order;
+    auto const t0 = Omega_h::now();
+    if (name == "hilbert") Omega_h::reorder_by_hilbert(&mesh);
+    if (name == "rcm") Omega_h::reorder_by_rcm(&mesh);
+    if (name == "bisection") Omega_h::reorder_by_bisection(&mesh);
+    auto const t1 = Omega_h::now();
+    auto const locality = Omega_h::measure_order_locality(&mesh);
+    Omega_h::measure_qualities(&mesh);
+    auto const t2 = Omega_h::now();
+    for (int i = 0; i < nreps; ++i) Omega_h::measure_qualities(&mesh);
+    auto const t3 = Omega_h::now();
+    for (int i = 0; i < nreps; ++i) Omega_h::measure_edges_metric(&mesh);
+    auto const t4 = Omega_h::now();
+    std::cout << name << ": reorder " << (t1 - t0) << " s, mean edge span "
+              << locality.mean_edge_span << ", bandwidth "
+              << locality.max_edge_span << ", mean element span "
+              << locality.mean_elem_span << ", qualities "
+              << (Omega_h::Real(mesh.nelems()) * nreps / (t3 - t2))
+              << " elems/s, lengths "
+              << (Omega_h::Real(mesh.nedges()) * nreps / (t4 - t3))
+              << " edges/s\n";
+  }
+  return 0;
+}
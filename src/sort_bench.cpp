@@ -0,0 +1,52 @@
+#include <Omega_h_array_ops.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_sort.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+/* compares the radix sort used by sort_by_keys
+   on host backends against the comparison sort */
+
+template <typename T>
+static Omega_h::Read<T> random_keys(
+    Omega_h::LO n, Omega_h::Int width, T max_value) {
+  Omega_h::HostWrite<T> h_keys(n * width);
+  std::uint64_t state = 42;
+  for (Omega_h::LO i = 0; i < n * width; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    h_keys[i] = T((state >> 33) % std::uint64_t(max_value));
+  }
+  return h_keys.write();
+}
+
+template <typename T>
+static void bench(Omega_h::LO n, Omega_h::Int width, T max_value,
+    char const* type_name) {
+  auto keys = random_keys<T>(n, width, max_value);
+  auto t0 = Omega_h::now();
+  auto radix_perm = Omega_h::sort_by_keys(keys, width);
+  auto t1 = Omega_h::now();
+  auto comparison_perm = Omega_h::sort_by_keys_comparison(keys, width);
+  auto t2 = Omega_h::now();
+  OMEGA_H_CHECK(radix_perm == comparison_perm);
+  std::cout << type_name << " width " << width << ": radix " << (t1 - t0)
+            << " s, comparison " << (t2 - t1) << " s, speedup "
+            << ((t2 - t1) / (t1 - t0)) << '\n';
+}
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  Omega_h::CmdLine cmdline;
+  cmdline.add_arg<int>("num-keys");
+  if (!cmdline.parse_final(lib.world(), &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("num-keys");
+  std::cout << "sorting " << n << " keys\n";
+  for (Omega_h::Int width = 1; width <= 4; ++width) {
+    bench<Omega_h::LO>(n, width, n, "LO");
+  }
+  for (Omega_h::Int width = 1; width <= 2; ++width) {
+    bench<Omega_h::GO>(n, width, Omega_h::GO(n) * 1000, "GO");
+  }
+  return 0;
+}
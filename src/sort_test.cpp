@@ -42,10 +42,10 @@ int main(int argc, char** argv) {
       Read<LO> keys, gold;
       std::ifstream in("ab2b"+std::to_string(i)+".dat", std::ios::in);
       assert(in.is_open());
-      binary::read_array(in, keys, false, false);
+      binary::read_array(in, keys, false, false, 10);
       std::ifstream inGold("ba2ab"+std::to_string(i)+".dat", std::ios::in);
       assert(in.is_open());
-      binary::read_array(inGold, gold, false, false);
+      binary::read_array(inGold, gold, false, false, 10);
       in.close();
       inGold.close();
       LOs perm = sort_by_keys(keys);
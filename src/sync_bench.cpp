@@ -0,0 +1,81 @@
+#include <Omega_h_build.hpp>
+#include <Omega_h_cmdline.hpp>
+#include <Omega_h_dist.hpp>
+#include <Omega_h_library.hpp>
+#include <Omega_h_mesh.hpp>
+#include <Omega_h_timer.hpp>
+#include <iostream>
+
+/* per-call latency of synchronizing a vertex field the way an
+   explicit solver does every step, through the persistent Dist
+   Mesh::ask_dist() keeps versus a Dist that rebuilds its
+   buffers and host displacements on every exchange, then of
+   synchronizing several fields one by one versus as one batch */
+
+template <typename F>
+static double time_calls(Omega_h::CommPtr comm, int ncalls, F f) {
+  f();
+  comm->barrier();
+  auto const t0 = Omega_h::now();
+  for (int i = 0; i < ncalls; ++i) f();
+  comm->barrier();
+  auto const t1 = Omega_h::now();
+  return comm->allreduce((t1 - t0) / ncalls, OMEGA_H_MAX);
+}
+
+int main(int argc, char** argv) {
+  auto lib = Omega_h::Library(&argc, &argv);
+  auto world = lib.world();
+  Omega_h::CmdLine cmdline;
+  cmdline.add_arg<int>("nelems-per-side");
+  cmdline.add_arg<int>("ncalls");
+  if (!cmdline.parse_final(world, &argc, argv)) return -1;
+  auto const n = cmdline.get<int>("nelems-per-side");
+  auto const ncalls = cmdline.get<int>("ncalls");
+  auto mesh =
+      Omega_h::build_box(world, OMEGA_H_SIMPLEX, 1., 1., 1., n, n, n);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  auto const nverts = mesh.nverts();
+  auto const owners = mesh.ask_owners(Omega_h::VERT);
+  auto const fresh =
+      Omega_h::Dist(world, owners, nverts).invert();
+  for (Omega_h::Int width : {1, 3, 9}) {
+    auto const field = Omega_h::Reals(nverts * width, 1.0);
+    auto const planned = time_calls(world, ncalls,
+        [&]() { mesh.sync_array(Omega_h::VERT, field, width); });
+    auto const unplanned =
+        time_calls(world, ncalls, [&]() { fresh.exch(field, width); });
+    if (!world->rank()) {
+      std::cout << "width " << width << ": persistent "
+                << planned * 1e6 << " us/call, rebuilt "
+                << unplanned * 1e6 << " us/call, speedup "
+                << unplanned / planned << '\n';
+    }
+  }
+  auto const velocity = Omega_h::Reals(nverts * 3, 1.0);
+  auto const pressure = Omega_h::Reals(nverts, 2.0);
+  auto const metric = Omega_h::Reals(nverts * 6, 3.0);
+  auto const flags = Omega_h::Read<Omega_h::I8>(nverts, 1);
+  auto const ids = Omega_h::LOs(nverts, 0, 1);
+  auto const separate = time_calls(world, ncalls, [&]() {
+    mesh.sync_array(Omega_h::VERT, velocity, 3);
+    mesh.sync_array(Omega_h::VERT, pressure, 1);
+    mesh.sync_array(Omega_h::VERT, metric, 6);
+    mesh.sync_array(Omega_h::VERT, flags, 1);
+    mesh.sync_array(Omega_h::VERT, ids, 1);
+  });
+  Omega_h::DistBatch batch;
+  batch.add(velocity, 3);
+  batch.add(pressure, 1);
+  batch.add(metric, 6);
+  batch.add(flags, 1);
+  batch.add(ids, 1);
+  auto const batched = time_calls(
+      world, ncalls, [&]() { mesh.sync_arrays(Omega_h::VERT, batch); });
+  if (!world->rank()) {
+    std::cout << batch.size() << " fields: separate " << separate * 1e6
+              << " us/call, batched " << batched * 1e6
+              << " us/call, speedup " << separate / batched << '\n';
+  }
+  return 0;
+}
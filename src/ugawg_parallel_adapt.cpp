@@ -15,10 +15,13 @@ int main(int argc, char** argv) {
   auto cmdline = Omega_h::CmdLine();
   cmdline.add_arg<std::string>("input.meshb");
   cmdline.add_arg<double>("final-complexity");
+  cmdline.add_flag("--no-balance",
+      "do not rebalance on predicted element counts while adapting");
   if (!cmdline.parse_final(world, &argc, argv)) {
     return -1;
   }
   auto final_complexity = cmdline.get<double>("final-complexity");
+  auto should_balance = !cmdline.parsed("--no-balance");
   auto final_nelems =
       Omega_h::get_expected_nelems_from_complexity(final_complexity, 3);
   auto nelems_per_rank = final_nelems / world->size();
@@ -108,6 +111,7 @@ int main(int argc, char** argv) {
                   << " elements in " << subcomm_size << " ranks\n";
       auto adapt_opts = Omega_h::AdaptOpts(&mesh);
       adapt_opts.verbosity = Omega_h::EXTRA_STATS;
+      adapt_opts.should_balance = should_balance;
       while (Omega_h::approach_metric(&mesh, adapt_opts)) {
         Omega_h::adapt(&mesh, adapt_opts);
       }
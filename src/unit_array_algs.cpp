@@ -1,11 +1,13 @@
 #include "Omega_h_adj.hpp"
 #include "Omega_h_align.hpp"
+#include "Omega_h_arena.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_expr.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_int_scan.hpp"
 #include "Omega_h_library.hpp"
 #include "Omega_h_linpart.hpp"
+#include "Omega_h_malloc.hpp"
 #include "Omega_h_map.hpp"
 #include "Omega_h_mark.hpp"
 #include "Omega_h_sort.hpp"
@@ -71,6 +73,30 @@ static void test_sort() {
   }
 }
 
+template <typename T>
+static void test_radix_sort(Int width, T max_value) {
+  LO const n = 10000;
+  HostWrite<T> h_keys(n * width);
+  std::uint64_t state = 42;
+  for (LO i = 0; i < n * width; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    h_keys[i] = T(I64(state >> 33) % I64(max_value)) - max_value / 2;
+  }
+  Read<T> keys(h_keys.write());
+  auto perm = sort_by_keys(keys, width);
+  auto gold = sort_by_keys_comparison(keys, width);
+  OMEGA_H_CHECK(perm == gold);
+}
+
+static void test_radix_sort() {
+  for (Int width = 1; width <= 4; ++width) {
+    test_radix_sort<LO>(width, 7);
+    test_radix_sort<LO>(width, 1000000);
+    test_radix_sort<GO>(width, 5);
+    test_radix_sort<GO>(width, I64(1) << 50);
+  }
+}
+
 static void test_equal() {
   OMEGA_H_CHECK(LOs({0, 3, 6, 1, 4, 7, 2, 5, 8}) == LOs({0, 3, 6, 1, 4, 7, 2, 5, 8}));
   OMEGA_H_CHECK(LOs({0, 3, 6, 9}) == LOs({0, 3, 6, 9}));
@@ -348,6 +374,59 @@ static void test_expr2() {
       Reals({1.0, std::exp(1.0), std::exp(2.0), std::exp(3.0)})));
 }
 
+static void test_expr_program(Int dim, std::string const& expr,
+    bool should_fuse) {
+  LO const n = 5;
+  ExprEnv env(n, dim);
+  Write<Real> x(n), v(n * dim), m(n * dim * dim);
+  auto f = OMEGA_H_LAMBDA(LO i) {
+    x[i] = 0.25 * i - 0.5;
+    for (Int j = 0; j < dim; ++j) v[i * dim + j] = 1.0 + i - j;
+    for (Int j = 0; j < dim * dim; ++j) m[i * dim * dim + j] = 0.5 * (i + j);
+  };
+  parallel_for(n, f);
+  env.register_variable("x", any(Reals(x)));
+  env.register_variable("v", any(Reals(v)));
+  env.register_variable("m", any(Reals(m)));
+  env.register_variable("c", any(Real(2.0)));
+  ExprOpsReader reader;
+  auto op = reader.read_ops(expr);
+  ExprProgram program(op);
+  auto fused = program.eval(env);
+  OMEGA_H_CHECK(program.was_fused() == should_fuse);
+  auto expected = op->eval(env);
+  OMEGA_H_CHECK(
+      are_close(any_cast<Reals>(fused), any_cast<Reals>(expected), 1e-12));
+}
+
+static void test_expr_program() {
+  for (Int dim = 1; dim <= 3; ++dim) {
+    test_expr_program(dim, "x^2 + c", true);
+    if (dim == 3) test_expr_program(dim, "vector(x^2 + c, 0, x)", true);
+    test_expr_program(dim, "vector(x^2 + c)", true);
+    test_expr_program(dim, "v * x - 1.5 * v / c", true);
+    test_expr_program(dim, "v * v + norm(v)", true);
+    test_expr_program(dim, "m * v", true);
+    test_expr_program(dim, "m * m - I * x", true);
+    test_expr_program(dim, "symm(m * m)", true);
+    test_expr_program(dim, "(x > 0) ? x : -x", true);
+    test_expr_program(dim, "(x < 0 || x > 0.5) ? v : v * c", true);
+    test_expr_program(dim, "exp(x) + sqrt(c) * sin(x) - cos(x) + erf(x)", true);
+    test_expr_program(dim, "v(0) + m(0, 0)", true);
+    test_expr_program(dim, "y = x * c; z = y + 1; y * z", true);
+    test_expr_program(dim, "x / (x + 0.6)", true);
+  }
+  /* results that don't vary fall back to the interpreter */
+  {
+    ExprEnv env(4, 3);
+    ExprOpsReader reader;
+    ExprProgram program(reader.read_ops("c = 2; c * pi"));
+    auto res = program.eval(env);
+    OMEGA_H_CHECK(!program.was_fused());
+    OMEGA_H_CHECK(are_close(any_cast<Real>(res), 2.0 * Omega_h::PI));
+  }
+}
+
 static void test_array_from_kokkos() {
 #ifdef OMEGA_H_USE_KOKKOS
   View<double**> managed(
@@ -364,6 +443,33 @@ static void test_array_from_kokkos() {
 #endif
 }
 
+static void test_arena() {
+  for (std::size_t size = 0; size < 100000; size += 7) {
+    auto const c = arena_size_class(size);
+    OMEGA_H_CHECK(arena_class_size(c) >= size);
+    OMEGA_H_CHECK(c == 0 || arena_class_size(c - 1) < size);
+    OMEGA_H_CHECK(arena_size_class(arena_class_size(c)) == c);
+  }
+  OMEGA_H_CHECK(arena_size_class(std::size_t(1) << 40) < ARENA_NCLASSES);
+  Arena arena(host_malloc, host_free);
+  auto a = allocate(arena, 1000);
+  deallocate(arena, a, 1000);
+  OMEGA_H_CHECK(arena.cached_bytes == 0);
+  begin_phase(arena);
+  a = allocate(arena, 1000);
+  deallocate(arena, a, 1000);
+  OMEGA_H_CHECK(arena.cached_bytes == arena_class_size(arena_size_class(1000)));
+  auto b = allocate(arena, 1010);
+  OMEGA_H_CHECK(b == a);
+  deallocate(arena, b, 1010);
+  auto stats = get_stats(arena);
+  OMEGA_H_CHECK(stats.allocations == 3);
+  OMEGA_H_CHECK(stats.reused_allocations == 1);
+  OMEGA_H_CHECK(end_phase(arena));
+  OMEGA_H_CHECK(arena.cached_bytes == 0);
+  OMEGA_H_CHECK(get_stats(arena).released_bytes > 0);
+}
+
 int main(int argc, char** argv) {
   auto lib = Library(&argc, &argv);
   OMEGA_H_CHECK(std::string(lib.version()) == OMEGA_H_SEMVER);
@@ -376,6 +482,7 @@ int main(int argc, char** argv) {
   test_int128();
   test_repro_sum();
   test_sort();
+  test_radix_sort();
   test_fan_and_funnel();
   test_permute();
   test_invert_map();
@@ -389,7 +496,9 @@ int main(int argc, char** argv) {
   test_scalar_ptr();
   test_expr();
   test_expr2();
+  test_expr_program();
   test_array_from_kokkos();
+  test_arena();
   fprintf(stderr, "done\n");
   return 0;
 }
@@ -7,6 +7,7 @@
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_build.hpp"
 #include "Omega_h_compare.hpp"
+#include "Omega_h_trace.hpp"
 #include "Omega_h_vtk.hpp"
 #include "Omega_h_xml_lite.hpp"
 
@@ -1188,12 +1189,39 @@ static void test_file_components(bool is_compressed, bool needs_swapping) {
   OMEGA_H_CHECK(s == s2);
 }
 
+#ifdef OMEGA_H_USE_ZLIB
+static void test_chunked_arrays(bool needs_swapping, bool use_filter) {
+  using namespace binary;
+  std::stringstream stream;
+  /* enough values to span several chunks, with a partial last one */
+  LO n = 700 * 1000;
+  Read<I32> a(n, -3 * n, 7);
+  Read<I64> b(n, I64(1) << 40, -3);
+  Read<Real> c(n, 0.5, 1.0 / 3.0);
+  write_array(stream, a, true, needs_swapping, use_filter);
+  write_array(stream, b, true, needs_swapping, use_filter);
+  write_array(stream, c, true, needs_swapping, use_filter);
+  Read<I32> a2;
+  read_array(stream, a2, true, needs_swapping);
+  OMEGA_H_CHECK(a2 == a);
+  Read<I64> b2;
+  read_array(stream, b2, true, needs_swapping);
+  OMEGA_H_CHECK(b2 == b);
+  Read<Real> c2;
+  read_array(stream, c2, true, needs_swapping);
+  OMEGA_H_CHECK(c2 == c);
+}
+#endif
+
 static void test_file_components() {
   test_file_components(false, false);
   test_file_components(false, true);
 #ifdef OMEGA_H_USE_ZLIB
   test_file_components(true, false);
   test_file_components(true, true);
+  test_chunked_arrays(false, true);
+  test_chunked_arrays(true, true);
+  test_chunked_arrays(false, false);
 #endif
 }
 
@@ -1225,6 +1253,105 @@ static void test_file(Library* lib) {
   }
 }
 
+static void test_mapped_file(Library* lib) {
+  auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  mesh0.add_tag(VERT, "field", 1, get_component(mesh0.coords(), 3, 0));
+  auto opts = MeshCompareOpts::init(&mesh0, VarCompareOpts::zero_tolerance());
+  filesystem::path const path = "mapped_file_test.osh";
+  binary::write(path, &mesh0, false);
+  auto mesh1 = binary::read(path, lib->world());
+  compare_meshes(&mesh0, &mesh1, opts, true, true);
+  /* overwriting the file must not disturb arrays read from it */
+  binary::write(path, &mesh0);
+  auto mesh2 = binary::read(path, lib->world());
+  compare_meshes(&mesh0, &mesh1, opts, true, true);
+  compare_meshes(&mesh0, &mesh2, opts, true, true);
+  filesystem::remove_all(path);
+}
+
+static void test_trace(Library* lib) {
+  auto const rank = lib->world()->rank();
+  profile::Trace trace(lib->world(), "unused", false, 4);
+  static char const* const names[2] = {"outer", "inner"};
+  trace.begin(names[0]);
+  trace.allocated(100);
+  trace.begin(names[1]);
+  trace.freed(40);
+  trace.end();
+  trace.end();
+  auto file = trace.snapshot();
+  OMEGA_H_CHECK(file.rank == rank);
+  OMEGA_H_CHECK(file.threads.size() == 1);
+  OMEGA_H_CHECK(file.dropped == 2);
+  auto& events = file.threads[0].events;
+  OMEGA_H_CHECK(events.size() == 4);
+  OMEGA_H_CHECK(events[0].kind == profile::BEGIN);
+  OMEGA_H_CHECK(file.names[std::size_t(events[0].value)] == "inner");
+  OMEGA_H_CHECK(events[1].kind == profile::FREE && events[1].value == 60);
+  OMEGA_H_CHECK(events[3].kind == profile::END);
+  for (std::size_t i = 1; i < events.size(); ++i) {
+    OMEGA_H_CHECK(events[i - 1].time <= events[i].time);
+  }
+  auto const path = "trace_test." + std::to_string(rank) + ".ohtrace";
+  profile::write_trace(path, file);
+  auto file2 = profile::read_trace(path);
+  OMEGA_H_CHECK(file2.names == file.names);
+  OMEGA_H_CHECK(file2.dropped == file.dropped);
+  OMEGA_H_CHECK(file2.threads.size() == 1);
+  for (std::size_t i = 0; i < events.size(); ++i) {
+    auto& e = file2.threads[0].events[i];
+    OMEGA_H_CHECK(e.time == events[i].time);
+    OMEGA_H_CHECK(e.value == events[i].value);
+    OMEGA_H_CHECK(e.kind == events[i].kind);
+  }
+  filesystem::remove(path);
+  /* the outer begin was overwritten, so only the inner region
+     and its matching end may appear */
+  std::stringstream json;
+  profile::write_chrome_json(json, {file2});
+  auto const s = json.str();
+  OMEGA_H_CHECK(s.find("\"inner\"") != std::string::npos);
+  OMEGA_H_CHECK(s.find("\"outer\"") == std::string::npos);
+  std::size_t nends = 0;
+  for (auto pos = s.find("\"E\""); pos != std::string::npos;
+       pos = s.find("\"E\"", pos + 1)) {
+    ++nends;
+  }
+  OMEGA_H_CHECK(nends == 1);
+}
+
+static void test_saved_adjs(Library* lib) {
+  auto mesh0 = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  auto v2r = mesh0.ask_up(VERT, REGION);
+  auto e2f = mesh0.ask_up(EDGE, FACE);
+  auto v2v = mesh0.ask_star(VERT);
+  auto r2r = mesh0.ask_dual();
+  {
+    std::stringstream stream;
+    binary::write(stream, &mesh0);
+    Mesh mesh1(lib);
+    mesh1.set_comm(lib->world());
+    binary::read(stream, &mesh1, binary::latest_version);
+    OMEGA_H_CHECK(!mesh1.has_adj(VERT, REGION));
+  }
+  std::stringstream stream;
+  binary::write(stream, &mesh0, false, true);
+  Mesh mesh1(lib);
+  mesh1.set_comm(lib->world());
+  binary::read(stream, &mesh1, binary::latest_version);
+  OMEGA_H_CHECK(mesh1.has_adj(VERT, REGION));
+  OMEGA_H_CHECK(mesh1.has_adj(EDGE, FACE));
+  OMEGA_H_CHECK(mesh1.has_adj(VERT, VERT));
+  OMEGA_H_CHECK(mesh1.has_adj(REGION, REGION));
+  auto v2r1 = mesh1.get_adj(VERT, REGION);
+  OMEGA_H_CHECK(v2r1.a2ab == v2r.a2ab);
+  OMEGA_H_CHECK(v2r1.ab2b == v2r.ab2b);
+  OMEGA_H_CHECK(v2r1.codes == v2r.codes);
+  OMEGA_H_CHECK(mesh1.get_adj(EDGE, FACE).codes == e2f.codes);
+  OMEGA_H_CHECK(mesh1.ask_star(VERT).ab2b == v2v.ab2b);
+  OMEGA_H_CHECK(mesh1.ask_dual().ab2b == r2r.ab2b);
+}
+
 template <typename T>
 std::ostream& operator<<(std::ostream& ostr, const Omega_h::Read<T>& array) {
   ostr << '[';
@@ -1435,6 +1562,40 @@ static void test_gmsh(Library* lib) {
   }
 }
 
+static GO sum_class_ids(Mesh* mesh, Int dim) {
+  return get_sum(mesh->comm(),
+      mesh->owned_array(dim, mesh->get_array<ClassId>(dim, "class_id"), 1));
+}
+
+/* a binary 4.1 file reads the same serially and by slices */
+static void test_gmsh_sliced(Library* lib) {
+  auto const world = lib->world();
+  for (Int dim = 2; dim <= 3; ++dim) {
+    auto mesh0 = build_box(
+        lib->self(), OMEGA_H_SIMPLEX, 1., 1., 1., 3, 2, (dim == 3) ? 2 : 0);
+    if (world->rank() == 0) {
+      Omega_h::gmsh::write_binary("sliced.msh", &mesh0);
+    }
+    world->barrier();
+    auto mesh1 = Omega_h::gmsh::read("sliced.msh", world);
+    auto mesh2 = Omega_h::gmsh::read_sliced("sliced.msh", world);
+    OMEGA_H_CHECK(mesh2.dim() == dim);
+    for (Int d = 0; d <= dim; ++d) {
+      OMEGA_H_CHECK(mesh1.nglobal_ents(d) == mesh0.nents(d));
+      OMEGA_H_CHECK(mesh2.nglobal_ents(d) == mesh0.nents(d));
+    }
+    for (Int d = 1; d <= dim; ++d) {
+      OMEGA_H_CHECK(sum_class_ids(&mesh1, d) == sum_class_ids(&mesh0, d));
+    }
+    OMEGA_H_CHECK(sum_class_ids(&mesh2, dim) == sum_class_ids(&mesh0, dim));
+    auto const coords0 = get_sum(mesh0.coords());
+    OMEGA_H_CHECK(are_close(coords0,
+        get_sum(world, mesh1.owned_array(VERT, mesh1.coords(), dim))));
+    OMEGA_H_CHECK(are_close(coords0,
+        get_sum(world, mesh2.owned_array(VERT, mesh2.coords(), dim))));
+  }
+}
+
 static void test_xml() {
   xml_lite::Tag tag;
   OMEGA_H_CHECK(!xml_lite::parse_tag("AQAAAAAAAADABg", &tag));
@@ -1477,10 +1638,14 @@ int main(int argc, char** argv) {
   if (lib.world()->size() == 1) {
     test_file_components();
     test_file(&lib);
+    test_mapped_file(&lib);
+    test_saved_adjs(&lib);
+    test_trace(&lib);
     test_xml();
     test_read_vtu(&lib);
   }
   test_gmsh(&lib);
+  test_gmsh_sliced(&lib);
 #ifdef OMEGA_H_USE_GMSH
   test_gmsh_parallel(&lib);
 #endif  // OMEGA_H_USE_GMSH
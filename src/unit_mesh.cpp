@@ -1,20 +1,29 @@
+#include "Omega_h_adapt.hpp"
 #include "Omega_h_align.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_bbox.hpp"
 #include "Omega_h_build.hpp"
+#include "Omega_h_cavity_cache.hpp"
+#include "Omega_h_coarsen.hpp"
+#include "Omega_h_collapse.hpp"
 #include "Omega_h_compare.hpp"
 #include "Omega_h_confined.hpp"
+#include "Omega_h_element.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_hilbert.hpp"
 #include "Omega_h_hypercube.hpp"
 #include "Omega_h_inertia.hpp"
 #include "Omega_h_int_scan.hpp"
+#include "Omega_h_map.hpp"
 #include "Omega_h_mesh.hpp"
+#include "Omega_h_metric.hpp"
 #include "Omega_h_quality.hpp"
 #include "Omega_h_recover.hpp"
+#include "Omega_h_refine.hpp"
 #include "Omega_h_refine_qualities.hpp"
 #include "Omega_h_shape.hpp"
 #include "Omega_h_swap2d.hpp"
+#include "Omega_h_swap3d.hpp"
 #include "Omega_h_swap3d_choice.hpp"
 #include "Omega_h_swap3d_loop.hpp"
 
@@ -234,6 +243,27 @@ static void test_hilbert() {
   OMEGA_H_CHECK(stream2.str() == expected);
 }
 
+static void test_reorder(Library* lib) {
+  auto mesh0 = build_box(lib->self(), OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  auto const volume = get_sum(measure_elements_real(&mesh0));
+  auto const hilbert = measure_order_locality(&mesh0);
+  for (int order = 0; order < 2; ++order) {
+    auto mesh = build_box(lib->self(), OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+    if (order == 0) reorder_by_rcm(&mesh);
+    if (order == 1) reorder_by_bisection(&mesh);
+    OMEGA_H_CHECK(mesh.nverts() == mesh0.nverts());
+    OMEGA_H_CHECK(mesh.nelems() == mesh0.nelems());
+    OMEGA_H_CHECK(are_close(get_sum(measure_elements_real(&mesh)), volume));
+    auto const metrics = Reals(mesh.nverts(), 1.0);
+    OMEGA_H_CHECK(get_min(measure_qualities(&mesh, metrics)) > 0.0);
+    auto const locality = measure_order_locality(&mesh);
+    if (order == 0) {
+      OMEGA_H_CHECK(locality.max_edge_span < hilbert.max_edge_span);
+    }
+    OMEGA_H_CHECK(locality.mean_edge_span < Real(mesh.nverts()) / 4);
+  }
+}
+
 static void test_bbox() {
   OMEGA_H_CHECK(are_close(BBox<2>(vector_2(-3, -3), vector_2(3, 3)),
       find_bounding_box<2>(Reals({0, -3, 3, 0, 0, 3, -3, 0}))));
@@ -284,6 +314,65 @@ static void test_build(Library* lib) {
   }
 }
 
+static void test_hash_matching(Library* lib) {
+  for (auto family : {OMEGA_H_SIMPLEX, OMEGA_H_HYPERCUBE}) {
+    Mesh ref(lib);
+    build_box_internal(&ref, family, 1., 1., 1., 3, 2, 2);
+    Mesh mesh(lib);
+    mesh.set_matching(OMEGA_H_MATCH_BY_HASH);
+    build_box_internal(&mesh, family, 1., 1., 1., 3, 2, 2);
+    for (Int high = EDGE; high <= REGION; ++high) {
+      for (Int low = VERT; low < high; ++low) {
+        auto a = ref.ask_down(high, low);
+        auto b = mesh.ask_down(high, low);
+        OMEGA_H_CHECK(a.ab2b == b.ab2b);
+        if (a.codes.exists()) OMEGA_H_CHECK(a.codes == b.codes);
+      }
+    }
+    auto a = reflect_down(ref.ask_verts_of(REGION), ref.ask_verts_of(FACE),
+        ref.ask_up(VERT, FACE), family, REGION, FACE);
+    auto b = reflect_down_by_hash(ref.ask_verts_of(REGION),
+        ref.ask_verts_of(FACE), family, REGION, FACE);
+    OMEGA_H_CHECK(a.ab2b == b.ab2b);
+    OMEGA_H_CHECK(a.codes == b.codes);
+  }
+}
+
+static void check_patched_adjs(Mesh* mesh) {
+  OMEGA_H_CHECK(mesh->adj_is_patched(VERT, EDGE));
+  for (Int high = EDGE; high <= mesh->dim(); ++high) {
+    for (Int low = VERT; low < high; ++low) {
+      if (!mesh->adj_is_patched(low, high)) continue;
+      auto patched = mesh->get_adj(low, high);
+      auto deg = element_degree(mesh->family(), high, low);
+      auto derived = invert_adj(
+          mesh->ask_down(high, low), deg, mesh->nents(low), high, low);
+      OMEGA_H_CHECK(patched.a2ab == derived.a2ab);
+      OMEGA_H_CHECK(patched.ab2b == derived.ab2b);
+      OMEGA_H_CHECK(patched.codes == derived.codes);
+    }
+  }
+}
+
+static void test_patched_adjs(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 3, 3, 3);
+  mesh.add_tag<Real>(VERT, "metric", 1);
+  mesh.set_tag(
+      VERT, "metric", Reals(mesh.nverts(), metric_eigenvalue_from_length(0.3)));
+  auto opts = AdaptOpts(&mesh);
+  mesh.ask_up(VERT, REGION);
+  mesh.ask_up(EDGE, REGION);
+  OMEGA_H_CHECK(refine_by_size(&mesh, opts));
+  OMEGA_H_CHECK(mesh.adj_is_patched(EDGE, REGION));
+  check_patched_adjs(&mesh);
+  mesh.set_tag(
+      VERT, "metric", Reals(mesh.nverts(), metric_eigenvalue_from_length(0.6)));
+  mesh.ask_up(VERT, REGION);
+  OMEGA_H_CHECK(coarsen_by_size(&mesh, opts));
+  OMEGA_H_CHECK(mesh.adj_is_patched(VERT, REGION));
+  check_patched_adjs(&mesh);
+}
+
 static void test_star(Library* lib) {
   {
     Mesh mesh(lib);
@@ -468,6 +557,211 @@ static void test_element_implied_metric() {
   OMEGA_H_CHECK(are_close(arm, brm));
 }
 
+/* refining sharply near one side, updating only the vertices next
+   to those that changed must reach the metric that full sweeps do,
+   with less work, and leave nothing for a full sweep to change */
+template <Int dim>
+static void test_limit_gradation_dim(Library* lib) {
+  auto one_if_3d = ((dim == 3) ? 1 : 0);
+  auto mesh = build_box(
+      lib->world(), OMEGA_H_SIMPLEX, 1., 1., one_if_3d, 8, 8, 8 * one_if_3d);
+  auto coords = mesh.coords();
+  auto metrics_w = Write<Real>(mesh.nverts() * symm_ncomps(dim));
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto h = fill_vector<dim>(0.5);
+    if (coords[v * dim] < 0.2) h[0] = 0.005;
+    set_symm(metrics_w, v, diagonal(metric_eigenvalues_from_lengths(h)));
+  };
+  parallel_for(mesh.nverts(), f);
+  auto const metrics = Reals(metrics_w);
+  GradationStats synced_stats, stats;
+  auto const synced = limit_metric_gradation_synced(
+      &mesh, metrics, 1.0, 1e-6, false, &synced_stats);
+  auto const limited =
+      limit_metric_gradation(&mesh, metrics, 1.0, 1e-6, false, &stats);
+  OMEGA_H_CHECK(are_close(limited, synced, 1e-4));
+  OMEGA_H_CHECK(stats.updates < synced_stats.updates);
+  OMEGA_H_CHECK(stats.max_active == mesh.nverts());
+  GradationStats again;
+  limit_metric_gradation_synced(&mesh, limited, 1.0, 1e-6, false, &again);
+  OMEGA_H_CHECK(again.sweeps == 1);
+}
+
+static void test_limit_gradation(Library* lib) {
+  test_limit_gradation_dim<2>(lib);
+  test_limit_gradation_dim<3>(lib);
+}
+
+/* one vertex is pushed across its neighbors while the rest of the
+   mesh translates a little: stepping locally should hold back only
+   the vertices near it, where stepping globally holds back all */
+static Mesh build_warped_box(Library* lib, bool should_step_locally,
+    AdaptOpts* opts) {
+  auto mesh =
+      build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 0., 8, 8, 0);
+  add_implied_isos_tag(&mesh);
+  auto coords = mesh.coords();
+  auto warp_w = Write<Real>(mesh.nverts() * 2);
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto x = get_vector<2>(coords, v);
+    auto w = vector_2(0.0, 0.01);
+    if (norm(x - vector_2(0.5, 0.5)) < 1e-6) w[0] = 0.3;
+    set_vector(warp_w, v, w);
+  };
+  parallel_for(mesh.nverts(), f);
+  mesh.add_tag(VERT, "warp", 2, Reals(warp_w));
+  *opts = AdaptOpts(&mesh);
+  opts->verbosity = SILENT;
+  opts->should_step_locally = should_step_locally;
+  OMEGA_H_CHECK(warp_to_limit(&mesh, *opts));
+  return mesh;
+}
+
+static LO count_fully_warped(Mesh* mesh) {
+  auto coords = mesh->coords();
+  auto remainder = mesh->get_array<Real>(VERT, "warp");
+  auto marks = Write<I8>(mesh->nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    marks[v] = (coords[v * 2 + 0] < 0.25 &&
+                norm(get_vector<2>(remainder, v)) == 0.0);
+  };
+  parallel_for(mesh->nverts(), f);
+  return get_sum(Read<I8>(marks));
+}
+
+static void test_warp_locally(Library* lib) {
+  AdaptOpts opts;
+  auto local = build_warped_box(lib, true, &opts);
+  OMEGA_H_CHECK(local.min_quality() >= opts.min_quality_allowed);
+  OMEGA_H_CHECK(local.max_length() <= opts.max_length_allowed);
+  OMEGA_H_CHECK(count_fully_warped(&local) == 18);
+  OMEGA_H_CHECK(get_max(local.get_array<Real>(VERT, "warp")) > 0.0);
+  auto global = build_warped_box(lib, false, &opts);
+  OMEGA_H_CHECK(global.min_quality() >= opts.min_quality_allowed);
+  OMEGA_H_CHECK(count_fully_warped(&global) == 0);
+}
+
+static void add_graded_metric(Mesh* mesh) {
+  auto coords = mesh->coords();
+  auto metrics_w = Write<Real>(mesh->nverts());
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto h = 0.1 + 0.4 * coords[v * 3];
+    metrics_w[v] = metric_eigenvalue_from_length(h);
+  };
+  parallel_for(mesh->nverts(), f);
+  mesh->add_tag(VERT, "metric", 1, Reals(metrics_w));
+}
+
+static Mesh adapt_graded_box(Library* lib, bool should_cache_cavities) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 4, 4, 4);
+  add_graded_metric(&mesh);
+  auto opts = AdaptOpts(&mesh);
+  opts.verbosity = SILENT;
+  opts.should_cache_cavities = should_cache_cavities;
+  adapt(&mesh, opts);
+  OMEGA_H_CHECK(!mesh.has_tag(EDGE, collapse_quality_cache));
+  OMEGA_H_CHECK(!mesh.has_tag(EDGE, swap_quality_cache));
+  return mesh;
+}
+
+/* a second pass over unchanged cavities finds all of their qualities
+   in the caches, and those are the ones that would have been measured */
+static void test_cavity_cache_hits(Library* lib) {
+  auto mesh = build_box(lib->world(), OMEGA_H_SIMPLEX, 1., 1., 1., 2, 2, 2);
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  add_graded_metric(&mesh);
+  auto const opts = AdaptOpts(&mesh);
+  auto const class_dims = mesh.get_array<I8>(EDGE, "class_dim");
+  auto const cands2edges = collect_marked(each_eq_to(class_dims, I8(3)));
+  auto const ncands = cands2edges.size();
+  OMEGA_H_CHECK(ncands > 0);
+  auto const codes = Read<I8>(ncands, I8(COLLAPSE_BOTH));
+  auto const collapse_quals = coarsen_qualities(&mesh, cands2edges, codes);
+  Reals swap_quals;
+  Read<I8> configs;
+  swap3d_qualities(&mesh, opts, cands2edges, &swap_quals, &configs);
+  add_cavity_caches(&mesh);
+  for (Int pass = 0; pass < 2; ++pass) {
+    CavityCacheStats collapse_stats;
+    CavityCacheStats swap_stats;
+    auto const cached_collapse_quals =
+        coarsen_qualities(&mesh, cands2edges, codes, &collapse_stats);
+    Reals cached_swap_quals;
+    swap3d_qualities(
+        &mesh, opts, cands2edges, &cached_swap_quals, &configs, &swap_stats);
+    OMEGA_H_CHECK(cached_collapse_quals == collapse_quals);
+    OMEGA_H_CHECK(cached_swap_quals == swap_quals);
+    OMEGA_H_CHECK(collapse_stats.hits == (pass ? ncands : 0));
+    OMEGA_H_CHECK(collapse_stats.misses == (pass ? 0 : ncands));
+    OMEGA_H_CHECK(swap_stats.hits == (pass ? ncands : 0));
+    OMEGA_H_CHECK(swap_stats.misses == (pass ? 0 : ncands));
+  }
+  remove_cavity_caches(&mesh);
+}
+
+/* the cached qualities are the ones that would have been measured */
+static void test_cavity_cache(Library* lib) {
+  test_cavity_cache_hits(lib);
+  auto cached = adapt_graded_box(lib, true);
+  auto measured = adapt_graded_box(lib, false);
+  OMEGA_H_CHECK(cached == measured);
+}
+
+template <Int dim, Int metric_dim>
+static void test_quality_blocks_dim(Library* lib) {
+  auto one_if_3d = ((dim == 3) ? 1 : 0);
+  auto mesh = build_box(
+      lib->world(), OMEGA_H_SIMPLEX, 1., 1., one_if_3d, 3, 3, 3 * one_if_3d);
+  auto coords = mesh.coords();
+  auto metrics_w = Write<Real>(mesh.nverts() * symm_ncomps(metric_dim));
+  auto f = OMEGA_H_LAMBDA(LO v) {
+    auto x = get_vector<dim>(coords, v);
+    auto h = 0.1 + 0.3 * x[0];
+    Vector<metric_dim> hs;
+    for (Int i = 0; i < metric_dim; ++i) hs[i] = h * Real(i + 1);
+    auto r = rotate(x[1], vector_3(0, 0, 1));
+    Matrix<metric_dim, metric_dim> q;
+    for (Int i = 0; i < metric_dim; ++i) {
+      for (Int j = 0; j < metric_dim; ++j) q[i][j] = r[i][j];
+    }
+    auto m = compose_metric(q, hs);
+    if (metric_dim == 1) m[0][0] = metric_eigenvalue_from_length(h);
+    set_symm(metrics_w, v, m);
+  };
+  parallel_for(mesh.nverts(), f);
+  auto metrics = Reals(metrics_w);
+  /* an odd number of elements leaves a partial block */
+  auto a2e = LOs(mesh.nelems() - 1, 1, 1);
+  auto blocked = measure_qualities(&mesh, a2e, metrics);
+  auto ev2v = mesh.ask_elem_verts();
+  MetricElementQualities<dim, metric_dim> measurer(&mesh, metrics);
+  auto scalar_w = Write<Real>(a2e.size());
+  auto g = OMEGA_H_LAMBDA(LO a) {
+    scalar_w[a] = measurer.measure(gather_verts<dim + 1>(ev2v, a2e[a]));
+  };
+  parallel_for(a2e.size(), g);
+  OMEGA_H_CHECK(are_close(blocked, Reals(scalar_w)));
+}
+
+static void test_quality_blocks(Library* lib) {
+  test_quality_blocks_dim<2, 2>(lib);
+  test_quality_blocks_dim<2, 1>(lib);
+  test_quality_blocks_dim<3, 3>(lib);
+  test_quality_blocks_dim<3, 1>(lib);
+  /* inverted elements keep their negative size */
+  Few<Vector<2>, 3> p = {vector_2(0, 0), vector_2(0, 1), vector_2(1, 0)};
+  Few<Tensor<2>, 3> ms;
+  for (Int i = 0; i < 3; ++i) ms[i] = diagonal(vector_2(1.0 + i, 2.0));
+  MetricQualityBlock<2, 2, 4> block;
+  for (Int lane = 0; lane < 4; ++lane) block.set(lane, p, ms);
+  auto q = block.measure();
+  auto expected = metric_element_quality(p, maxdet_metric(ms));
+  OMEGA_H_CHECK(expected < 0.0);
+  for (Int lane = 0; lane < 4; ++lane) {
+    OMEGA_H_CHECK(are_close(q[lane], expected));
+  }
+}
+
 template <Int dim>
 void test_recover_hessians_dim(Library* lib) {
   auto one_if_3d = ((dim == 3) ? 1 : 0);
@@ -771,7 +1065,10 @@ int main(int argc, char** argv) {
   test_form_uses();
   test_reflect_down();
   test_find_unique();
+  test_hash_matching(&lib);
+  test_patched_adjs(&lib);
   test_hilbert();
+  test_reorder(&lib);
   test_bbox();
   test_star(&lib);
   test_dual(&lib);
@@ -784,6 +1081,10 @@ int main(int argc, char** argv) {
   test_swap2d_topology(&lib);
   test_swap3d_loop(&lib);
   test_element_implied_metric();
+  test_limit_gradation(&lib);
+  test_warp_locally(&lib);
+  test_cavity_cache(&lib);
+  test_quality_blocks(&lib);
   test_recover_hessians(&lib);
   test_sf_scale(&lib);
   test_proximity(&lib);